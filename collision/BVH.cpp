@@ -0,0 +1,544 @@
+/*
+ * BVH.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "BVH.hpp"
+#include "Intersection.hpp"     // testSphereBox, testBoxBox, testPointBox, testRayBox
+// Global includes
+#include <algorithm>            // std::partition, std::nth_element
+#include <limits>               // std::numeric_limits
+
+namespace JU
+{
+
+/**
+* @brief Default Constructor
+*/
+BVH::BVH()
+{
+}
+
+
+
+/**
+* @brief Destructor
+*/
+BVH::~BVH()
+{
+}
+
+
+
+/**
+* @brief Build the tree from scratch
+*
+* @param boxes Box of each object. The index of each box is the id used to identify the object in queries and updates
+*/
+void BVH::build(const std::vector<BoundingBox>& boxes)
+{
+    clear();
+
+    if (boxes.empty())
+        return;
+
+    glm::uint32 num_objects = boxes.size();
+
+    boxes_ = boxes;
+    object_indices_.resize(num_objects);
+    object_leaf_.resize(num_objects);
+
+    std::vector<glm::vec3> centroids(num_objects);
+    for (glm::uint32 index = 0; index < num_objects; ++index)
+    {
+        object_indices_[index] = index;
+        centroids[index]       = boxes[index].getCenter();
+    }
+
+    // A binary tree with at least one object per leaf never has more than 2n - 1 nodes
+    nodes_.reserve(2 * num_objects - 1);
+
+    Node root;
+    root.parent_ = INVALID_INDEX;
+    root.first_  = 0;
+    root.count_  = 0;
+    nodes_.push_back(root);
+
+    buildNode(0, 0, num_objects, 0, centroids);
+}
+
+
+
+/**
+* @brief Remove all the objects
+*/
+void BVH::clear()
+{
+    nodes_.clear();
+    boxes_.clear();
+    object_indices_.clear();
+    object_leaf_.clear();
+}
+
+
+
+/**
+* @brief Recursively split a range of objects using the binned SAH
+*
+* @param node_index Node that will own the objects in [begin, end)
+* @param begin      First entry in object_indices_
+* @param end        One past the last entry in object_indices_
+* @param depth      Depth of the node in the tree
+* @param centroids  Centroid of each object's box
+*/
+void BVH::buildNode(glm::uint32 node_index, glm::uint32 begin, glm::uint32 end, glm::uint32 depth, const std::vector<glm::vec3>& centroids)
+{
+    glm::uint32 count = end - begin;
+
+    // Bounds of the boxes and of their centroids
+    BoundingBox box (boxes_[object_indices_[begin]]);
+    BoundingBox centroid_box (centroids[object_indices_[begin]], centroids[object_indices_[begin]]);
+    for (glm::uint32 index = begin + 1; index < end; ++index)
+    {
+        box.merge(boxes_[object_indices_[index]]);
+        centroid_box.merge(centroids[object_indices_[index]]);
+    }
+
+    nodes_[node_index].box_ = box;
+
+    if (count <= MAX_LEAF_SIZE)
+    {
+        nodes_[node_index].first_ = begin;
+        nodes_[node_index].count_ = count;
+        for (glm::uint32 index = begin; index < end; ++index)
+            object_leaf_[object_indices_[index]] = node_index;
+        return;
+    }
+
+    glm::vec3 centroid_extents (centroid_box.getExtents());
+
+    // SAH: find the cheapest split plane among the bin boundaries of all three axis
+    glm::f32    best_cost = std::numeric_limits<glm::f32>::max();
+    glm::uint32 best_axis = 0;
+    glm::uint32 best_bin  = 0;
+
+    for (glm::uint32 axis = 0; axis < 3; ++axis)
+    {
+        if (centroid_extents[axis] <= 0.0f)
+            continue;
+
+        glm::uint32 bin_count[NUM_SAH_BINS] = {0};
+        BoundingBox bin_box[NUM_SAH_BINS];
+        glm::f32 scale = NUM_SAH_BINS / centroid_extents[axis];
+
+        for (glm::uint32 index = begin; index < end; ++index)
+        {
+            glm::uint32 object = object_indices_[index];
+            glm::uint32 bin = std::min(static_cast<glm::uint32>((centroids[object][axis] - centroid_box.pmin_[axis]) * scale), NUM_SAH_BINS - 1);
+
+            if (bin_count[bin]++)
+                bin_box[bin].merge(boxes_[object]);
+            else
+                bin_box[bin] = boxes_[object];
+        }
+
+        // Sweep from the right to get the cost of everything above each plane...
+        glm::f32    right_area[NUM_SAH_BINS];
+        glm::uint32 right_count[NUM_SAH_BINS];
+        BoundingBox accum;
+        glm::uint32 accum_count = 0;
+        for (glm::uint32 bin = NUM_SAH_BINS - 1; bin > 0; --bin)
+        {
+            if (bin_count[bin])
+            {
+                if (accum_count)
+                    accum.merge(bin_box[bin]);
+                else
+                    accum = bin_box[bin];
+                accum_count += bin_count[bin];
+            }
+            right_area[bin]  = accum_count ? accum.getSurfaceArea() : 0.0f;
+            right_count[bin] = accum_count;
+        }
+
+        // ...and from the left to add the cost of everything below
+        accum_count = 0;
+        for (glm::uint32 bin = 0; bin < NUM_SAH_BINS - 1; ++bin)
+        {
+            if (bin_count[bin])
+            {
+                if (accum_count)
+                    accum.merge(bin_box[bin]);
+                else
+                    accum = bin_box[bin];
+                accum_count += bin_count[bin];
+            }
+
+            if (!accum_count || !right_count[bin + 1])
+                continue;
+
+            glm::f32 cost = accum.getSurfaceArea() * accum_count + right_area[bin + 1] * right_count[bin + 1];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_bin  = bin;
+            }
+        }
+    }
+
+    glm::uint32 middle = begin;
+    glm::f32 leaf_cost = box.getSurfaceArea() * count;
+
+    if (best_cost < std::numeric_limits<glm::f32>::max() && (best_cost < leaf_cost || count > 4 * MAX_LEAF_SIZE) && depth < MAX_STACK_DEPTH / 2)
+    {
+        glm::f32 scale = NUM_SAH_BINS / centroid_extents[best_axis];
+        glm::f32 pmin  = centroid_box.pmin_[best_axis];
+        middle = std::partition(object_indices_.begin() + begin, object_indices_.begin() + end,
+                                [&](glm::uint32 object)
+                                {
+                                    glm::uint32 bin = std::min(static_cast<glm::uint32>((centroids[object][best_axis] - pmin) * scale), NUM_SAH_BINS - 1);
+                                    return bin <= best_bin;
+                                }) - object_indices_.begin();
+    }
+    else if (best_cost >= leaf_cost && count <= 4 * MAX_LEAF_SIZE)
+    {
+        // Not worth splitting
+        nodes_[node_index].first_ = begin;
+        nodes_[node_index].count_ = count;
+        for (glm::uint32 index = begin; index < end; ++index)
+            object_leaf_[object_indices_[index]] = node_index;
+        return;
+    }
+
+    // Degenerate partition (or too deep): split at the median of the widest axis, which bounds the depth
+    if (middle == begin || middle == end)
+    {
+        glm::uint32 axis = 0;
+        if (centroid_extents.y > centroid_extents[axis]) axis = 1;
+        if (centroid_extents.z > centroid_extents[axis]) axis = 2;
+
+        middle = begin + count / 2;
+        std::nth_element(object_indices_.begin() + begin, object_indices_.begin() + middle, object_indices_.begin() + end,
+                         [&](glm::uint32 a, glm::uint32 b) { return centroids[a][axis] < centroids[b][axis]; });
+    }
+
+    // Children are stored next to each other
+    glm::uint32 left = nodes_.size();
+    Node child;
+    child.parent_ = node_index;
+    child.first_  = 0;
+    child.count_  = 0;
+    nodes_.push_back(child);
+    nodes_.push_back(child);
+
+    nodes_[node_index].first_ = left;
+    nodes_[node_index].count_ = 0;
+
+    buildNode(left,     begin,  middle, depth + 1, centroids);
+    buildNode(left + 1, middle, end,    depth + 1, centroids);
+}
+
+
+
+/**
+* @brief Recompute the box of a leaf from the boxes of its objects
+*
+* @param node Leaf node
+*/
+void BVH::fitLeaf(Node& node) const
+{
+    node.box_ = boxes_[object_indices_[node.first_]];
+    for (glm::uint32 index = node.first_ + 1; index < node.first_ + node.count_; ++index)
+        node.box_.merge(boxes_[object_indices_[index]]);
+}
+
+
+
+/**
+* @brief Update the box of a single object (incremental refit)
+*
+* @detail The boxes of the nodes above the object are refitted up to the first one that does not change
+*
+* @param object_id Id of the object (its index in the vector given to 'build')
+* @param box       New box of the object
+*/
+void BVH::update(glm::uint32 object_id, const BoundingBox& box)
+{
+    boxes_[object_id] = box;
+
+    glm::uint32 node_index = object_leaf_[object_id];
+    fitLeaf(nodes_[node_index]);
+
+    glm::uint32 parent = nodes_[node_index].parent_;
+    while (parent != INVALID_INDEX)
+    {
+        Node& node = nodes_[parent];
+        BoundingBox fitted (nodes_[node.first_].box_);
+        fitted.merge(nodes_[node.first_ + 1].box_);
+
+        if (fitted.pmin_ == node.box_.pmin_ && fitted.pmax_ == node.box_.pmax_)
+            break;
+
+        node.box_ = fitted;
+        parent = node.parent_;
+    }
+}
+
+
+
+/**
+* @brief Update the boxes of all the objects and refit the whole tree
+*
+* @detail Cheaper than calling 'update' once per object when most of them have moved
+*
+* @param boxes New box of each object (same size and order as the vector given to 'build')
+*/
+void BVH::refit(const std::vector<BoundingBox>& boxes)
+{
+    boxes_ = boxes;
+
+    // Children are always stored after their parent, so a reverse sweep is a bottom-up pass
+    for (glm::uint32 index = nodes_.size(); index-- > 0; )
+    {
+        Node& node = nodes_[index];
+        if (node.isLeaf())
+            fitLeaf(node);
+        else
+        {
+            node.box_ = nodes_[node.first_].box_;
+            node.box_.merge(nodes_[node.first_ + 1].box_);
+        }
+    }
+}
+
+
+
+/**
+* @brief Generic depth-first traversal
+*
+* @param node_test   Predicate telling whether a node box must be visited
+* @param object_test Predicate telling whether an object box is reported
+* @param objects     List where the ids of the objects found are appended
+*/
+template <typename NodeTest, typename ObjectTest>
+void BVH::traverse(const NodeTest& node_test, const ObjectTest& object_test, ObjectList& objects) const
+{
+    if (nodes_.empty())
+        return;
+
+    glm::uint32 stack[MAX_STACK_DEPTH];
+    glm::uint32 stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size)
+    {
+        const Node& node = nodes_[stack[--stack_size]];
+
+        if (!node_test(node.box_))
+            continue;
+
+        if (node.isLeaf())
+        {
+            for (glm::uint32 index = node.first_; index < node.first_ + node.count_; ++index)
+            {
+                glm::uint32 object = object_indices_[index];
+                if (object_test(boxes_[object]))
+                    objects.push_back(object);
+            }
+        }
+        else
+        {
+            stack[stack_size++] = node.first_ + 1;
+            stack[stack_size++] = node.first_;
+        }
+    }
+}
+
+
+
+/**
+* @brief Find all the objects whose box intersects a sphere
+*
+* @param sphere  Query sphere
+* @param objects List where the ids of the objects found are appended
+*/
+void BVH::query(const BoundingSphere& sphere, ObjectList& objects) const
+{
+    auto test = [&sphere](const BoundingBox& box) { return testSphereBox(sphere, box); };
+    traverse(test, test, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box intersects a box
+*
+* @param box     Query box
+* @param objects List where the ids of the objects found are appended
+*/
+void BVH::query(const BoundingBox& box, ObjectList& objects) const
+{
+    auto test = [&box](const BoundingBox& other) { return testBoxBox(box, other); };
+    traverse(test, test, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box contains a point
+*
+* @param point   Query point
+* @param objects List where the ids of the objects found are appended
+*/
+void BVH::query(const glm::vec3& point, ObjectList& objects) const
+{
+    auto test = [&point](const BoundingBox& box) { return testPointBox(point, box); };
+    traverse(test, test, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box is hit by a ray
+*
+* @param ray     Query ray
+* @param t_max   Length of the segment to test (in units of the ray direction)
+* @param objects List where the ids of the objects found are appended
+*/
+void BVH::query(const Ray& ray, glm::f32 t_max, ObjectList& objects) const
+{
+    auto test = [&ray, t_max](const BoundingBox& box) { glm::f32 t; return testRayBox(ray, box, t_max, t); };
+    traverse(test, test, objects);
+}
+
+
+
+/**
+* @brief Find the closest object box hit by a ray
+*
+* @detail The closest child is visited first, and subtrees further away than the closest hit so far are skipped
+*
+* @param ray       Query ray
+* @param t_max     Length of the segment to test (in units of the ray direction)
+* @param object_id Id of the closest object hit
+* @param t         Distance to the entry point of the closest box hit
+*
+* @return Was any object hit?
+*/
+bool BVH::raycast(const Ray& ray, glm::f32 t_max, glm::uint32& object_id, glm::f32& t) const
+{
+    if (nodes_.empty())
+        return false;
+
+    glm::f32 t_node;
+    if (!testRayBox(ray, nodes_[0].box_, t_max, t_node))
+        return false;
+
+    bool hit = false;
+    t = t_max;
+
+    glm::uint32 stack[MAX_STACK_DEPTH];
+    glm::f32    stack_t[MAX_STACK_DEPTH];
+    glm::uint32 stack_size = 0;
+    stack[stack_size]     = 0;
+    stack_t[stack_size++] = t_node;
+
+    while (stack_size)
+    {
+        --stack_size;
+        if (stack_t[stack_size] > t)
+            continue;
+
+        const Node& node = nodes_[stack[stack_size]];
+
+        if (node.isLeaf())
+        {
+            for (glm::uint32 index = node.first_; index < node.first_ + node.count_; ++index)
+            {
+                glm::uint32 object = object_indices_[index];
+                glm::f32 t_object;
+                if (testRayBox(ray, boxes_[object], t, t_object) && t_object <= t)
+                {
+                    t         = t_object;
+                    object_id = object;
+                    hit       = true;
+                }
+            }
+        }
+        else
+        {
+            glm::f32 t_left, t_right;
+            bool hit_left  = testRayBox(ray, nodes_[node.first_].box_,     t, t_left);
+            bool hit_right = testRayBox(ray, nodes_[node.first_ + 1].box_, t, t_right);
+
+            // Push the furthest child first so the closest one is popped first
+            if (hit_left && hit_right && t_left < t_right)
+            {
+                stack[stack_size] = node.first_ + 1; stack_t[stack_size++] = t_right;
+                stack[stack_size] = node.first_;     stack_t[stack_size++] = t_left;
+            }
+            else
+            {
+                if (hit_left)  { stack[stack_size] = node.first_;     stack_t[stack_size++] = t_left;  }
+                if (hit_right) { stack[stack_size] = node.first_ + 1; stack_t[stack_size++] = t_right; }
+            }
+        }
+    }
+
+    return hit;
+}
+
+
+
+glm::uint32 BVH::getNumObjects() const
+{
+    return boxes_.size();
+}
+
+
+
+glm::uint32 BVH::getNumNodes() const
+{
+    return nodes_.size();
+}
+
+
+
+/**
+* @brief Box enclosing all the objects (only valid if the tree is not empty)
+*/
+const BoundingBox& BVH::getBounds() const
+{
+    return nodes_[0].box_;
+}
+
+
+
+const BoundingBox& BVH::getObjectBox(glm::uint32 object_id) const
+{
+    return boxes_[object_id];
+}
+
+
+
+
+const std::vector<BVH::Node>& BVH::getNodes() const
+{
+    return nodes_;
+}
+
+
+
+/**
+* @brief Object ids sorted by leaf: leaf nodes own the range [first_, first_ + count_)
+*/
+const std::vector<glm::uint32>& BVH::getObjectIndices() const
+{
+    return object_indices_;
+}
+
+}   // end namespace JU
@@ -0,0 +1,99 @@
+/*
+ * BVH.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef BVH_HPP_
+#define BVH_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingBox, BoundingSphere
+#include "Ray.hpp"              // Ray
+// Global includes
+#include <glm/glm.hpp>          // vec3, f32, uint32
+#include <vector>               // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Bounding Volume Hierarchy over a set of BoundingBox objects
+     *
+     * @detail The tree is built top-down with a binned Surface Area Heuristic. Objects are identified by their index
+     *         in the vector given to 'build'. Moving objects are handled by refitting the boxes of the nodes above them
+     *         (the topology of the tree is kept), so the quality of the tree degrades as objects move far from where
+     *         they were at build time. Call 'build' again when that happens.
+     *
+     *         All queries append the ids of the objects found to the given list (they do not clear it).
+     */
+    class BVH
+    {
+        public:
+            typedef std::vector<glm::uint32> ObjectList;
+
+            static const glm::uint32 MAX_LEAF_SIZE   = 4;   //!< Leaves with this many objects or fewer are never split
+            static const glm::uint32 NUM_SAH_BINS    = 16;  //!< Number of bins per axis in the SAH build
+            static const glm::uint32 MAX_STACK_DEPTH = 64;  //!< Size of the traversal stack
+
+            /**
+             * @brief Node of the tree
+             *
+             * @detail The two children of an interior node are stored next to each other, so only the first one is kept
+             */
+            struct Node
+            {
+                BoundingBox box_;       //!< Box enclosing everything below this node
+                glm::uint32 parent_;    //!< Index of the parent node (INVALID_INDEX for the root)
+                glm::uint32 first_;     //!< Leaf: first entry in object_indices_. Interior: index of the left child
+                glm::uint32 count_;     //!< Leaf: number of objects. Interior: zero
+
+                inline bool isLeaf() const { return count_ != 0; }
+            };
+
+            static const glm::uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+        public:
+            BVH();
+            virtual ~BVH();
+
+            // Construction
+            void build(const std::vector<BoundingBox>& boxes);
+            void clear();
+
+            // Moving objects
+            void update(glm::uint32 object_id, const BoundingBox& box);
+            void refit(const std::vector<BoundingBox>& boxes);
+
+            // Queries
+            void query(const BoundingSphere& sphere, ObjectList& objects) const;
+            void query(const BoundingBox& box, ObjectList& objects) const;
+            void query(const glm::vec3& point, ObjectList& objects) const;
+            void query(const Ray& ray, glm::f32 t_max, ObjectList& objects) const;
+            bool raycast(const Ray& ray, glm::f32 t_max, glm::uint32& object_id, glm::f32& t) const;
+
+            // Getters
+            glm::uint32 getNumObjects() const;
+            glm::uint32 getNumNodes() const;
+            const BoundingBox& getBounds() const;
+            const BoundingBox& getObjectBox(glm::uint32 object_id) const;
+            // Raw access for custom traversals (e.g. TriangleBVH). The root is the first node
+            const std::vector<Node>& getNodes() const;
+            const std::vector<glm::uint32>& getObjectIndices() const;
+
+        private:
+            void buildNode(glm::uint32 node_index, glm::uint32 begin, glm::uint32 end, glm::uint32 depth, const std::vector<glm::vec3>& centroids);
+            void fitLeaf(Node& node) const;
+            template <typename NodeTest, typename ObjectTest>
+            void traverse(const NodeTest& node_test, const ObjectTest& object_test, ObjectList& objects) const;
+
+        private:
+            std::vector<Node>        nodes_;            //!< Nodes of the tree (the root is the first one)
+            std::vector<BoundingBox> boxes_;            //!< Current box of each object
+            std::vector<glm::uint32> object_indices_;   //!< Object ids, sorted so each leaf owns a contiguous range
+            std::vector<glm::uint32> object_leaf_;      //!< Leaf node that holds each object
+    };
+
+}   // end namespace JU
+
+#endif /* BVH_HPP_ */
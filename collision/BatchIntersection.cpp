@@ -0,0 +1,331 @@
+/*
+ * BatchIntersection.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "BatchIntersection.hpp"
+// Global includes
+#include <algorithm>        // std::min, std::max
+#include <limits>           // std::numeric_limits
+
+#if defined(__AVX2__)
+    #include <immintrin.h>  // __m256
+    #define JU_BATCH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>  // __m128
+    #define JU_BATCH_SSE 1
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>     // _BitScanForward
+#endif
+
+namespace JU
+{
+
+/**
+* @brief Default Constructor
+*/
+BoundingBoxArray::BoundingBoxArray() : size_(0)
+{
+}
+
+
+
+/**
+* @brief Non-Default Constructor
+*
+* @param boxes Boxes to convert to the SoA layout
+*/
+BoundingBoxArray::BoundingBoxArray(const std::vector<BoundingBox>& boxes) : size_(0)
+{
+    reserve(boxes.size());
+
+    for (std::vector<BoundingBox>::const_iterator iter = boxes.begin(); iter != boxes.end(); ++iter)
+        add(*iter);
+}
+
+
+
+/**
+* @brief Append a box
+*
+* @detail Padding lanes are allocated LANE_PADDING at a time and then overwritten by the boxes that follow
+*
+* @param box New box
+*/
+void BoundingBoxArray::add(const BoundingBox& box)
+{
+    if (size_ == min_x_.size())
+    {
+        const glm::f32 INF = std::numeric_limits<glm::f32>::infinity();
+        glm::uint32 padded = size_ + LANE_PADDING;
+
+        min_x_.resize(padded,  INF);
+        min_y_.resize(padded,  INF);
+        min_z_.resize(padded,  INF);
+        max_x_.resize(padded, -INF);
+        max_y_.resize(padded, -INF);
+        max_z_.resize(padded, -INF);
+    }
+
+    set(size_++, box);
+}
+
+
+
+/**
+* @brief Overwrite an existing box
+*
+* @param index Index of the box
+* @param box   New value
+*/
+void BoundingBoxArray::set(glm::uint32 index, const BoundingBox& box)
+{
+    min_x_[index] = box.pmin_.x;
+    min_y_[index] = box.pmin_.y;
+    min_z_[index] = box.pmin_.z;
+    max_x_[index] = box.pmax_.x;
+    max_y_[index] = box.pmax_.y;
+    max_z_[index] = box.pmax_.z;
+}
+
+
+
+BoundingBox BoundingBoxArray::get(glm::uint32 index) const
+{
+    return BoundingBox(glm::vec3(min_x_[index], min_y_[index], min_z_[index]),
+                       glm::vec3(max_x_[index], max_y_[index], max_z_[index]));
+}
+
+
+
+void BoundingBoxArray::clear()
+{
+    min_x_.clear(); min_y_.clear(); min_z_.clear();
+    max_x_.clear(); max_y_.clear(); max_z_.clear();
+    size_ = 0;
+}
+
+
+
+void BoundingBoxArray::reserve(glm::uint32 num_boxes)
+{
+    glm::uint32 padded = (num_boxes + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING;
+
+    min_x_.reserve(padded); min_y_.reserve(padded); min_z_.reserve(padded);
+    max_x_.reserve(padded); max_y_.reserve(padded); max_z_.reserve(padded);
+}
+
+
+
+// SCALAR KERNELS
+// --------------
+// Same operations, in the same order, as sqDistPointBox and as the SIMD kernels below
+
+void sqDistPointBoxesScalar(const glm::vec3& point, const BoundingBoxArray& boxes, glm::f32* sq_dists)
+{
+    for (glm::uint32 index = 0; index < boxes.size(); ++index)
+    {
+        glm::f32 dx = point.x - std::min(std::max(point.x, boxes.min_x_[index]), boxes.max_x_[index]);
+        glm::f32 dy = point.y - std::min(std::max(point.y, boxes.min_y_[index]), boxes.max_y_[index]);
+        glm::f32 dz = point.z - std::min(std::max(point.z, boxes.min_z_[index]), boxes.max_z_[index]);
+
+        sq_dists[index] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+
+
+void testSphereBoxesScalar(const BoundingSphere& sphere, const BoundingBoxArray& boxes, BoxIndexList& hits)
+{
+    const glm::vec3& c = sphere.center_;
+    glm::f32 sq_radius = sphere.radius_ * sphere.radius_;
+
+    for (glm::uint32 index = 0; index < boxes.size(); ++index)
+    {
+        glm::f32 dx = c.x - std::min(std::max(c.x, boxes.min_x_[index]), boxes.max_x_[index]);
+        glm::f32 dy = c.y - std::min(std::max(c.y, boxes.min_y_[index]), boxes.max_y_[index]);
+        glm::f32 dz = c.z - std::min(std::max(c.z, boxes.min_z_[index]), boxes.max_z_[index]);
+
+        if (dx * dx + dy * dy + dz * dz <= sq_radius)
+            hits.push_back(index);
+    }
+}
+
+
+
+// SIMD KERNELS
+// ------------
+#if JU_BATCH_AVX2 || JU_BATCH_SSE
+/**
+* @brief Index of the lowest set bit of a non-zero mask
+*/
+static inline glm::uint32 lowestBit(glm::uint32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+#if JU_BATCH_AVX2
+
+static const glm::uint32 LANES = 8;
+
+/**
+* @brief Square distances from a point to 8 boxes starting at 'index'
+*/
+static inline __m256 sqDistPointBox8(const __m256& px, const __m256& py, const __m256& pz, const BoundingBoxArray& boxes, glm::uint32 index)
+{
+    __m256 dx = _mm256_sub_ps(px, _mm256_min_ps(_mm256_max_ps(px, _mm256_loadu_ps(&boxes.min_x_[index])), _mm256_loadu_ps(&boxes.max_x_[index])));
+    __m256 dy = _mm256_sub_ps(py, _mm256_min_ps(_mm256_max_ps(py, _mm256_loadu_ps(&boxes.min_y_[index])), _mm256_loadu_ps(&boxes.max_y_[index])));
+    __m256 dz = _mm256_sub_ps(pz, _mm256_min_ps(_mm256_max_ps(pz, _mm256_loadu_ps(&boxes.min_z_[index])), _mm256_loadu_ps(&boxes.max_z_[index])));
+
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+}
+
+#elif JU_BATCH_SSE
+
+static const glm::uint32 LANES = 4;
+
+/**
+* @brief Square distances from a point to 4 boxes starting at 'index'
+*/
+static inline __m128 sqDistPointBox4(const __m128& px, const __m128& py, const __m128& pz, const BoundingBoxArray& boxes, glm::uint32 index)
+{
+    __m128 dx = _mm_sub_ps(px, _mm_min_ps(_mm_max_ps(px, _mm_loadu_ps(&boxes.min_x_[index])), _mm_loadu_ps(&boxes.max_x_[index])));
+    __m128 dy = _mm_sub_ps(py, _mm_min_ps(_mm_max_ps(py, _mm_loadu_ps(&boxes.min_y_[index])), _mm_loadu_ps(&boxes.max_y_[index])));
+    __m128 dz = _mm_sub_ps(pz, _mm_min_ps(_mm_max_ps(pz, _mm_loadu_ps(&boxes.min_z_[index])), _mm_loadu_ps(&boxes.max_z_[index])));
+
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+}
+
+#endif
+
+
+
+/**
+* @brief Square distance from a point to every box in the set
+*
+* @param point    Query point
+* @param boxes    Set of boxes
+* @param sq_dists Output array; it must have room for boxes.paddedSize() values
+*/
+void sqDistPointBoxes(const glm::vec3& point, const BoundingBoxArray& boxes, glm::f32* sq_dists)
+{
+#if JU_BATCH_AVX2
+    __m256 px = _mm256_set1_ps(point.x);
+    __m256 py = _mm256_set1_ps(point.y);
+    __m256 pz = _mm256_set1_ps(point.z);
+
+    for (glm::uint32 index = 0; index < boxes.size(); index += LANES)
+        _mm256_storeu_ps(&sq_dists[index], sqDistPointBox8(px, py, pz, boxes, index));
+#elif JU_BATCH_SSE
+    __m128 px = _mm_set1_ps(point.x);
+    __m128 py = _mm_set1_ps(point.y);
+    __m128 pz = _mm_set1_ps(point.z);
+
+    for (glm::uint32 index = 0; index < boxes.size(); index += LANES)
+        _mm_storeu_ps(&sq_dists[index], sqDistPointBox4(px, py, pz, boxes, index));
+#else
+    sqDistPointBoxesScalar(point, boxes, sq_dists);
+#endif
+}
+
+
+
+/**
+* @brief Find all the boxes in the set that intersect a sphere
+*
+* @param sphere Query sphere
+* @param boxes  Set of boxes
+* @param hits   List where the indices of the boxes hit are appended (in increasing order)
+*/
+void testSphereBoxes(const BoundingSphere& sphere, const BoundingBoxArray& boxes, BoxIndexList& hits)
+{
+#if JU_BATCH_AVX2
+    __m256 px = _mm256_set1_ps(sphere.center_.x);
+    __m256 py = _mm256_set1_ps(sphere.center_.y);
+    __m256 pz = _mm256_set1_ps(sphere.center_.z);
+    __m256 sq_radius = _mm256_set1_ps(sphere.radius_ * sphere.radius_);
+
+    for (glm::uint32 index = 0; index < boxes.size(); index += LANES)
+    {
+        glm::uint32 mask = _mm256_movemask_ps(_mm256_cmp_ps(sqDistPointBox8(px, py, pz, boxes, index), sq_radius, _CMP_LE_OQ));
+
+        // Padding lanes never pass the test, so only the set bits need to be visited
+        while (mask)
+        {
+            hits.push_back(index + lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#elif JU_BATCH_SSE
+    __m128 px = _mm_set1_ps(sphere.center_.x);
+    __m128 py = _mm_set1_ps(sphere.center_.y);
+    __m128 pz = _mm_set1_ps(sphere.center_.z);
+    __m128 sq_radius = _mm_set1_ps(sphere.radius_ * sphere.radius_);
+
+    for (glm::uint32 index = 0; index < boxes.size(); index += LANES)
+    {
+        glm::uint32 mask = _mm_movemask_ps(_mm_cmple_ps(sqDistPointBox4(px, py, pz, boxes, index), sq_radius));
+
+        while (mask)
+        {
+            hits.push_back(index + lowestBit(mask));
+            mask &= mask - 1;
+        }
+    }
+#else
+    testSphereBoxesScalar(sphere, boxes, hits);
+#endif
+}
+
+
+
+/**
+* @brief Find all the (sphere, box) pairs that intersect
+*
+* @param spheres Query spheres
+* @param boxes   Set of boxes
+* @param hits    List where the (sphere index, box index) pairs are appended
+*/
+void testSphereBoxes(const std::vector<BoundingSphere>& spheres, const BoundingBoxArray& boxes, SphereBoxPairList& hits)
+{
+    BoxIndexList sphere_hits;
+
+    for (glm::uint32 sphere = 0; sphere < spheres.size(); ++sphere)
+    {
+        sphere_hits.clear();
+        testSphereBoxes(spheres[sphere], boxes, sphere_hits);
+
+        for (BoxIndexList::const_iterator iter = sphere_hits.begin(); iter != sphere_hits.end(); ++iter)
+            hits.push_back(std::make_pair(sphere, *iter));
+    }
+}
+
+
+
+/**
+* @brief Name of the kernel compiled in (for logging)
+*/
+const char* getBatchIntersectionKernelName()
+{
+#if JU_BATCH_AVX2
+    return "AVX2";
+#elif JU_BATCH_SSE
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
+
+}   // end namespace JU
@@ -0,0 +1,75 @@
+/*
+ * BatchIntersection.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef BATCHINTERSECTION_HPP_
+#define BATCHINTERSECTION_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingBox, BoundingSphere
+// Global includes
+#include <glm/glm.hpp>          // vec3, f32, uint32
+#include <vector>               // std::vector
+#include <utility>              // std::pair
+
+namespace JU
+{
+    /**
+     * @brief Set of boxes stored as a structure of arrays
+     *
+     * @detail Each coordinate of the minimum and maximum points lives in its own array so the batched kernels can
+     *         load 4 (SSE) or 8 (AVX2) boxes per instruction. The arrays are padded up to a multiple of LANE_PADDING
+     *         with inverted boxes (min = +inf, max = -inf) that are infinitely far from every point, so the kernels
+     *         never need a scalar tail loop.
+     */
+    class BoundingBoxArray
+    {
+        public:
+            static const glm::uint32 LANE_PADDING = 8;
+
+        public:
+            BoundingBoxArray();
+            explicit BoundingBoxArray(const std::vector<BoundingBox>& boxes);
+
+            void add(const BoundingBox& box);
+            void set(glm::uint32 index, const BoundingBox& box);
+            BoundingBox get(glm::uint32 index) const;
+            void clear();
+            void reserve(glm::uint32 num_boxes);
+
+            inline glm::uint32 size() const { return size_; }
+            inline glm::uint32 paddedSize() const { return min_x_.size(); }
+
+        public:
+            std::vector<glm::f32> min_x_;   //!< X coordinate of the minimum points
+            std::vector<glm::f32> min_y_;   //!< Y coordinate of the minimum points
+            std::vector<glm::f32> min_z_;   //!< Z coordinate of the minimum points
+            std::vector<glm::f32> max_x_;   //!< X coordinate of the maximum points
+            std::vector<glm::f32> max_y_;   //!< Y coordinate of the maximum points
+            std::vector<glm::f32> max_z_;   //!< Z coordinate of the maximum points
+
+        private:
+            glm::uint32 size_;              //!< Number of actual boxes (the arrays may be longer because of padding)
+    };
+
+    typedef std::vector<glm::uint32>                              BoxIndexList;
+    typedef std::vector<std::pair<glm::uint32, glm::uint32> >     SphereBoxPairList;
+
+    // Batched kernels. They use AVX2 or SSE when the translation unit is compiled with support for them
+    // (e.g. -mavx2), and the scalar kernel otherwise. All of them give bit-identical results.
+    void sqDistPointBoxes(const glm::vec3& point, const BoundingBoxArray& boxes, glm::f32* sq_dists);
+    void testSphereBoxes(const BoundingSphere& sphere, const BoundingBoxArray& boxes, BoxIndexList& hits);
+    void testSphereBoxes(const std::vector<BoundingSphere>& spheres, const BoundingBoxArray& boxes, SphereBoxPairList& hits);
+
+    // Scalar kernels (reference implementation)
+    void sqDistPointBoxesScalar(const glm::vec3& point, const BoundingBoxArray& boxes, glm::f32* sq_dists);
+    void testSphereBoxesScalar(const BoundingSphere& sphere, const BoundingBoxArray& boxes, BoxIndexList& hits);
+
+    const char* getBatchIntersectionKernelName();
+
+}   // end namespace JU
+
+#endif /* BATCHINTERSECTION_HPP_ */
@@ -8,7 +8,10 @@
 #ifndef BOUNDINGVOLUMES_HPP_
 #define BOUNDINGVOLUMES_HPP_
 
-#include <glm/glm.hpp>      // vec3, f32
+// Local includes
+#include "../core/Transform3D.hpp"  // Transform3D
+// Global includes
+#include <glm/glm.hpp>              // vec3, mat4, f32
 
 namespace JU
 {
@@ -22,6 +25,52 @@ namespace JU
             BoundingBox() : pmin_(glm::vec3(0.0f)), pmax_(glm::vec3(0.0f)) {}
             BoundingBox(const glm::vec3& pmin, const glm::vec3& pmax) : pmin_(pmin), pmax_(pmax) {}
 
+            inline glm::vec3 getCenter() const
+            {
+                return (pmin_ + pmax_) * 0.5f;
+            }
+
+            inline glm::vec3 getExtents() const
+            {
+                return pmax_ - pmin_;
+            }
+
+            inline glm::f32 getSurfaceArea() const
+            {
+                glm::vec3 d(pmax_ - pmin_);
+                return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+            }
+
+            // Grow this box so it also encloses 'box'
+            inline void merge(const BoundingBox& box)
+            {
+                pmin_ = glm::min(pmin_, box.pmin_);
+                pmax_ = glm::max(pmax_, box.pmax_);
+            }
+
+            // Grow this box so it also encloses 'point'
+            inline void merge(const glm::vec3& point)
+            {
+                pmin_ = glm::min(pmin_, point);
+                pmax_ = glm::max(pmax_, point);
+            }
+
+            // Axis-aligned box enclosing this box once transformed by an affine matrix (Arvo's method)
+            inline BoundingBox transform(const glm::mat4& m) const
+            {
+                glm::vec3 c (getCenter());
+                glm::vec3 h (getExtents() * 0.5f);
+
+                glm::vec3 center (m[0][0] * c.x + m[1][0] * c.y + m[2][0] * c.z + m[3][0],
+                                  m[0][1] * c.x + m[1][1] * c.y + m[2][1] * c.z + m[3][1],
+                                  m[0][2] * c.x + m[1][2] * c.y + m[2][2] * c.z + m[3][2]);
+                glm::vec3 half (glm::abs(m[0][0]) * h.x + glm::abs(m[1][0]) * h.y + glm::abs(m[2][0]) * h.z,
+                                glm::abs(m[0][1]) * h.x + glm::abs(m[1][1]) * h.y + glm::abs(m[2][1]) * h.z,
+                                glm::abs(m[0][2]) * h.x + glm::abs(m[1][2]) * h.y + glm::abs(m[2][2]) * h.z);
+
+                return BoundingBox(center - half, center + half);
+            }
+
         public:
             glm::vec3 pmin_;    //!< Minimum extreme point
             glm::vec3 pmax_;    //!< Maximum extreme point
@@ -35,6 +84,7 @@ namespace JU
     class BoundingSphere
     {
         public:
+            BoundingSphere() : center_(glm::vec3(0.0f)), radius_(0.0f) {}
             BoundingSphere(const glm::vec3& center, glm::f32 radius) : center_(center), radius_(radius) {}
 
         public:
@@ -43,6 +93,64 @@ namespace JU
     };
 
 
+    /**
+     * @brief Oriented Bounding Box class
+     *
+     * @detail Box centered at a point and aligned with an orthonormal frame, so rotated objects do not need the
+     *         inflated axis-aligned box that encloses them
+     */
+    class BoundingOrientedBox
+    {
+        public:
+            BoundingOrientedBox(const glm::vec3& center = glm::vec3(0.0f), const glm::vec3& half_extents = glm::vec3(0.0f),
+                                const glm::vec3& x_axis = glm::vec3(1.0f, 0.0f, 0.0f),
+                                const glm::vec3& y_axis = glm::vec3(0.0f, 1.0f, 0.0f),
+                                const glm::vec3& z_axis = glm::vec3(0.0f, 0.0f, 1.0f))
+                : center_(center), half_extents_(half_extents)
+            {
+                axis_[0] = x_axis;
+                axis_[1] = y_axis;
+                axis_[2] = z_axis;
+            }
+
+            // Box with the given half extents in the frame of 'transform' (centered at its position)
+            BoundingOrientedBox(const Transform3D& transform, const glm::vec3& half_extents)
+                : center_(transform.getPosition()), half_extents_(half_extents)
+            {
+                axis_[0] = transform.getXAxis();
+                axis_[1] = transform.getYAxis();
+                axis_[2] = transform.getZAxis();
+            }
+
+            // Model space box 'box' placed by 'transform' (the box does not need to be centered at the origin)
+            BoundingOrientedBox(const Transform3D& transform, const BoundingBox& box)
+                : half_extents_(box.getExtents() * 0.5f)
+            {
+                axis_[0] = transform.getXAxis();
+                axis_[1] = transform.getYAxis();
+                axis_[2] = transform.getZAxis();
+
+                glm::vec3 c (box.getCenter());
+                center_ = transform.getPosition() + axis_[0] * c.x + axis_[1] * c.y + axis_[2] * c.z;
+            }
+
+            // Tightest axis-aligned box enclosing this one (for the broadphase)
+            inline BoundingBox getBoundingBox() const
+            {
+                glm::vec3 half (glm::abs(axis_[0]) * half_extents_.x +
+                                glm::abs(axis_[1]) * half_extents_.y +
+                                glm::abs(axis_[2]) * half_extents_.z);
+
+                return BoundingBox(center_ - half, center_ + half);
+            }
+
+        public:
+            glm::vec3 center_;          //!< Center of the box
+            glm::vec3 axis_[3];         //!< Orthonormal local axes
+            glm::vec3 half_extents_;    //!< Half the size of the box along each local axis
+    };
+
+
 }   // end namespace JU
 
 
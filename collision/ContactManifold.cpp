@@ -0,0 +1,199 @@
+/*
+ * ContactManifold.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "ContactManifold.hpp"
+// Global includes
+#include <algorithm>    // std::max
+
+namespace JU
+{
+
+namespace
+{
+    inline glm::vec3 toLocal(const Transform3D& frame, const glm::vec3& point)
+    {
+        glm::vec3 d (point - frame.getPosition());
+
+        return glm::vec3(glm::dot(d, frame.getXAxis()), glm::dot(d, frame.getYAxis()), glm::dot(d, frame.getZAxis()));
+    }
+
+    inline glm::vec3 toWorld(const Transform3D& frame, const glm::vec3& point)
+    {
+        return frame.getPosition() + frame.getXAxis() * point.x + frame.getYAxis() * point.y + frame.getZAxis() * point.z;
+    }
+
+    // Squared area of the quad (approximated with the cross product of its diagonals)
+    inline glm::f32 getQuadArea(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3)
+    {
+        glm::vec3 a (glm::cross(p0 - p1, p2 - p3));
+        glm::vec3 b (glm::cross(p0 - p2, p1 - p3));
+        glm::vec3 c (glm::cross(p0 - p3, p1 - p2));
+
+        return std::max(glm::dot(a, a), std::max(glm::dot(b, b), glm::dot(c, c)));
+    }
+}
+
+
+
+/**
+* @brief Constructor
+*
+* @param breaking_distance Points that separate or slide further than this are dropped
+*/
+ContactManifold::ContactManifold(glm::f32 breaking_distance) : num_points_(0), breaking_distance_(breaking_distance)
+{
+}
+
+
+
+/**
+* @brief Destructor
+*/
+ContactManifold::~ContactManifold()
+{
+}
+
+
+
+/**
+* @brief Update the contact points for the current position of the bodies
+*
+* @param shape_a Shape of body A (world coordinates)
+* @param frame_a Frame of body A (the points of A are kept in it)
+* @param shape_b Shape of body B (world coordinates)
+* @param frame_b Frame of body B (the points of B are kept in it)
+*
+* @return Are the shapes in contact?
+*/
+bool ContactManifold::update(const ConvexShape& shape_a, const Transform3D& frame_a,
+                             const ConvexShape& shape_b, const Transform3D& frame_b)
+{
+    Point point;
+
+    if (!computeContact(shape_a, shape_b, point.contact_, &cache_))
+    {
+        num_points_ = 0;
+        return false;
+    }
+
+    refresh(frame_a, frame_b);
+
+    point.local_a_ = toLocal(frame_a, point.contact_.point_a_);
+    point.local_b_ = toLocal(frame_b, point.contact_.point_b_);
+    add(point);
+
+    return true;
+}
+
+
+
+/**
+* @brief Remove all the contact points and forget the warm start
+*/
+void ContactManifold::clear()
+{
+    num_points_ = 0;
+    cache_      = GJKCache();
+}
+
+
+
+/**
+* @brief Move the points with the bodies and drop the ones that are no longer valid
+*/
+void ContactManifold::refresh(const Transform3D& frame_a, const Transform3D& frame_b)
+{
+    for (glm::uint32 index = 0; index < num_points_; )
+    {
+        Contact& contact = points_[index].contact_;
+        contact.point_a_ = toWorld(frame_a, points_[index].local_a_);
+        contact.point_b_ = toWorld(frame_b, points_[index].local_b_);
+
+        glm::vec3 d (contact.point_a_ - contact.point_b_);
+        contact.depth_ = glm::dot(d, contact.normal_);
+
+        glm::vec3 tangent (d - contact.normal_ * contact.depth_);
+
+        if (contact.depth_ < -breaking_distance_ || glm::dot(tangent, tangent) > breaking_distance_ * breaking_distance_)
+            points_[index] = points_[--num_points_];
+        else
+            ++index;
+    }
+}
+
+
+
+/**
+* @brief Add a new point, replacing an old one at the same place or reducing the set if there are too many
+*/
+void ContactManifold::add(const Point& point)
+{
+    glm::f32 sq_breaking = breaking_distance_ * breaking_distance_;
+
+    for (glm::uint32 index = 0; index < num_points_; ++index)
+    {
+        glm::vec3 d (points_[index].contact_.point_a_ - point.contact_.point_a_);
+
+        if (glm::dot(d, d) < sq_breaking)
+        {
+            points_[index] = point;
+            return;
+        }
+    }
+
+    points_[num_points_++] = point;
+
+    if (num_points_ <= MAX_CONTACTS)
+        return;
+
+    // Keep the deepest point, and drop the point whose removal leaves the largest area
+    glm::uint32 deepest = 0;
+    for (glm::uint32 index = 1; index < num_points_; ++index)
+        if (points_[index].contact_.depth_ > points_[deepest].contact_.depth_)
+            deepest = index;
+
+    glm::uint32 drop     = (deepest == 0) ? 1 : 0;
+    glm::f32    max_area = -1.0f;
+
+    for (glm::uint32 candidate = 0; candidate < num_points_; ++candidate)
+    {
+        if (candidate == deepest)
+            continue;
+
+        glm::vec3 p[MAX_CONTACTS];
+        glm::uint32 count = 0;
+        for (glm::uint32 index = 0; index < num_points_; ++index)
+            if (index != candidate)
+                p[count++] = points_[index].contact_.point_a_;
+
+        glm::f32 area = getQuadArea(p[0], p[1], p[2], p[3]);
+        if (area > max_area)
+        {
+            max_area = area;
+            drop     = candidate;
+        }
+    }
+
+    points_[drop] = points_[--num_points_];
+}
+
+
+
+glm::uint32 ContactManifold::getNumContacts() const
+{
+    return num_points_;
+}
+
+
+
+const Contact& ContactManifold::getContact(glm::uint32 index) const
+{
+    return points_[index].contact_;
+}
+
+}   // end namespace JU
@@ -0,0 +1,67 @@
+/*
+ * ContactManifold.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef CONTACTMANIFOLD_HPP_
+#define CONTACTMANIFOLD_HPP_
+
+// Local includes
+#include "GJK.hpp"                  // Contact, GJKCache, computeContact
+#include "ConvexShapes.hpp"         // ConvexShape
+#include "../core/Transform3D.hpp"  // Transform3D
+// Global includes
+#include <glm/glm.hpp>              // vec3, f32, uint32
+
+namespace JU
+{
+    /**
+     * @brief Persistent set of up to MAX_CONTACTS contact points between two bodies
+     *
+     * @detail GJK/EPA only finds one contact point per call, which is not enough for a box to rest on a face. The
+     *         manifold keeps the points found in previous frames in the local frame of each body, refreshes them
+     *         every frame as the bodies move and drops the ones that separated or slid too far. When there are too
+     *         many, it keeps the deepest one and the ones that cover the largest area. The GJK search direction of
+     *         the pair is kept too, so resting contacts are found in one or two iterations.
+     */
+    class ContactManifold
+    {
+        public:
+            static const glm::uint32 MAX_CONTACTS = 4;
+
+        public:
+            ContactManifold(glm::f32 breaking_distance = 0.02f);
+            virtual ~ContactManifold();
+
+            bool update(const ConvexShape& shape_a, const Transform3D& frame_a,
+                        const ConvexShape& shape_b, const Transform3D& frame_b);
+            void clear();
+
+            // Getters
+            glm::uint32 getNumContacts() const;
+            const Contact& getContact(glm::uint32 index) const;
+
+        private:
+            struct Point
+            {
+                Contact   contact_;     //!< Contact in world coordinates (as of the last update)
+                glm::vec3 local_a_;     //!< Point of A in the frame of A
+                glm::vec3 local_b_;     //!< Point of B in the frame of B
+            };
+
+        private:
+            void refresh(const Transform3D& frame_a, const Transform3D& frame_b);
+            void add(const Point& point);
+
+        private:
+            Point       points_[MAX_CONTACTS + 1];  //!< Contact points (one extra while reducing)
+            glm::uint32 num_points_;                //!< Number of contact points
+            glm::f32    breaking_distance_;         //!< Points that drift further than this are dropped
+            GJKCache    cache_;                     //!< Warm start for GJK
+    };
+
+}   // end namespace JU
+
+#endif /* CONTACTMANIFOLD_HPP_ */
@@ -0,0 +1,105 @@
+/*
+ * ConvexShapes.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "ConvexShapes.hpp"
+
+namespace JU
+{
+
+/**
+* @brief Constructor
+*
+* @param points    Points in model coordinates
+* @param transform Placement of the points in world coordinates
+*/
+ConvexHull::ConvexHull(const std::vector<glm::vec3>& points, const Transform3D& transform) : points_(points), transform_(transform)
+{
+    computeCenter();
+}
+
+
+
+/**
+* @brief Constructor
+*
+* @detail Only the vertices the triangles use are kept, each once (e.g. a mesh with its vertex and triangle index lists)
+*
+* @param positions Vertices of the mesh in model coordinates
+* @param indices   Three indices into 'positions' per triangle
+* @param transform Placement of the mesh in world coordinates
+*/
+ConvexHull::ConvexHull(const std::vector<glm::vec3>& positions, const std::vector<glm::uint32>& indices, const Transform3D& transform) : transform_(transform)
+{
+    std::vector<char> used (positions.size(), false);
+
+    for (std::vector<glm::uint32>::const_iterator iter = indices.begin(); iter != indices.end(); ++iter)
+    {
+        if (*iter < positions.size() && !used[*iter])
+        {
+            used[*iter] = true;
+            points_.push_back(positions[*iter]);
+        }
+    }
+
+    computeCenter();
+}
+
+
+
+void ConvexHull::computeCenter()
+{
+    center_ = glm::vec3(0.0f);
+
+    for (std::vector<glm::vec3>::const_iterator iter = points_.begin(); iter != points_.end(); ++iter)
+        center_ += *iter;
+
+    if (!points_.empty())
+        center_ /= static_cast<glm::f32>(points_.size());
+}
+
+
+
+glm::vec3 ConvexHull::getSupport(const glm::vec3& direction) const
+{
+    // Direction in model coordinates
+    glm::vec3 local (glm::dot(direction, transform_.getXAxis()),
+                     glm::dot(direction, transform_.getYAxis()),
+                     glm::dot(direction, transform_.getZAxis()));
+
+    glm::vec3 support (center_);
+    glm::f32  max_dot = -1e30f;
+
+    for (std::vector<glm::vec3>::const_iterator iter = points_.begin(); iter != points_.end(); ++iter)
+    {
+        glm::f32 dot = glm::dot(*iter, local);
+
+        if (dot > max_dot)
+        {
+            max_dot = dot;
+            support = *iter;
+        }
+    }
+
+    return transform_.getPosition() + transform_.getXAxis() * support.x + transform_.getYAxis() * support.y + transform_.getZAxis() * support.z;
+}
+
+
+
+glm::vec3 ConvexHull::getCenter() const
+{
+    return transform_.getPosition() + transform_.getXAxis() * center_.x + transform_.getYAxis() * center_.y + transform_.getZAxis() * center_.z;
+}
+
+
+
+void ConvexHull::setTransform(const Transform3D& transform)
+{
+    transform_ = transform;
+}
+
+}   // end namespace JU
@@ -0,0 +1,135 @@
+/*
+ * ConvexShapes.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef CONVEXSHAPES_HPP_
+#define CONVEXSHAPES_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"      // BoundingBox, BoundingSphere, BoundingOrientedBox
+#include "../core/Transform3D.hpp"  // Transform3D
+// Global includes
+#include <glm/glm.hpp>              // vec3, f32
+#include <vector>                   // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Interface of the convex shapes GJK/EPA work with
+     *
+     * @detail A convex shape is only described by its support function: the point of the shape that is furthest along
+     *         a given direction. All points are in world coordinates.
+     */
+    class ConvexShape
+    {
+        public:
+            virtual ~ConvexShape() {}
+
+            virtual glm::vec3 getSupport(const glm::vec3& direction) const = 0;
+            virtual glm::vec3 getCenter() const = 0;
+    };
+
+
+    class ConvexSphere : public ConvexShape
+    {
+        public:
+            ConvexSphere(const BoundingSphere& sphere) : sphere_(sphere) {}
+
+            glm::vec3 getSupport(const glm::vec3& direction) const
+            {
+                glm::f32 length = glm::length(direction);
+
+                if (length == 0.0f)
+                    return sphere_.center_ + glm::vec3(sphere_.radius_, 0.0f, 0.0f);
+
+                return sphere_.center_ + direction * (sphere_.radius_ / length);
+            }
+
+            glm::vec3 getCenter() const
+            {
+                return sphere_.center_;
+            }
+
+        public:
+            BoundingSphere sphere_;
+    };
+
+
+    class ConvexBox : public ConvexShape
+    {
+        public:
+            ConvexBox(const BoundingBox& box) : box_(box) {}
+
+            glm::vec3 getSupport(const glm::vec3& direction) const
+            {
+                return glm::vec3(direction.x >= 0.0f ? box_.pmax_.x : box_.pmin_.x,
+                                 direction.y >= 0.0f ? box_.pmax_.y : box_.pmin_.y,
+                                 direction.z >= 0.0f ? box_.pmax_.z : box_.pmin_.z);
+            }
+
+            glm::vec3 getCenter() const
+            {
+                return box_.getCenter();
+            }
+
+        public:
+            BoundingBox box_;
+    };
+
+
+    class ConvexOrientedBox : public ConvexShape
+    {
+        public:
+            ConvexOrientedBox(const BoundingOrientedBox& box) : box_(box) {}
+
+            glm::vec3 getSupport(const glm::vec3& direction) const
+            {
+                glm::vec3 support (box_.center_);
+
+                for (int axis = 0; axis < 3; ++axis)
+                    support += box_.axis_[axis] * (glm::dot(direction, box_.axis_[axis]) >= 0.0f ? box_.half_extents_[axis] : -box_.half_extents_[axis]);
+
+                return support;
+            }
+
+            glm::vec3 getCenter() const
+            {
+                return box_.center_;
+            }
+
+        public:
+            BoundingOrientedBox box_;
+    };
+
+
+    /**
+     * @brief Convex hull of a point cloud (e.g. the vertices of a mesh) placed by a Transform3D
+     *
+     * @detail The hull itself is never built: the support point of a point cloud is the support point of its hull
+     */
+    class ConvexHull : public ConvexShape
+    {
+        public:
+            ConvexHull(const std::vector<glm::vec3>& points, const Transform3D& transform = Transform3D());
+            ConvexHull(const std::vector<glm::vec3>& positions, const std::vector<glm::uint32>& indices, const Transform3D& transform = Transform3D());
+
+            glm::vec3 getSupport(const glm::vec3& direction) const;
+            glm::vec3 getCenter() const;
+
+            void setTransform(const Transform3D& transform);
+
+        private:
+            void computeCenter();
+
+        private:
+            std::vector<glm::vec3> points_;     //!< Points in model coordinates
+            glm::vec3              center_;     //!< Average of the points in model coordinates
+            Transform3D            transform_;  //!< Placement of the points in world coordinates
+    };
+
+}   // end namespace JU
+
+#endif /* CONVEXSHAPES_HPP_ */
@@ -12,26 +12,54 @@
 #include "BoundingVolumes.hpp"     // BoundingBox
 // Global includes
 #include <glm/glm.hpp>      // vec3
+#include <algorithm>        // std::min, std::max
 
 
 namespace JU
 {
+    /**
+     * @brief Square distance from a point to a box (zero if inside)
+     *
+     * @detail The point is clamped to the box and the distance to the clamped point is returned. Written without
+     *         branches so it gives exactly the same result as the batched kernels in BatchIntersection.hpp
+     */
     inline glm::f32 sqDistPointBox(const glm::vec3& point, const BoundingBox& box)
     {
-        glm::f32 sqDist = 0.0f;
+        glm::f32 dx = point.x - std::min(std::max(point.x, box.pmin_.x), box.pmax_.x);
+        glm::f32 dy = point.y - std::min(std::max(point.y, box.pmin_.y), box.pmax_.y);
+        glm::f32 dz = point.z - std::min(std::max(point.z, box.pmin_.z), box.pmax_.z);
 
-        for (glm::uint8 i = 0; i < 3; i++)
-        {
-            // For each of the axis add the square distance to the closest side of the box (or zero, if inside)
-            glm::f32 v = point[i];
+        return dx * dx + dy * dy + dz * dz;
+    }
 
-            if (v < box.pmin_[i])
-                sqDist += (box.pmin_[i] - v) * (box.pmin_[i] - v);
-            if (v > box.pmax_[i])
-                sqDist += (v - box.pmax_[i]) * (v - box.pmax_[i]);
+    /**
+     * @brief Closest point of an oriented box to a point
+     *
+     * @detail The point is projected on each local axis and clamped to the half extents
+     */
+    inline glm::vec3 closestPointOBB(const glm::vec3& point, const BoundingOrientedBox& box)
+    {
+        glm::vec3 d (point - box.center_);
+        glm::vec3 closest (box.center_);
+
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            glm::f32 dist = glm::dot(d, box.axis_[axis]);
+            dist = std::min(std::max(dist, -box.half_extents_[axis]), box.half_extents_[axis]);
+            closest += dist * box.axis_[axis];
         }
 
-        return sqDist;
+        return closest;
+    }
+
+    /**
+     * @brief Square distance from a point to an oriented box (zero if inside)
+     */
+    inline glm::f32 sqDistPointOBB(const glm::vec3& point, const BoundingOrientedBox& box)
+    {
+        glm::vec3 d (point - closestPointOBB(point, box));
+
+        return glm::dot(d, d);
     }
 
 } // namespace JU
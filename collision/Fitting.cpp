@@ -0,0 +1,323 @@
+/*
+ * Fitting.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "Fitting.hpp"
+// Global includes
+#include <cmath>        // std::sqrt, std::abs
+#include <algorithm>    // std::min, std::max
+#include <thread>       // std::thread
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>  // __m128
+    #define JU_FITTING_SSE 1
+#endif
+
+namespace JU
+{
+
+namespace
+{
+    /**
+     * @brief Min/max reduction over points [begin, end)
+     *
+     * @detail Four packed vec3 are twelve floats, i.e. three SSE registers holding the components in the order
+     *         (x y z x) (y z x y) (z x y z). Each register keeps its own running min and max, and the lanes holding the
+     *         same component are merged at the end.
+     */
+    void reduceMinMax(const glm::vec3* points, glm::uint32 begin, glm::uint32 end, BoundingBox& box)
+    {
+        glm::vec3 pmin (points[begin]);
+        glm::vec3 pmax (points[begin]);
+        glm::uint32 index = begin;
+
+#if JU_FITTING_SSE
+        if (end - begin >= 4)
+        {
+            const float* data = &points[begin].x;
+            __m128 min0 = _mm_loadu_ps(data), min1 = _mm_loadu_ps(data + 4), min2 = _mm_loadu_ps(data + 8);
+            __m128 max0 = min0, max1 = min1, max2 = min2;
+
+            for (index = begin + 4; index + 4 <= end; index += 4)
+            {
+                data = &points[index].x;
+                __m128 r0 = _mm_loadu_ps(data), r1 = _mm_loadu_ps(data + 4), r2 = _mm_loadu_ps(data + 8);
+
+                min0 = _mm_min_ps(min0, r0); max0 = _mm_max_ps(max0, r0);
+                min1 = _mm_min_ps(min1, r1); max1 = _mm_max_ps(max1, r1);
+                min2 = _mm_min_ps(min2, r2); max2 = _mm_max_ps(max2, r2);
+            }
+
+            float lo[12], hi[12];
+            _mm_storeu_ps(lo, min0); _mm_storeu_ps(lo + 4, min1); _mm_storeu_ps(lo + 8, min2);
+            _mm_storeu_ps(hi, max0); _mm_storeu_ps(hi + 4, max1); _mm_storeu_ps(hi + 8, max2);
+
+            // Float i of the twelve holds component (i % 3)
+            for (int i = 0; i < 12; ++i)
+            {
+                pmin[i % 3] = std::min(pmin[i % 3], lo[i]);
+                pmax[i % 3] = std::max(pmax[i % 3], hi[i]);
+            }
+        }
+#endif
+
+        for (; index < end; ++index)
+        {
+            pmin = glm::min(pmin, points[index]);
+            pmax = glm::max(pmax, points[index]);
+        }
+
+        box = BoundingBox(pmin, pmax);
+    }
+
+    /**
+     * @brief Eigenvectors of a symmetric 3x3 matrix with Jacobi rotations
+     *
+     * @detail Each rotation zeroes the largest off-diagonal element (Ericson, Real-Time Collision Detection, 4.3.5).
+     *         The columns of 'v' end up holding the eigenvectors.
+     */
+    void jacobi(glm::f32 a[3][3], glm::f32 v[3][3])
+    {
+        const int MAX_ROTATIONS = 50;
+
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                v[i][j] = (i == j) ? 1.0f : 0.0f;
+
+        glm::f32 prev_off = 1e30f;
+
+        for (int rotation = 0; rotation < MAX_ROTATIONS; ++rotation)
+        {
+            // Largest off-diagonal element
+            int p = 0, q = 1;
+            for (int i = 0; i < 3; ++i)
+                for (int j = i + 1; j < 3; ++j)
+                    if (std::abs(a[i][j]) > std::abs(a[p][q]))
+                    {
+                        p = i;
+                        q = j;
+                    }
+
+            glm::f32 c = 1.0f, s = 0.0f;
+            if (std::abs(a[p][q]) > 0.0f)
+            {
+                glm::f32 r = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+                glm::f32 t = (r >= 0.0f) ? 1.0f / (r + std::sqrt(1.0f + r * r)) : -1.0f / (-r + std::sqrt(1.0f + r * r));
+                c = 1.0f / std::sqrt(1.0f + t * t);
+                s = t * c;
+            }
+
+            // a = J^T * a * J, v = v * J
+            glm::f32 J[3][3] = { {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f} };
+            J[p][p] =  c; J[p][q] = s;
+            J[q][p] = -s; J[q][q] = c;
+
+            glm::f32 tmp[3][3];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    tmp[i][j] = v[i][0] * J[0][j] + v[i][1] * J[1][j] + v[i][2] * J[2][j];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    v[i][j] = tmp[i][j];
+
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    tmp[i][j] = a[i][0] * J[0][j] + a[i][1] * J[1][j] + a[i][2] * J[2][j];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    a[i][j] = J[0][i] * tmp[0][j] + J[1][i] * tmp[1][j] + J[2][i] * tmp[2][j];
+
+            glm::f32 off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+
+            // Stop when the off-diagonal norm stops decreasing
+            if (rotation > 2 && off >= prev_off)
+                return;
+
+            prev_off = off;
+        }
+    }
+}
+
+
+
+/**
+* @brief Axis-aligned box enclosing a point cloud
+*
+* @param points      Points to enclose
+* @param num_threads Number of threads to split the reduction across (the calling thread is one of them)
+*
+* @return The box (degenerate at the origin if there are no points)
+*/
+BoundingBox computeBoundingBox(const std::vector<glm::vec3>& points, glm::uint32 num_threads)
+{
+    glm::uint32 num_points = points.size();
+
+    if (num_points == 0)
+        return BoundingBox();
+
+    // Not worth a thread for less than a few tens of thousands of points
+    const glm::uint32 MIN_POINTS_PER_THREAD = 32768;
+    num_threads = std::max(1u, std::min(num_threads, num_points / MIN_POINTS_PER_THREAD));
+
+    if (num_threads == 1)
+    {
+        BoundingBox box;
+        reduceMinMax(&points[0], 0, num_points, box);
+        return box;
+    }
+
+    std::vector<BoundingBox> boxes(num_threads);
+    std::vector<std::thread> threads;
+    for (glm::uint32 thread = 1; thread < num_threads; ++thread)
+    {
+        glm::uint32 begin = (glm::uint64)num_points * thread / num_threads;
+        glm::uint32 end   = (glm::uint64)num_points * (thread + 1) / num_threads;
+        threads.push_back(std::thread(reduceMinMax, &points[0], begin, end, std::ref(boxes[thread])));
+    }
+    reduceMinMax(&points[0], 0, num_points / num_threads, boxes[0]);
+
+    for (glm::uint32 thread = 0; thread < threads.size(); ++thread)
+        threads[thread].join();
+
+    for (glm::uint32 thread = 1; thread < num_threads; ++thread)
+        boxes[0].merge(boxes[thread]);
+
+    return boxes[0];
+}
+
+
+
+/**
+* @brief Sphere enclosing a point cloud (Ritter)
+*
+* @detail The initial sphere spans the most separated pair among the extreme points along x, y and z. A second pass
+*         grows it just enough to include every point left outside. The result is usually within 5-20% of the
+*         minimum sphere.
+*
+* @param points Points to enclose
+*
+* @return The sphere (a point at the origin if there are no points)
+*/
+BoundingSphere computeBoundingSphere(const std::vector<glm::vec3>& points)
+{
+    if (points.empty())
+        return BoundingSphere(glm::vec3(0.0f), 0.0f);
+
+    // Extreme points along each axis
+    glm::uint32 min_index[3] = {0, 0, 0};
+    glm::uint32 max_index[3] = {0, 0, 0};
+
+    for (glm::uint32 index = 1; index < points.size(); ++index)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (points[index][axis] < points[min_index[axis]][axis]) min_index[axis] = index;
+            if (points[index][axis] > points[max_index[axis]][axis]) max_index[axis] = index;
+        }
+    }
+
+    int best_axis = 0;
+    glm::f32 best_sq_dist = -1.0f;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        glm::vec3 d (points[max_index[axis]] - points[min_index[axis]]);
+        glm::f32 sq_dist = glm::dot(d, d);
+
+        if (sq_dist > best_sq_dist)
+        {
+            best_sq_dist = sq_dist;
+            best_axis    = axis;
+        }
+    }
+
+    glm::vec3 center ((points[min_index[best_axis]] + points[max_index[best_axis]]) * 0.5f);
+    glm::f32  radius = std::sqrt(best_sq_dist) * 0.5f;
+
+    // Grow the sphere to include the points outside
+    for (std::vector<glm::vec3>::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+    {
+        glm::vec3 d (*iter - center);
+        glm::f32  sq_dist = glm::dot(d, d);
+
+        if (sq_dist > radius * radius)
+        {
+            glm::f32 dist       = std::sqrt(sq_dist);
+            glm::f32 new_radius = (radius + dist) * 0.5f;
+
+            center += d * ((new_radius - radius) / dist);
+            radius  = new_radius;
+        }
+    }
+
+    // Round-off in the growing steps can leave the last points a hair outside
+    return BoundingSphere(center, radius * (1.0f + 1e-6f));
+}
+
+
+
+/**
+* @brief Oriented box enclosing a point cloud, aligned with its principal axes
+*
+* @param points Points to enclose
+*
+* @return The box (degenerate at the origin if there are no points)
+*/
+BoundingOrientedBox computeBoundingOrientedBox(const std::vector<glm::vec3>& points)
+{
+    if (points.empty())
+        return BoundingOrientedBox(glm::vec3(0.0f), glm::vec3(0.0f));
+
+    glm::f32 inv_num_points = 1.0f / points.size();
+
+    glm::vec3 mean (0.0f);
+    for (std::vector<glm::vec3>::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+        mean += *iter;
+    mean *= inv_num_points;
+
+    // Covariance matrix
+    glm::f32 cov[3][3] = { {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f} };
+    for (std::vector<glm::vec3>::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+    {
+        glm::vec3 p (*iter - mean);
+
+        for (int i = 0; i < 3; ++i)
+            for (int j = i; j < 3; ++j)
+                cov[i][j] += p[i] * p[j];
+    }
+    for (int i = 0; i < 3; ++i)
+        for (int j = i; j < 3; ++j)
+        {
+            cov[i][j] *= inv_num_points;
+            cov[j][i]  = cov[i][j];
+        }
+
+    glm::f32 eigen[3][3];
+    jacobi(cov, eigen);
+
+    glm::vec3 axis[3];
+    for (int i = 0; i < 3; ++i)
+        axis[i] = glm::normalize(glm::vec3(eigen[0][i], eigen[1][i], eigen[2][i]));
+
+    // Make the frame right-handed and exactly orthonormal
+    axis[2] = glm::normalize(glm::cross(axis[0], axis[1]));
+    axis[1] = glm::cross(axis[2], axis[0]);
+
+    // Extents of the points along the axes
+    glm::vec3 pmin (1e30f), pmax (-1e30f);
+    for (std::vector<glm::vec3>::const_iterator iter = points.begin(); iter != points.end(); ++iter)
+    {
+        glm::vec3 p (glm::dot(*iter, axis[0]), glm::dot(*iter, axis[1]), glm::dot(*iter, axis[2]));
+        pmin = glm::min(pmin, p);
+        pmax = glm::max(pmax, p);
+    }
+
+    glm::vec3 c ((pmin + pmax) * 0.5f);
+
+    return BoundingOrientedBox(axis[0] * c.x + axis[1] * c.y + axis[2] * c.z, (pmax - pmin) * 0.5f, axis[0], axis[1], axis[2]);
+}
+
+}   // end namespace JU
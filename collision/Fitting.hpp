@@ -0,0 +1,33 @@
+/*
+ * Fitting.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef FITTING_HPP_
+#define FITTING_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingBox, BoundingSphere, BoundingOrientedBox
+// Global includes
+#include <glm/glm.hpp>          // vec3, uint32
+#include <vector>               // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Bounding volumes fitted to point clouds (e.g. the positions of a mesh)
+     *
+     * @detail The min/max reduction of the axis-aligned box loads four packed vec3 at a time with SSE and can be split
+     *         across threads for very large clouds. The sphere is Ritter's (seeded with the most separated pair of
+     *         extreme points along the coordinate axes) and the oriented box is fitted along the principal axes of the
+     *         covariance matrix of the points.
+     */
+    BoundingBox computeBoundingBox(const std::vector<glm::vec3>& points, glm::uint32 num_threads = 1);
+    BoundingSphere computeBoundingSphere(const std::vector<glm::vec3>& points);
+    BoundingOrientedBox computeBoundingOrientedBox(const std::vector<glm::vec3>& points);
+
+}   // end namespace JU
+
+#endif /* FITTING_HPP_ */
@@ -0,0 +1,97 @@
+/*
+ * Frustum.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef FRUSTUM_HPP_
+#define FRUSTUM_HPP_
+
+#include <glm/glm.hpp>      // vec3, vec4, mat4, f32
+
+namespace JU
+{
+    /**
+     * @brief View Frustum class
+     *
+     * @detail Six planes (a, b, c, d) with their normals pointing inwards, so a point p is inside if a*x + b*y + c*z + d >= 0
+     *         for all of them. The planes are normalized, so that value is also the signed distance to the plane.
+     */
+    class Frustum
+    {
+        public:
+            enum PlaneId
+            {
+                PLANE_LEFT,
+                PLANE_RIGHT,
+                PLANE_BOTTOM,
+                PLANE_TOP,
+                PLANE_NEAR,
+                PLANE_FAR,
+                NUM_PLANES
+            };
+
+        public:
+            Frustum() {}
+            explicit Frustum(const glm::mat4& view_projection) { set(view_projection); }
+
+            /**
+             * @brief Extract the planes from a (projection * view) matrix (Gribb & Hartmann)
+             *
+             * @detail The planes are in the coordinate system the matrix transforms from (e.g. world coordinates for
+             *         projection * view, or model coordinates for projection * view * model). OpenGL clip space
+             *         (-w <= z <= w) is assumed.
+             *
+             * @param view_projection Matrix transforming to clip coordinates
+             */
+            void set(const glm::mat4& view_projection)
+            {
+                const glm::mat4& m = view_projection;
+                // glm matrices are column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+                glm::vec4 row0 (m[0][0], m[1][0], m[2][0], m[3][0]);
+                glm::vec4 row1 (m[0][1], m[1][1], m[2][1], m[3][1]);
+                glm::vec4 row2 (m[0][2], m[1][2], m[2][2], m[3][2]);
+                glm::vec4 row3 (m[0][3], m[1][3], m[2][3], m[3][3]);
+
+                planes_[PLANE_LEFT]   = row3 + row0;
+                planes_[PLANE_RIGHT]  = row3 - row0;
+                planes_[PLANE_BOTTOM] = row3 + row1;
+                planes_[PLANE_TOP]    = row3 - row1;
+                planes_[PLANE_NEAR]   = row3 + row2;
+                planes_[PLANE_FAR]    = row3 - row2;
+
+                for (int plane = 0; plane < NUM_PLANES; ++plane)
+                    planes_[plane] /= glm::length(glm::vec3(planes_[plane]));
+
+                // SoA copy for the SIMD tests. The two padding planes (0, 0, 0, 1) accept everything
+                for (int plane = 0; plane < NUM_SOA_PLANES; ++plane)
+                {
+                    glm::vec4 p (plane < NUM_PLANES ? planes_[plane] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+                    plane_x_[plane]     = p.x;
+                    plane_y_[plane]     = p.y;
+                    plane_z_[plane]     = p.z;
+                    plane_w_[plane]     = p.w;
+                    plane_abs_x_[plane] = glm::abs(p.x);
+                    plane_abs_y_[plane] = glm::abs(p.y);
+                    plane_abs_z_[plane] = glm::abs(p.z);
+                }
+            }
+
+        public:
+            static const int NUM_SOA_PLANES = 8;
+
+            glm::vec4 planes_[NUM_PLANES];          //!< Inward-facing normalized planes
+            // Same planes as a structure of arrays (padded to 8 lanes)
+            glm::f32  plane_x_[NUM_SOA_PLANES];     //!< a coefficients
+            glm::f32  plane_y_[NUM_SOA_PLANES];     //!< b coefficients
+            glm::f32  plane_z_[NUM_SOA_PLANES];     //!< c coefficients
+            glm::f32  plane_w_[NUM_SOA_PLANES];     //!< d coefficients
+            glm::f32  plane_abs_x_[NUM_SOA_PLANES]; //!< |a|
+            glm::f32  plane_abs_y_[NUM_SOA_PLANES]; //!< |b|
+            glm::f32  plane_abs_z_[NUM_SOA_PLANES]; //!< |c|
+    };
+
+}   // end namespace JU
+
+#endif /* FRUSTUM_HPP_ */
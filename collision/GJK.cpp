@@ -0,0 +1,684 @@
+/*
+ * GJK.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "GJK.hpp"
+// Global includes
+#include <vector>       // std::vector
+#include <algorithm>    // std::max
+
+namespace JU
+{
+
+namespace
+{
+    const glm::uint32 GJK_MAX_ITERATIONS = 64;
+    const glm::uint32 EPA_MAX_ITERATIONS = 128;
+    const glm::f32    GJK_RELATIVE_TOLERANCE = 1e-6f;   //!< Stop when the distance improves less than this (relative)
+    const glm::f32    GJK_OVERLAP_TOLERANCE  = 1e-8f;   //!< Squared distance (relative to the size of the simplex) treated as touching
+    const glm::f32    EPA_TOLERANCE          = 1e-4f;   //!< Stop when the polytope grows less than this (relative)
+
+    /**
+     * @brief Vertex of the Minkowski difference A - B, with the points of A and B it comes from
+     */
+    struct SupportPoint
+    {
+        glm::vec3 w_;   //!< a_ - b_
+        glm::vec3 a_;   //!< Support point of A
+        glm::vec3 b_;   //!< Support point of B
+        glm::vec3 d_;   //!< Direction it is the support point of (kept in the GJKCache)
+    };
+
+    inline SupportPoint getSupport(const ConvexShape& a, const ConvexShape& b, const glm::vec3& direction)
+    {
+        SupportPoint point;
+        point.a_ = a.getSupport(direction);
+        point.b_ = b.getSupport(-direction);
+        point.w_ = point.a_ - point.b_;
+        point.d_ = direction;
+
+        return point;
+    }
+
+    /**
+     * @brief Simplex of up to 4 support points with the barycentric weights of its point closest to the origin
+     */
+    struct Simplex
+    {
+        SupportPoint points_[4];
+        glm::f32     weights_[4];
+        glm::uint32  size_;
+
+        void keep(glm::uint32 i0, glm::f32 w0)
+        {
+            points_[0] = points_[i0];
+            weights_[0] = w0;
+            size_ = 1;
+        }
+
+        void keep(glm::uint32 i0, glm::f32 w0, glm::uint32 i1, glm::f32 w1)
+        {
+            SupportPoint p1 = points_[i1];
+            points_[0] = points_[i0]; weights_[0] = w0;
+            points_[1] = p1;          weights_[1] = w1;
+            size_ = 2;
+        }
+
+        void keep(glm::uint32 i0, glm::f32 w0, glm::uint32 i1, glm::f32 w1, glm::uint32 i2, glm::f32 w2)
+        {
+            SupportPoint p0 = points_[i0], p1 = points_[i1], p2 = points_[i2];
+            points_[0] = p0; weights_[0] = w0;
+            points_[1] = p1; weights_[1] = w1;
+            points_[2] = p2; weights_[2] = w2;
+            size_ = 3;
+        }
+
+        glm::vec3 getPoint() const
+        {
+            glm::vec3 point (0.0f);
+            for (glm::uint32 i = 0; i < size_; ++i)
+                point += points_[i].w_ * weights_[i];
+            return point;
+        }
+
+        void getWitnessPoints(glm::vec3& point_a, glm::vec3& point_b) const
+        {
+            point_a = point_b = glm::vec3(0.0f);
+            for (glm::uint32 i = 0; i < size_; ++i)
+            {
+                point_a += points_[i].a_ * weights_[i];
+                point_b += points_[i].b_ * weights_[i];
+            }
+        }
+    };
+
+    void reduceSegment(Simplex& simplex, glm::uint32 ia, glm::uint32 ib)
+    {
+        const glm::vec3& a = simplex.points_[ia].w_;
+        glm::vec3 ab (simplex.points_[ib].w_ - a);
+
+        glm::f32 t = -glm::dot(a, ab);
+        if (t <= 0.0f)
+        {
+            simplex.keep(ia, 1.0f);
+            return;
+        }
+
+        glm::f32 denom = glm::dot(ab, ab);
+        if (t >= denom)
+        {
+            simplex.keep(ib, 1.0f);
+            return;
+        }
+
+        t /= denom;
+        simplex.keep(ia, 1.0f - t, ib, t);
+    }
+
+    /**
+     * @brief Reduce the simplex to the feature of triangle (ia, ib, ic) closest to the origin
+     *
+     * @detail Voronoi region tests (Ericson, Real-Time Collision Detection, 5.1.5)
+     */
+    void reduceTriangle(Simplex& simplex, glm::uint32 ia, glm::uint32 ib, glm::uint32 ic)
+    {
+        const glm::vec3& a = simplex.points_[ia].w_;
+        const glm::vec3& b = simplex.points_[ib].w_;
+        const glm::vec3& c = simplex.points_[ic].w_;
+        glm::vec3 ab (b - a);
+        glm::vec3 ac (c - a);
+
+        glm::f32 d1 = -glm::dot(ab, a);
+        glm::f32 d2 = -glm::dot(ac, a);
+        if (d1 <= 0.0f && d2 <= 0.0f)
+        {
+            simplex.keep(ia, 1.0f);
+            return;
+        }
+
+        glm::f32 d3 = -glm::dot(ab, b);
+        glm::f32 d4 = -glm::dot(ac, b);
+        if (d3 >= 0.0f && d4 <= d3)
+        {
+            simplex.keep(ib, 1.0f);
+            return;
+        }
+
+        glm::f32 vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+        {
+            glm::f32 v = d1 / (d1 - d3);
+            simplex.keep(ia, 1.0f - v, ib, v);
+            return;
+        }
+
+        glm::f32 d5 = -glm::dot(ab, c);
+        glm::f32 d6 = -glm::dot(ac, c);
+        if (d6 >= 0.0f && d5 <= d6)
+        {
+            simplex.keep(ic, 1.0f);
+            return;
+        }
+
+        glm::f32 vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+        {
+            glm::f32 w = d2 / (d2 - d6);
+            simplex.keep(ia, 1.0f - w, ic, w);
+            return;
+        }
+
+        glm::f32 va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+        {
+            glm::f32 w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            simplex.keep(ib, 1.0f - w, ic, w);
+            return;
+        }
+
+        glm::f32 denom = 1.0f / (va + vb + vc);
+        glm::f32 v = vb * denom;
+        glm::f32 w = vc * denom;
+        simplex.keep(ia, 1.0f - v - w, ib, v, ic, w);
+    }
+
+    // Is the origin on the other side of plane (a, b, c) than d?
+    inline bool isOriginOutsidePlane(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d)
+    {
+        glm::vec3 normal (glm::cross(b - a, c - a));
+        glm::vec3 ad (d - a);
+        glm::f32 sign_origin = -glm::dot(a, normal);
+        glm::f32 sign_d      = glm::dot(ad, normal);
+
+        // A degenerate tetrahedron (d on the plane, up to rounding) counts as outside so the face gets tested
+        if (sign_d * sign_d <= GJK_OVERLAP_TOLERANCE * glm::dot(normal, normal) * glm::dot(ad, ad))
+            return true;
+
+        return sign_origin * sign_d <= 0.0f;
+    }
+
+    /**
+     * @brief Reduce the tetrahedron to the face closest to the origin
+     *
+     * @return Is the origin inside the tetrahedron? (the simplex is then left untouched)
+     */
+    bool reduceTetrahedron(Simplex& simplex)
+    {
+        static const glm::uint32 FACES[4][4] = { {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0} };
+
+        Simplex  best;
+        glm::f32 best_sq_dist = 0.0f;
+        bool     outside = false;
+
+        for (int face = 0; face < 4; ++face)
+        {
+            const glm::uint32* f = FACES[face];
+
+            if (!isOriginOutsidePlane(simplex.points_[f[0]].w_, simplex.points_[f[1]].w_, simplex.points_[f[2]].w_, simplex.points_[f[3]].w_))
+                continue;
+
+            Simplex candidate (simplex);
+            reduceTriangle(candidate, f[0], f[1], f[2]);
+
+            glm::vec3 point (candidate.getPoint());
+            glm::f32  sq_dist = glm::dot(point, point);
+
+            if (!outside || sq_dist < best_sq_dist)
+            {
+                best         = candidate;
+                best_sq_dist = sq_dist;
+                outside      = true;
+            }
+        }
+
+        if (!outside)
+            return true;
+
+        simplex = best;
+
+        return false;
+    }
+
+    /**
+     * @brief Start the simplex from the support directions of the cached one (evaluated against the current poses)
+     *
+     * @return Does the rebuilt simplex enclose the origin? (the shapes overlap)
+     */
+    bool warmStartSimplex(const ConvexShape& a, const ConvexShape& b, const GJKCache& cache, Simplex& simplex)
+    {
+        simplex.size_ = 0;
+
+        for (glm::uint32 i = 0; i < cache.simplex_size_; ++i)
+        {
+            SupportPoint w = getSupport(a, b, cache.simplex_directions_[i]);
+
+            // Several old points can map to the same vertex after the shapes move
+            bool duplicate = false;
+            for (glm::uint32 j = 0; j < simplex.size_; ++j)
+                duplicate |= (simplex.points_[j].w_ == w.w_);
+
+            if (!duplicate)
+                simplex.points_[simplex.size_++] = w;
+        }
+
+        simplex.weights_[0] = 1.0f;
+
+        switch (simplex.size_)
+        {
+            case 2: reduceSegment(simplex, 0, 1);       break;
+            case 3: reduceTriangle(simplex, 0, 1, 2);   break;
+            case 4: return reduceTetrahedron(simplex);
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Remember the final simplex (and the search direction if the shapes are apart) for the next query
+     */
+    void updateCache(const Simplex& simplex, const glm::vec3& v, bool overlap, GJKCache* cache)
+    {
+        if (!cache)
+            return;
+
+        if (!overlap)
+            cache->direction_ = v;
+
+        for (glm::uint32 i = 0; i < simplex.size_; ++i)
+            cache->simplex_directions_[i] = simplex.points_[i].d_;
+
+        cache->simplex_size_ = simplex.size_;
+        cache->valid_        = true;
+    }
+
+    /**
+     * @brief Run GJK until the distance converges or the origin is found inside the simplex
+     *
+     * @return Do the shapes overlap (or touch)?
+     */
+    bool runGJK(const ConvexShape& a, const ConvexShape& b, Simplex& simplex, glm::uint32& iterations, GJKCache* cache)
+    {
+        bool overlap = false;
+        iterations   = 0;
+
+        if (cache && cache->valid_ && cache->simplex_size_ > 0)
+        {
+            overlap = warmStartSimplex(a, b, *cache, simplex);
+        }
+        else
+        {
+            glm::vec3 direction;
+            if (cache && cache->valid_)
+                direction = cache->direction_;
+            else
+                direction = a.getCenter() - b.getCenter();
+
+            if (glm::dot(direction, direction) == 0.0f)
+                direction = glm::vec3(1.0f, 0.0f, 0.0f);
+
+            simplex.points_[0]  = getSupport(a, b, -direction);
+            simplex.weights_[0] = 1.0f;
+            simplex.size_       = 1;
+        }
+
+        glm::vec3 v (simplex.getPoint());
+        glm::f32  max_sq_norm = 0.0f;
+        for (glm::uint32 i = 0; i < simplex.size_; ++i)
+            max_sq_norm = std::max(max_sq_norm, glm::dot(simplex.points_[i].w_, simplex.points_[i].w_));
+
+        for (iterations = 1; !overlap && iterations <= GJK_MAX_ITERATIONS; ++iterations)
+        {
+            glm::f32 sq_dist = glm::dot(v, v);
+
+            if (sq_dist <= GJK_OVERLAP_TOLERANCE * max_sq_norm)
+            {
+                overlap = true;
+                break;
+            }
+
+            SupportPoint w = getSupport(a, b, -v);
+
+            // No progress towards the origin: v is the closest point
+            if (sq_dist - glm::dot(v, w.w_) <= GJK_RELATIVE_TOLERANCE * sq_dist)
+                break;
+
+            bool duplicate = false;
+            for (glm::uint32 i = 0; i < simplex.size_; ++i)
+                duplicate |= (simplex.points_[i].w_ == w.w_);
+            if (duplicate)
+                break;
+
+            Simplex previous (simplex);
+
+            simplex.points_[simplex.size_++] = w;
+            max_sq_norm = std::max(max_sq_norm, glm::dot(w.w_, w.w_));
+
+            switch (simplex.size_)
+            {
+                case 2: reduceSegment(simplex, 0, 1);               break;
+                case 3: reduceTriangle(simplex, 0, 1, 2);           break;
+                case 4: overlap = reduceTetrahedron(simplex);       break;
+            }
+
+            if (overlap)
+                break;
+
+            glm::vec3 v_new (simplex.getPoint());
+
+            // Numerical stall (the distance should strictly decrease): keep the simplex v was computed from
+            if (glm::dot(v_new, v_new) >= sq_dist)
+            {
+                simplex = previous;
+                break;
+            }
+
+            v = v_new;
+        }
+
+        updateCache(simplex, v, overlap, cache);
+
+        return overlap;
+    }
+
+    /**
+     * @brief Grow a simplex that contains the origin into a tetrahedron (EPA needs a volume to start from)
+     */
+    bool blowUpSimplex(const ConvexShape& a, const ConvexShape& b, Simplex& simplex)
+    {
+        const glm::f32 EPSILON = 1e-6f;
+        static const glm::vec3 AXES[6] = { glm::vec3( 1.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f),
+                                           glm::vec3( 0.0f, 1.0f, 0.0f), glm::vec3( 0.0f,-1.0f, 0.0f),
+                                           glm::vec3( 0.0f, 0.0f, 1.0f), glm::vec3( 0.0f, 0.0f,-1.0f) };
+
+        if (simplex.size_ == 1)
+        {
+            for (int axis = 0; axis < 6 && simplex.size_ == 1; ++axis)
+            {
+                SupportPoint w = getSupport(a, b, AXES[axis]);
+                glm::vec3 d (w.w_ - simplex.points_[0].w_);
+
+                if (glm::dot(d, d) > EPSILON)
+                    simplex.points_[simplex.size_++] = w;
+            }
+        }
+
+        if (simplex.size_ == 2)
+        {
+            glm::vec3 line (simplex.points_[1].w_ - simplex.points_[0].w_);
+            glm::vec3 abs_line (glm::abs(line));
+            glm::vec3 axis = (abs_line.x < abs_line.y && abs_line.x < abs_line.z) ? glm::vec3(1.0f, 0.0f, 0.0f) :
+                             (abs_line.y < abs_line.z) ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 0.0f, 1.0f);
+            glm::vec3 u (glm::normalize(glm::cross(line, axis)));
+            glm::vec3 v (glm::normalize(glm::cross(line, u)));
+
+            // Six directions around the segment
+            const glm::f32 COS60 = 0.5f, SIN60 = 0.8660254f;
+            glm::vec3 directions[6] = { u, u * COS60 + v * SIN60, -u * COS60 + v * SIN60, -u, -u * COS60 - v * SIN60, u * COS60 - v * SIN60 };
+
+            for (int dir = 0; dir < 6 && simplex.size_ == 2; ++dir)
+            {
+                SupportPoint w = getSupport(a, b, directions[dir]);
+                glm::vec3 d (glm::cross(w.w_ - simplex.points_[0].w_, line));
+
+                if (glm::dot(d, d) > EPSILON * glm::dot(line, line))
+                    simplex.points_[simplex.size_++] = w;
+            }
+        }
+
+        if (simplex.size_ == 3)
+        {
+            glm::vec3 normal (glm::cross(simplex.points_[1].w_ - simplex.points_[0].w_, simplex.points_[2].w_ - simplex.points_[0].w_));
+            glm::f32  length = glm::length(normal);
+
+            if (length == 0.0f)
+                return false;
+
+            normal /= length;
+
+            SupportPoint w = getSupport(a, b, normal);
+            if (glm::abs(glm::dot(w.w_ - simplex.points_[0].w_, normal)) <= EPSILON)
+                w = getSupport(a, b, -normal);
+            if (glm::abs(glm::dot(w.w_ - simplex.points_[0].w_, normal)) <= EPSILON)
+                return false;
+
+            simplex.points_[simplex.size_++] = w;
+        }
+
+        return simplex.size_ == 4;
+    }
+
+    struct Face
+    {
+        glm::uint32 v_[3];      //!< Vertices (counter clockwise seen from outside)
+        glm::vec3   normal_;    //!< Outward unit normal
+        glm::f32    distance_;  //!< Distance from the origin to the plane of the face
+    };
+
+    inline bool makeFace(const std::vector<SupportPoint>& vertices, glm::uint32 i0, glm::uint32 i1, glm::uint32 i2, Face& face)
+    {
+        glm::vec3 normal (glm::cross(vertices[i1].w_ - vertices[i0].w_, vertices[i2].w_ - vertices[i0].w_));
+        glm::f32  length = glm::length(normal);
+
+        if (length < 1e-12f)
+            return false;
+
+        face.v_[0] = i0;
+        face.v_[1] = i1;
+        face.v_[2] = i2;
+        face.normal_   = normal / length;
+        face.distance_ = glm::dot(face.normal_, vertices[i0].w_);
+
+        return true;
+    }
+
+    /**
+     * @brief Expanding Polytope Algorithm: face of A - B closest to the origin, starting from a tetrahedron that
+     *        contains it
+     */
+    bool runEPA(const ConvexShape& a, const ConvexShape& b, const Simplex& simplex, Contact& contact)
+    {
+        std::vector<SupportPoint> vertices (simplex.points_, simplex.points_ + 4);
+        std::vector<Face> faces;
+        std::vector<std::pair<glm::uint32, glm::uint32> > edges;
+
+        // Wind the tetrahedron so all the normals point outwards
+        if (glm::dot(glm::cross(vertices[1].w_ - vertices[0].w_, vertices[2].w_ - vertices[0].w_), vertices[3].w_ - vertices[0].w_) > 0.0f)
+            std::swap(vertices[1], vertices[2]);
+
+        static const glm::uint32 TETRAHEDRON[4][3] = { {0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2} };
+        for (int f = 0; f < 4; ++f)
+        {
+            Face face;
+            if (!makeFace(vertices, TETRAHEDRON[f][0], TETRAHEDRON[f][1], TETRAHEDRON[f][2], face))
+                return false;
+            faces.push_back(face);
+        }
+
+        glm::uint32 closest = 0;
+
+        for (glm::uint32 iteration = 0; iteration < EPA_MAX_ITERATIONS; ++iteration)
+        {
+            closest = 0;
+            for (glm::uint32 f = 1; f < faces.size(); ++f)
+                if (faces[f].distance_ < faces[closest].distance_)
+                    closest = f;
+
+            const Face& face = faces[closest];
+            SupportPoint w = getSupport(a, b, face.normal_);
+            glm::f32 w_distance = glm::dot(w.w_, face.normal_);
+
+            if (w_distance - face.distance_ <= EPA_TOLERANCE * std::max(1.0f, w_distance))
+                break;
+
+            // Remove the faces the new vertex sees, keeping the edges of the hole (horizon)
+            glm::uint32 new_vertex = vertices.size();
+            vertices.push_back(w);
+            edges.clear();
+
+            for (glm::uint32 f = 0; f < faces.size(); )
+            {
+                if (glm::dot(faces[f].normal_, w.w_ - vertices[faces[f].v_[0]].w_) > 0.0f)
+                {
+                    for (int e = 0; e < 3; ++e)
+                    {
+                        std::pair<glm::uint32, glm::uint32> edge (faces[f].v_[e], faces[f].v_[(e + 1) % 3]);
+                        bool shared = false;
+
+                        // An edge shared by two removed faces is inside the hole
+                        for (glm::uint32 i = 0; i < edges.size(); ++i)
+                        {
+                            if (edges[i].first == edge.second && edges[i].second == edge.first)
+                            {
+                                edges[i] = edges.back();
+                                edges.pop_back();
+                                shared = true;
+                                break;
+                            }
+                        }
+
+                        if (!shared)
+                            edges.push_back(edge);
+                    }
+
+                    faces[f] = faces.back();
+                    faces.pop_back();
+                }
+                else
+                {
+                    ++f;
+                }
+            }
+
+            // Close the hole with faces to the new vertex
+            for (glm::uint32 e = 0; e < edges.size(); ++e)
+            {
+                Face new_face;
+                if (makeFace(vertices, edges[e].first, edges[e].second, new_vertex, new_face))
+                    faces.push_back(new_face);
+            }
+
+            if (faces.empty())
+                return false;
+        }
+
+        closest = 0;
+        for (glm::uint32 f = 1; f < faces.size(); ++f)
+            if (faces[f].distance_ < faces[closest].distance_)
+                closest = f;
+
+        const Face& face = faces[closest];
+
+        // Barycentric coordinates of the projection of the origin on the face
+        const SupportPoint& p0 = vertices[face.v_[0]];
+        const SupportPoint& p1 = vertices[face.v_[1]];
+        const SupportPoint& p2 = vertices[face.v_[2]];
+        glm::vec3 point (face.normal_ * face.distance_);
+
+        glm::vec3 n (glm::cross(p1.w_ - p0.w_, p2.w_ - p0.w_));
+        glm::f32  inv_area = 1.0f / glm::dot(n, n);
+        glm::f32  u = glm::dot(glm::cross(p2.w_ - p1.w_, point - p1.w_), n) * inv_area;
+        glm::f32  v = glm::dot(glm::cross(p0.w_ - p2.w_, point - p2.w_), n) * inv_area;
+        glm::f32  w = 1.0f - u - v;
+
+        contact.point_a_ = p0.a_ * u + p1.a_ * v + p2.a_ * w;
+        contact.point_b_ = p0.b_ * u + p1.b_ * v + p2.b_ * w;
+        contact.normal_  = face.normal_;
+        contact.depth_   = face.distance_;
+
+        return true;
+    }
+
+}   // end anonymous namespace
+
+
+
+/**
+* @brief Distance between two convex shapes (GJK)
+*
+* @param a      First shape
+* @param b      Second shape
+* @param result Distance and closest points (only if the shapes do not overlap)
+* @param cache  Search direction and simplex from the previous frame for this pair (optional; updated)
+*
+* @return Do the shapes overlap?
+*/
+bool computeDistance(const ConvexShape& a, const ConvexShape& b, DistanceResult& result, GJKCache* cache)
+{
+    Simplex simplex;
+
+    result.overlap_ = runGJK(a, b, simplex, result.iterations_, cache);
+
+    if (!result.overlap_)
+    {
+        simplex.getWitnessPoints(result.point_a_, result.point_b_);
+        result.distance_ = glm::length(result.point_a_ - result.point_b_);
+    }
+
+    return result.overlap_;
+}
+
+
+
+/**
+* @brief Do two convex shapes overlap?
+*
+* @param a     First shape
+* @param b     Second shape
+* @param cache Search direction and simplex from the previous frame for this pair (optional; updated)
+*
+* @return Do the shapes overlap?
+*/
+bool testConvexConvex(const ConvexShape& a, const ConvexShape& b, GJKCache* cache)
+{
+    DistanceResult result;
+
+    return computeDistance(a, b, result, cache);
+}
+
+
+
+/**
+* @brief Contact between two convex shapes (GJK, then EPA when they overlap)
+*
+* @param a       First shape
+* @param b       Second shape
+* @param contact Penetration depth, normal and deepest points (only if the shapes overlap)
+* @param cache   Search direction and simplex from the previous frame for this pair (optional; updated)
+*
+* @return Do the shapes overlap?
+*/
+bool computeContact(const ConvexShape& a, const ConvexShape& b, Contact& contact, GJKCache* cache)
+{
+    Simplex     simplex;
+    glm::uint32 iterations;
+
+    if (!runGJK(a, b, simplex, iterations, cache))
+        return false;
+
+    if (simplex.size_ < 4 && !blowUpSimplex(a, b, simplex))
+    {
+        // Flat Minkowski difference (e.g. touching faces of zero thickness): report a zero-depth contact
+        simplex.getWitnessPoints(contact.point_a_, contact.point_b_);
+        glm::vec3 axis (b.getCenter() - a.getCenter());
+        contact.normal_ = glm::dot(axis, axis) > 0.0f ? glm::normalize(axis) : glm::vec3(1.0f, 0.0f, 0.0f);
+        contact.depth_  = 0.0f;
+    }
+    else if (!runEPA(a, b, simplex, contact))
+    {
+        return false;
+    }
+
+    if (cache)
+    {
+        cache->direction_ = -contact.normal_;
+        cache->valid_     = true;
+    }
+
+    return true;
+}
+
+}   // end namespace JU
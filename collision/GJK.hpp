@@ -0,0 +1,65 @@
+/*
+ * GJK.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef GJK_HPP_
+#define GJK_HPP_
+
+// Local includes
+#include "ConvexShapes.hpp"     // ConvexShape
+// Global includes
+#include <glm/glm.hpp>          // vec3, f32, uint32
+
+namespace JU
+{
+    /**
+     * @brief Search direction and simplex kept between frames for a pair of shapes (warm start)
+     *
+     * @detail For resting contacts the closest features barely change from one frame to the next, so starting GJK from
+     *         the previous direction usually converges in one or two iterations. The support directions of the last
+     *         simplex are kept too: evaluated against the new poses they rebuild a simplex that, for a pair that still
+     *         overlaps, usually still encloses the origin, so the test ends without iterating.
+     */
+    struct GJKCache
+    {
+        GJKCache() : direction_(1.0f, 0.0f, 0.0f), simplex_size_(0), valid_(false) {}
+
+        glm::vec3   direction_;                 //!< Last direction from B to A (closest points or penetration axis)
+        glm::vec3   simplex_directions_[4];     //!< Support directions of the last simplex (re-evaluated next time)
+        glm::uint32 simplex_size_;              //!< Points in the last simplex (0: start from direction_)
+        bool        valid_;                     //!< Has the direction been set?
+    };
+
+    /**
+     * @brief Result of a distance query
+     */
+    struct DistanceResult
+    {
+        bool        overlap_;       //!< Do the shapes overlap? (the rest of the fields are only set if they do not)
+        glm::f32    distance_;      //!< Distance between the shapes
+        glm::vec3   point_a_;       //!< Closest point on A
+        glm::vec3   point_b_;       //!< Closest point on B
+        glm::uint32 iterations_;    //!< GJK iterations taken
+    };
+
+    /**
+     * @brief Contact between two overlapping shapes
+     */
+    struct Contact
+    {
+        glm::vec3 point_a_;     //!< Deepest point of A inside B
+        glm::vec3 point_b_;     //!< Deepest point of B inside A
+        glm::vec3 normal_;      //!< Unit normal from A to B (B has to move by depth_ * normal_ to separate)
+        glm::f32  depth_;       //!< Penetration depth
+    };
+
+    bool computeDistance(const ConvexShape& a, const ConvexShape& b, DistanceResult& result, GJKCache* cache = nullptr);
+    bool testConvexConvex(const ConvexShape& a, const ConvexShape& b, GJKCache* cache = nullptr);
+    bool computeContact(const ConvexShape& a, const ConvexShape& b, Contact& contact, GJKCache* cache = nullptr);
+
+}   // end namespace JU
+
+#endif /* GJK_HPP_ */
@@ -9,9 +9,14 @@
 #define INTERSECTION_HPP_
 
 // Local includes
-#include "Distance.hpp"     // sqDistPointBox
+#include "Distance.hpp"     // sqDistPointBox, sqDistPointOBB
+#include "Ray.hpp"          // Ray
+#include "Frustum.hpp"      // Frustum
 // Global includes
 #include <glm/glm.hpp>      // vec3
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>  // __m128
+#endif
 
 
 namespace JU
@@ -23,6 +28,244 @@ namespace JU
         return sqDist <= sphere.radius_ * sphere.radius_;
     }
 
+    inline bool testBoxBox(const BoundingBox& a, const BoundingBox& b)
+    {
+        // Separated along any of the axis?
+        if (a.pmax_.x < b.pmin_.x || a.pmin_.x > b.pmax_.x) return false;
+        if (a.pmax_.y < b.pmin_.y || a.pmin_.y > b.pmax_.y) return false;
+        if (a.pmax_.z < b.pmin_.z || a.pmin_.z > b.pmax_.z) return false;
+
+        return true;
+    }
+
+    inline bool testPointBox(const glm::vec3& point, const BoundingBox& box)
+    {
+        return    point.x >= box.pmin_.x && point.x <= box.pmax_.x
+               && point.y >= box.pmin_.y && point.y <= box.pmax_.y
+               && point.z >= box.pmin_.z && point.z <= box.pmax_.z;
+    }
+
+    /**
+     * @brief Ray vs box slab test
+     *
+     * @detail The entry and exit distances of the three slabs are intersected with min/max, so there
+     *         is no branch per axis. Infinite inverse directions (axis-parallel rays) are handled by IEEE rules.
+     *
+     * @param ray   Ray to test
+     * @param box   Box to test
+     * @param t_max Only hits closer than this (in units of the ray direction) are reported
+     * @param t     Entry distance along the ray (zero if the origin is inside the box)
+     *
+     * @return Does the ray hit the box in [0, t_max]?
+     */
+    inline bool testRayBox(const Ray& ray, const BoundingBox& box, glm::f32 t_max, glm::f32& t)
+    {
+        glm::vec3 t0 ((box.pmin_ - ray.origin_) * ray.inv_direction_);
+        glm::vec3 t1 ((box.pmax_ - ray.origin_) * ray.inv_direction_);
+
+        glm::vec3 t_near (glm::min(t0, t1));
+        glm::vec3 t_far  (glm::max(t0, t1));
+
+        glm::f32 t_enter = glm::max(glm::max(t_near.x, t_near.y), glm::max(t_near.z, 0.0f));
+        glm::f32 t_exit  = glm::min(glm::min(t_far.x,  t_far.y),  glm::min(t_far.z,  t_max));
+
+        t = t_enter;
+
+        return t_enter <= t_exit;
+    }
+
+    /**
+     * @brief Ray vs triangle test (Moller-Trumbore)
+     *
+     * @detail Both faces of the triangle are hit. (u, v) are the barycentric coordinates of the hit point
+     *         relative to v1 and v2: p = (1 - u - v) * v0 + u * v1 + v * v2
+     *
+     * @param ray   Ray to test
+     * @param v0    First vertex of the triangle
+     * @param v1    Second vertex of the triangle
+     * @param v2    Third vertex of the triangle
+     * @param t_max Only hits closer than this (in units of the ray direction) are reported
+     * @param t     Distance to the hit point
+     * @param u     Barycentric coordinate of the hit point
+     * @param v     Barycentric coordinate of the hit point
+     *
+     * @return Does the ray hit the triangle in [0, t_max]?
+     */
+    inline bool testRayTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+                                glm::f32 t_max, glm::f32& t, glm::f32& u, glm::f32& v)
+    {
+        const glm::f32 EPSILON = 1e-8f;
+
+        glm::vec3 edge1 (v1 - v0);
+        glm::vec3 edge2 (v2 - v0);
+        glm::vec3 pvec  (glm::cross(ray.direction_, edge2));
+        glm::f32  det = glm::dot(edge1, pvec);
+
+        // Ray parallel to the plane of the triangle
+        if (det > -EPSILON && det < EPSILON)
+            return false;
+
+        glm::f32  inv_det = 1.0f / det;
+        glm::vec3 tvec (ray.origin_ - v0);
+
+        u = glm::dot(tvec, pvec) * inv_det;
+        if (u < 0.0f || u > 1.0f)
+            return false;
+
+        glm::vec3 qvec (glm::cross(tvec, edge1));
+
+        v = glm::dot(ray.direction_, qvec) * inv_det;
+        if (v < 0.0f || u + v > 1.0f)
+            return false;
+
+        t = glm::dot(edge2, qvec) * inv_det;
+
+        return t >= 0.0f && t <= t_max;
+    }
+
+    inline bool testSphereOBB(const BoundingSphere& sphere, const BoundingOrientedBox& box)
+    {
+        return sqDistPointOBB(sphere.center_, box) <= sphere.radius_ * sphere.radius_;
+    }
+
+    /**
+     * @brief Oriented box vs oriented box test (Separating Axis Theorem)
+     *
+     * @detail Tests the 15 candidate separating axes: the 3 face normals of each box and the 9 cross products of their
+     *         edges. B is expressed in the frame of A, and an epsilon is added to the absolute rotation so the cross
+     *         products of nearly parallel edges (close to the zero vector) cannot report a false separation.
+     *         (Ericson, Real-Time Collision Detection, 4.4.1)
+     */
+    inline bool testOBBOBB(const BoundingOrientedBox& a, const BoundingOrientedBox& b)
+    {
+        const glm::f32 EPSILON = 1e-6f;
+
+        glm::f32 R[3][3], AbsR[3][3];
+        glm::f32 ra, rb;
+
+        // Rotation expressing B in the frame of A
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+            {
+                R[i][j]    = glm::dot(a.axis_[i], b.axis_[j]);
+                AbsR[i][j] = glm::abs(R[i][j]) + EPSILON;
+            }
+
+        // Translation in the frame of A
+        glm::vec3 d (b.center_ - a.center_);
+        glm::vec3 t (glm::dot(d, a.axis_[0]), glm::dot(d, a.axis_[1]), glm::dot(d, a.axis_[2]));
+
+        const glm::vec3& ea = a.half_extents_;
+        const glm::vec3& eb = b.half_extents_;
+
+        // Axes of A
+        for (int i = 0; i < 3; ++i)
+        {
+            ra = ea[i];
+            rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+            if (glm::abs(t[i]) > ra + rb)
+                return false;
+        }
+
+        // Axes of B
+        for (int j = 0; j < 3; ++j)
+        {
+            ra = ea[0] * AbsR[0][j] + ea[1] * AbsR[1][j] + ea[2] * AbsR[2][j];
+            rb = eb[j];
+            if (glm::abs(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > ra + rb)
+                return false;
+        }
+
+        // Cross products A_i x B_j
+        for (int i = 0; i < 3; ++i)
+        {
+            int i1 = (i + 1) % 3;
+            int i2 = (i + 2) % 3;
+
+            for (int j = 0; j < 3; ++j)
+            {
+                int j1 = (j + 1) % 3;
+                int j2 = (j + 2) % 3;
+
+                ra = ea[i1] * AbsR[i2][j] + ea[i2] * AbsR[i1][j];
+                rb = eb[j1] * AbsR[i][j2] + eb[j2] * AbsR[i][j1];
+                if (glm::abs(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > ra + rb)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool testOBBBox(const BoundingOrientedBox& obb, const BoundingBox& box)
+    {
+        // Cheap rejection with the axis-aligned box of the OBB before the full SAT
+        if (!testBoxBox(obb.getBoundingBox(), box))
+            return false;
+
+        return testOBBOBB(obb, BoundingOrientedBox(box.getCenter(), box.getExtents() * 0.5f));
+    }
+
+    /**
+     * @brief Conservative frustum vs box test
+     *
+     * @detail The box is rejected only if it lies completely outside one of the planes, i.e. the signed distance of its
+     *         center is smaller than minus its projected radius: dot(n, c) + d + dot(|n|, h) < 0. Some boxes near the
+     *         corners of the frustum are accepted even though they are outside. All six planes are tested at once
+     *         with SSE when available.
+     */
+    inline bool testFrustumBox(const Frustum& frustum, const BoundingBox& box)
+    {
+        glm::vec3 c ((box.pmin_ + box.pmax_) * 0.5f);
+        glm::vec3 h ((box.pmax_ - box.pmin_) * 0.5f);
+
+#if defined(__SSE__) || defined(_M_X64)
+        __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), cz = _mm_set1_ps(c.z);
+        __m128 hx = _mm_set1_ps(h.x), hy = _mm_set1_ps(h.y), hz = _mm_set1_ps(h.z);
+        __m128 zero = _mm_setzero_ps();
+        __m128 outside = zero;
+
+        for (int plane = 0; plane < Frustum::NUM_SOA_PLANES; plane += 4)
+        {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&frustum.plane_x_[plane]), cx),
+                                                _mm_mul_ps(_mm_loadu_ps(&frustum.plane_y_[plane]), cy)),
+                                     _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&frustum.plane_z_[plane]), cz),
+                                                _mm_loadu_ps(&frustum.plane_w_[plane])));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&frustum.plane_abs_x_[plane]), hx),
+                                                  _mm_mul_ps(_mm_loadu_ps(&frustum.plane_abs_y_[plane]), hy)),
+                                       _mm_mul_ps(_mm_loadu_ps(&frustum.plane_abs_z_[plane]), hz));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), zero));
+        }
+
+        return _mm_movemask_ps(outside) == 0;
+#else
+        for (int plane = 0; plane < Frustum::NUM_PLANES; ++plane)
+        {
+            glm::f32 dist   = frustum.plane_x_[plane] * c.x + frustum.plane_y_[plane] * c.y + frustum.plane_z_[plane] * c.z + frustum.plane_w_[plane];
+            glm::f32 radius = frustum.plane_abs_x_[plane] * h.x + frustum.plane_abs_y_[plane] * h.y + frustum.plane_abs_z_[plane] * h.z;
+
+            if (dist + radius < 0.0f)
+                return false;
+        }
+
+        return true;
+#endif
+    }
+
+    inline bool testFrustumSphere(const Frustum& frustum, const BoundingSphere& sphere)
+    {
+        for (int plane = 0; plane < Frustum::NUM_PLANES; ++plane)
+        {
+            const glm::vec4& p = frustum.planes_[plane];
+
+            if (p.x * sphere.center_.x + p.y * sphere.center_.y + p.z * sphere.center_.z + p.w < -sphere.radius_)
+                return false;
+        }
+
+        return true;
+    }
+
 } // namespace JU
 
 #endif /* INTERSECTION_HPP_ */
@@ -0,0 +1,452 @@
+/*
+ * LooseOctree.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "LooseOctree.hpp"
+#include "Intersection.hpp"     // testSphereBox, testBoxBox, testRayBox, testFrustumBox
+// Global includes
+#include <cmath>                // std::log2, std::floor
+#include <cstdio>               // std::printf
+
+namespace JU
+{
+
+// Deepest tree supported (it bounds the size of the traversal stack)
+static const glm::uint32 MAX_SUPPORTED_DEPTH = 16;
+
+
+
+/**
+* @brief Non-Default Constructor
+*
+* @param world_bounds Region covered by the tree. It is enlarged to a cube. Objects outside it are stored in the root.
+* @param max_depth    Maximum depth of the tree
+* @param looseness    Size of the loose cells relative to the regular ones (it must be greater than 1)
+*/
+LooseOctree::LooseOctree(const BoundingBox& world_bounds, glm::uint32 max_depth, glm::f32 looseness)
+    : max_depth_(max_depth), looseness_(looseness), free_objects_(INVALID_INDEX), num_objects_(0)
+{
+    if (max_depth_ > MAX_SUPPORTED_DEPTH)
+    {
+        std::printf("LooseOctree: max depth %u too big, using %u\n", max_depth_, MAX_SUPPORTED_DEPTH);
+        max_depth_ = MAX_SUPPORTED_DEPTH;
+    }
+
+    if (looseness_ <= 1.0f)
+    {
+        std::printf("LooseOctree: looseness %f must be greater than 1, using 2\n", looseness_);
+        looseness_ = 2.0f;
+    }
+
+    // Make the root cell a cube
+    glm::vec3 extents (world_bounds.getExtents());
+    glm::f32 half_size = 0.5f * glm::max(glm::max(extents.x, extents.y), extents.z);
+    glm::vec3 center (world_bounds.getCenter());
+    world_bounds_ = BoundingBox(center - glm::vec3(half_size), center + glm::vec3(half_size));
+
+    clear();
+}
+
+
+
+/**
+* @brief Destructor
+*/
+LooseOctree::~LooseOctree()
+{
+}
+
+
+
+/**
+* @brief Remove all the objects and nodes (but the root)
+*/
+void LooseOctree::clear()
+{
+    nodes_.clear();
+    free_blocks_.clear();
+    objects_.clear();
+    free_objects_ = INVALID_INDEX;
+    num_objects_  = 0;
+
+    Node root;
+    root.center_          = world_bounds_.getCenter();
+    root.half_size_       = 0.5f * world_bounds_.getExtents().x;
+    root.depth_           = 0;
+    root.parent_          = INVALID_INDEX;
+    root.children_        = INVALID_INDEX;
+    root.first_object_    = INVALID_INDEX;
+    root.subtree_objects_ = 0;
+    nodes_.push_back(root);
+}
+
+
+
+/**
+* @brief Insert a new object
+*
+* @param box Box of the object
+*
+* @return Id of the object
+*/
+glm::uint32 LooseOctree::insert(const BoundingBox& box)
+{
+    glm::uint32 object_id;
+
+    if (free_objects_ != INVALID_INDEX)
+    {
+        object_id = free_objects_;
+        free_objects_ = objects_[object_id].next_;
+    }
+    else
+    {
+        object_id = objects_.size();
+        objects_.push_back(Object());
+    }
+
+    objects_[object_id].box_ = box;
+    link(object_id, findNode(box));
+    ++num_objects_;
+
+    return object_id;
+}
+
+
+
+/**
+* @brief Remove an object (its id will be reused)
+*
+* @param object_id Id of the object
+*/
+void LooseOctree::remove(glm::uint32 object_id)
+{
+    unlink(object_id);
+
+    objects_[object_id].node_ = INVALID_INDEX;
+    objects_[object_id].next_ = free_objects_;
+    free_objects_ = object_id;
+    --num_objects_;
+}
+
+
+
+/**
+* @brief Move an object
+*
+* @detail If the center of the object is still in the cell of its node, and its size still maps to the same depth,
+*         only the box is updated. Otherwise it is relinked into the right node.
+*
+* @param object_id Id of the object
+* @param box       New box of the object
+*/
+void LooseOctree::update(glm::uint32 object_id, const BoundingBox& box)
+{
+    Object& object = objects_[object_id];
+    object.box_ = box;
+
+    const Node& node = nodes_[object.node_];
+    glm::vec3 offset (glm::abs(box.getCenter() - node.center_));
+
+    if (   offset.x <= node.half_size_ && offset.y <= node.half_size_ && offset.z <= node.half_size_
+        && getDepth(box) == node.depth_)
+        return;
+
+    unlink(object_id);
+    link(object_id, findNode(box));
+}
+
+
+
+/**
+* @brief Depth of the smallest nodes that can hold a box
+*
+* @detail An object whose center lies in a cell of side L fits in the loose cell if its size is at most (looseness - 1) * L
+*
+* @param box Box of the object
+*
+* @return Depth
+*/
+glm::uint32 LooseOctree::getDepth(const BoundingBox& box) const
+{
+    glm::vec3 extents (box.getExtents());
+    glm::f32 size = glm::max(glm::max(extents.x, extents.y), extents.z);
+
+    if (size <= 0.0f)
+        return max_depth_;
+
+    glm::f32 root_size = world_bounds_.getExtents().x;
+    glm::f32 depth = std::floor(std::log2((looseness_ - 1.0f) * root_size / size));
+
+    if (depth <= 0.0f)
+        return 0;
+
+    return glm::min(static_cast<glm::uint32>(depth), max_depth_);
+}
+
+
+
+/**
+* @brief Find (creating it if needed) the node that must hold a box
+*
+* @param box Box of the object
+*
+* @return Index of the node
+*/
+glm::uint32 LooseOctree::findNode(const BoundingBox& box)
+{
+    glm::vec3 center (box.getCenter());
+    glm::uint32 depth = getDepth(box);
+    glm::uint32 node_index = 0;
+
+    // Objects centered outside the world can only be held by the root
+    if (   center.x < world_bounds_.pmin_.x || center.x > world_bounds_.pmax_.x
+        || center.y < world_bounds_.pmin_.y || center.y > world_bounds_.pmax_.y
+        || center.z < world_bounds_.pmin_.z || center.z > world_bounds_.pmax_.z)
+        return node_index;
+
+    while (nodes_[node_index].depth_ < depth)
+    {
+        if (nodes_[node_index].children_ == INVALID_INDEX)
+            allocateChildren(node_index);
+
+        const Node& node = nodes_[node_index];
+        glm::uint32 child = (center.x >= node.center_.x ? 1 : 0)
+                          | (center.y >= node.center_.y ? 2 : 0)
+                          | (center.z >= node.center_.z ? 4 : 0);
+
+        node_index = node.children_ + child;
+    }
+
+    return node_index;
+}
+
+
+
+/**
+* @brief Allocate the block of 8 children of a node
+*
+* @param parent Index of the node
+*
+* @return Index of the first child
+*/
+glm::uint32 LooseOctree::allocateChildren(glm::uint32 parent)
+{
+    glm::uint32 block;
+
+    if (free_blocks_.size())
+    {
+        block = free_blocks_.back();
+        free_blocks_.pop_back();
+    }
+    else
+    {
+        block = nodes_.size();
+        nodes_.resize(nodes_.size() + 8);
+    }
+
+    const Node& node = nodes_[parent];
+    glm::f32 quarter = 0.5f * node.half_size_;
+
+    for (glm::uint32 child = 0; child < 8; ++child)
+    {
+        Node& child_node = nodes_[block + child];
+        child_node.center_          = node.center_ + glm::vec3(child & 1 ? quarter : -quarter,
+                                                               child & 2 ? quarter : -quarter,
+                                                               child & 4 ? quarter : -quarter);
+        child_node.half_size_       = quarter;
+        child_node.depth_           = node.depth_ + 1;
+        child_node.parent_          = parent;
+        child_node.children_        = INVALID_INDEX;
+        child_node.first_object_    = INVALID_INDEX;
+        child_node.subtree_objects_ = 0;
+    }
+
+    nodes_[parent].children_ = block;
+
+    return block;
+}
+
+
+
+/**
+* @brief Recycle the blocks of all the descendants of a node (they must be empty)
+*
+* @param node_index Index of the node
+*/
+void LooseOctree::releaseChildren(glm::uint32 node_index)
+{
+    glm::uint32 block = nodes_[node_index].children_;
+
+    if (block == INVALID_INDEX)
+        return;
+
+    for (glm::uint32 child = 0; child < 8; ++child)
+        releaseChildren(block + child);
+
+    free_blocks_.push_back(block);
+    nodes_[node_index].children_ = INVALID_INDEX;
+}
+
+
+
+/**
+* @brief Add an object to the list of a node
+*/
+void LooseOctree::link(glm::uint32 object_id, glm::uint32 node_index)
+{
+    Object& object = objects_[object_id];
+    Node& node = nodes_[node_index];
+
+    object.node_ = node_index;
+    object.prev_ = INVALID_INDEX;
+    object.next_ = node.first_object_;
+    if (node.first_object_ != INVALID_INDEX)
+        objects_[node.first_object_].prev_ = object_id;
+    node.first_object_ = object_id;
+
+    for (glm::uint32 index = node_index; index != INVALID_INDEX; index = nodes_[index].parent_)
+        ++nodes_[index].subtree_objects_;
+}
+
+
+
+/**
+* @brief Remove an object from the list of its node, and recycle the subtrees left empty
+*/
+void LooseOctree::unlink(glm::uint32 object_id)
+{
+    Object& object = objects_[object_id];
+    glm::uint32 node_index = object.node_;
+
+    if (object.prev_ != INVALID_INDEX)
+        objects_[object.prev_].next_ = object.next_;
+    else
+        nodes_[node_index].first_object_ = object.next_;
+    if (object.next_ != INVALID_INDEX)
+        objects_[object.next_].prev_ = object.prev_;
+
+    for (glm::uint32 index = node_index; index != INVALID_INDEX; index = nodes_[index].parent_)
+        --nodes_[index].subtree_objects_;
+
+    // Find the highest empty ancestor and drop everything below it
+    glm::uint32 empty = node_index;
+    while (nodes_[empty].parent_ != INVALID_INDEX && nodes_[nodes_[empty].parent_].subtree_objects_ == 0)
+        empty = nodes_[empty].parent_;
+
+    if (nodes_[empty].subtree_objects_ == 0)
+        releaseChildren(empty);
+}
+
+
+
+BoundingBox LooseOctree::getLooseBox(const Node& node) const
+{
+    glm::vec3 half (node.half_size_ * looseness_);
+
+    return BoundingBox(node.center_ - half, node.center_ + half);
+}
+
+
+
+/**
+* @brief Generic depth-first traversal of the non-empty nodes
+*
+* @detail The root is never culled: it also holds the objects outside the world bounds or too large for its loose box.
+*
+* @param test    Predicate telling whether a box (of a loose cell or of an object) passes the query
+* @param objects List where the ids of the objects found are appended
+*/
+template <typename Test>
+void LooseOctree::traverse(const Test& test, ObjectList& objects) const
+{
+    glm::uint32 stack[8 * (MAX_SUPPORTED_DEPTH + 1)];
+    glm::uint32 stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size)
+    {
+        glm::uint32 node_index = stack[--stack_size];
+        const Node& node = nodes_[node_index];
+
+        if (!node.subtree_objects_ || (node_index != 0 && !test(getLooseBox(node))))
+            continue;
+
+        for (glm::uint32 object = node.first_object_; object != INVALID_INDEX; object = objects_[object].next_)
+            if (test(objects_[object].box_))
+                objects.push_back(object);
+
+        if (node.children_ != INVALID_INDEX)
+            for (glm::uint32 child = 0; child < 8; ++child)
+                if (nodes_[node.children_ + child].subtree_objects_)
+                    stack[stack_size++] = node.children_ + child;
+    }
+}
+
+
+
+/**
+* @brief Find all the objects whose box intersects a sphere
+*/
+void LooseOctree::query(const BoundingSphere& sphere, ObjectList& objects) const
+{
+    traverse([&sphere](const BoundingBox& box) { return testSphereBox(sphere, box); }, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box intersects a box
+*/
+void LooseOctree::query(const BoundingBox& box, ObjectList& objects) const
+{
+    traverse([&box](const BoundingBox& other) { return testBoxBox(box, other); }, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box is hit by a ray
+*
+* @param t_max Length of the segment to test (in units of the ray direction)
+*/
+void LooseOctree::query(const Ray& ray, glm::f32 t_max, ObjectList& objects) const
+{
+    traverse([&ray, t_max](const BoundingBox& box) { glm::f32 t; return testRayBox(ray, box, t_max, t); }, objects);
+}
+
+
+
+/**
+* @brief Find all the objects whose box is (conservatively) inside a frustum
+*/
+void LooseOctree::query(const Frustum& frustum, ObjectList& objects) const
+{
+    traverse([&frustum](const BoundingBox& box) { return testFrustumBox(frustum, box); }, objects);
+}
+
+
+
+const BoundingBox& LooseOctree::getObjectBox(glm::uint32 object_id) const
+{
+    return objects_[object_id].box_;
+}
+
+
+
+glm::uint32 LooseOctree::getNumObjects() const
+{
+    return num_objects_;
+}
+
+
+
+glm::uint32 LooseOctree::getNumNodes() const
+{
+    return nodes_.size() - 8 * free_blocks_.size();
+}
+
+}   // end namespace JU
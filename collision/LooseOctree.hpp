@@ -0,0 +1,106 @@
+/*
+ * LooseOctree.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef LOOSEOCTREE_HPP_
+#define LOOSEOCTREE_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingBox, BoundingSphere
+#include "Ray.hpp"              // Ray
+#include "Frustum.hpp"          // Frustum
+// Global includes
+#include <glm/glm.hpp>          // vec3, f32, uint32
+#include <vector>               // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Loose octree of BoundingBox objects
+     *
+     * @detail Each node covers its regular octree cell enlarged by a 'looseness' factor (2 by default), so an object
+     *         can always be stored in the node whose cell contains its center, at the depth given by its size only.
+     *         That makes insertion O(depth) and lets most moving objects stay in the same node.
+     *
+     *         All the nodes live in one pool and the 8 children of a node are allocated as one contiguous block.
+     *         Blocks of empty subtrees are recycled. The objects of a node are kept in an intrusive linked list,
+     *         so there are no per-node allocations.
+     *
+     *         All queries append the ids of the objects found to the given list (they do not clear it).
+     */
+    class LooseOctree
+    {
+        public:
+            typedef std::vector<glm::uint32> ObjectList;
+
+        public:
+            LooseOctree(const BoundingBox& world_bounds, glm::uint32 max_depth = 8, glm::f32 looseness = 2.0f);
+            virtual ~LooseOctree();
+
+            // Objects
+            glm::uint32 insert(const BoundingBox& box);
+            void remove(glm::uint32 object_id);
+            void update(glm::uint32 object_id, const BoundingBox& box);
+            void clear();
+
+            // Queries
+            void query(const BoundingSphere& sphere, ObjectList& objects) const;
+            void query(const BoundingBox& box, ObjectList& objects) const;
+            void query(const Ray& ray, glm::f32 t_max, ObjectList& objects) const;
+            void query(const Frustum& frustum, ObjectList& objects) const;
+
+            // Getters
+            const BoundingBox& getObjectBox(glm::uint32 object_id) const;
+            glm::uint32 getNumObjects() const;
+            glm::uint32 getNumNodes() const;
+
+        private:
+            struct Node
+            {
+                glm::vec3   center_;            //!< Center of the cell
+                glm::f32    half_size_;         //!< Half the side of the (tight) cell
+                glm::uint32 depth_;             //!< Depth in the tree (the root is 0)
+                glm::uint32 parent_;            //!< Parent node
+                glm::uint32 children_;          //!< First of the 8 contiguous children (INVALID_INDEX if none)
+                glm::uint32 first_object_;      //!< Head of the linked list of objects in this node
+                glm::uint32 subtree_objects_;   //!< Objects in this node and all its descendants
+            };
+
+            struct Object
+            {
+                BoundingBox box_;               //!< Box of the object
+                glm::uint32 node_;              //!< Node holding the object (INVALID_INDEX if the id is free)
+                glm::uint32 prev_;              //!< Previous object in the node list
+                glm::uint32 next_;              //!< Next object in the node list (or next free id)
+            };
+
+            static const glm::uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+        private:
+            glm::uint32 getDepth(const BoundingBox& box) const;
+            glm::uint32 findNode(const BoundingBox& box);
+            glm::uint32 allocateChildren(glm::uint32 parent);
+            void releaseChildren(glm::uint32 node_index);
+            void link(glm::uint32 object_id, glm::uint32 node_index);
+            void unlink(glm::uint32 object_id);
+            BoundingBox getLooseBox(const Node& node) const;
+            template <typename Test>
+            void traverse(const Test& test, ObjectList& objects) const;
+
+        private:
+            BoundingBox              world_bounds_;     //!< Cell of the root
+            glm::uint32              max_depth_;        //!< Maximum depth of the tree
+            glm::f32                 looseness_;        //!< Loose cell size / tight cell size
+            std::vector<Node>        nodes_;            //!< Node pool (the root is the first one)
+            std::vector<glm::uint32> free_blocks_;      //!< Recycled blocks of 8 children
+            std::vector<Object>      objects_;          //!< Object pool
+            glm::uint32              free_objects_;     //!< Head of the list of free object ids
+            glm::uint32              num_objects_;      //!< Number of objects stored
+    };
+
+}   // end namespace JU
+
+#endif /* LOOSEOCTREE_HPP_ */
@@ -0,0 +1,34 @@
+/*
+ * Ray.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef RAY_HPP_
+#define RAY_HPP_
+
+#include <glm/glm.hpp>      // vec3, f32
+
+namespace JU
+{
+    /**
+     * @brief Ray class
+     *
+     * @detail The inverse of the direction is cached because the slab tests divide by it over and over
+     */
+    class Ray
+    {
+        public:
+            Ray(const glm::vec3& origin, const glm::vec3& direction)
+                : origin_(origin), direction_(direction), inv_direction_(1.0f / direction) {}
+
+        public:
+            glm::vec3 origin_;          //!< Origin of the ray
+            glm::vec3 direction_;       //!< Direction of the ray (not necessarily normalized)
+            glm::vec3 inv_direction_;   //!< Component-wise inverse of the direction
+    };
+
+}   // end namespace JU
+
+#endif /* RAY_HPP_ */
@@ -0,0 +1,291 @@
+/*
+ * SpatialHash.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "SpatialHash.hpp"
+// Global includes
+#include <cmath>        // std::floor
+#include <algorithm>    // std::max, std::min
+#include <thread>       // std::thread
+
+namespace JU
+{
+
+/**
+* @brief Constructor
+*
+* @param cell_size Side of a cell (about the diameter of the typical object)
+*/
+SpatialHash::SpatialHash(glm::f32 cell_size) : cell_size_(cell_size), inv_cell_size_(1.0f / cell_size), bucket_mask_(0), max_radius_(0.0f)
+{
+    bucket_start_.assign(2, 0);
+}
+
+
+
+/**
+* @brief Destructor
+*/
+SpatialHash::~SpatialHash()
+{
+}
+
+
+
+inline void SpatialHash::getCell(const glm::vec3& point, glm::int32 cell[3]) const
+{
+    cell[0] = static_cast<glm::int32>(std::floor(point.x * inv_cell_size_));
+    cell[1] = static_cast<glm::int32>(std::floor(point.y * inv_cell_size_));
+    cell[2] = static_cast<glm::int32>(std::floor(point.z * inv_cell_size_));
+}
+
+
+
+inline glm::uint32 SpatialHash::getBucket(glm::int32 x, glm::int32 y, glm::int32 z) const
+{
+    return ((glm::uint32)x * 73856093u ^ (glm::uint32)y * 19349663u ^ (glm::uint32)z * 83492791u) & bucket_mask_;
+}
+
+
+
+/**
+* @brief Rebuild the grid from scratch
+*
+* @param spheres     Bounding sphere of each object
+* @param num_threads Number of threads to split the rebuild across (the calling thread is one of them)
+*/
+void SpatialHash::build(const std::vector<BoundingSphere>& spheres, glm::uint32 num_threads)
+{
+    glm::uint32 num_objects = spheres.size();
+
+    // Power of two with about two buckets per object
+    glm::uint32 num_buckets = 1;
+    while (num_buckets < 2 * num_objects)
+        num_buckets <<= 1;
+    bucket_mask_ = num_buckets - 1;
+
+    // Not worth a thread for less than a few thousand objects
+    const glm::uint32 MIN_OBJECTS_PER_THREAD = 4096;
+    num_threads = std::max(1u, std::min(num_threads, num_objects / MIN_OBJECTS_PER_THREAD));
+
+    entries_.resize(num_objects);
+    object_entry_.resize(num_objects);
+    object_bucket_.resize(num_objects);
+    histograms_.assign(num_threads * num_buckets, 0);
+    bucket_start_.resize(num_buckets + 1);
+
+    std::vector<glm::uint32> range_begin(num_threads + 1);
+    for (glm::uint32 thread = 0; thread <= num_threads; ++thread)
+        range_begin[thread] = (glm::uint64)num_objects * thread / num_threads;
+
+    // Count the objects of each bucket (one histogram per thread)
+    if (num_threads > 1)
+    {
+        std::vector<std::thread> threads;
+        for (glm::uint32 thread = 1; thread < num_threads; ++thread)
+            threads.push_back(std::thread(&SpatialHash::countRange, this, std::cref(spheres), range_begin[thread], range_begin[thread + 1], &histograms_[thread * num_buckets]));
+        countRange(spheres, range_begin[0], range_begin[1], &histograms_[0]);
+        for (glm::uint32 thread = 0; thread < threads.size(); ++thread)
+            threads[thread].join();
+    }
+    else
+    {
+        countRange(spheres, 0, num_objects, &histograms_[0]);
+    }
+
+    // Exclusive prefix sum: the histograms become the first entry each thread writes to in each bucket
+    glm::uint32 offset = 0;
+    for (glm::uint32 bucket = 0; bucket < num_buckets; ++bucket)
+    {
+        bucket_start_[bucket] = offset;
+        for (glm::uint32 thread = 0; thread < num_threads; ++thread)
+        {
+            glm::uint32 count = histograms_[thread * num_buckets + bucket];
+            histograms_[thread * num_buckets + bucket] = offset;
+            offset += count;
+        }
+    }
+    bucket_start_[num_buckets] = offset;
+
+    // Scatter the objects to their entries (stable, so the order does not depend on the number of threads)
+    if (num_threads > 1)
+    {
+        std::vector<std::thread> threads;
+        for (glm::uint32 thread = 1; thread < num_threads; ++thread)
+            threads.push_back(std::thread(&SpatialHash::scatterRange, this, std::cref(spheres), range_begin[thread], range_begin[thread + 1], &histograms_[thread * num_buckets]));
+        scatterRange(spheres, range_begin[0], range_begin[1], &histograms_[0]);
+        for (glm::uint32 thread = 0; thread < threads.size(); ++thread)
+            threads[thread].join();
+    }
+    else
+    {
+        scatterRange(spheres, 0, num_objects, &histograms_[0]);
+    }
+
+    max_radius_ = 0.0f;
+    for (glm::uint32 object = 0; object < num_objects; ++object)
+        max_radius_ = std::max(max_radius_, spheres[object].radius_);
+}
+
+
+
+/**
+* @brief Remove all the objects
+*/
+void SpatialHash::clear()
+{
+    bucket_mask_ = 0;
+    max_radius_  = 0.0f;
+    bucket_start_.assign(2, 0);
+    entries_.clear();
+    object_entry_.clear();
+    object_bucket_.clear();
+}
+
+
+
+/**
+* @brief Counting pass of the rebuild for the objects in [begin, end)
+*/
+void SpatialHash::countRange(const std::vector<BoundingSphere>& spheres, glm::uint32 begin, glm::uint32 end, glm::uint32* histogram)
+{
+    glm::int32 cell[3];
+
+    for (glm::uint32 object = begin; object < end; ++object)
+    {
+        getCell(spheres[object].center_, cell);
+        glm::uint32 bucket = getBucket(cell[0], cell[1], cell[2]);
+
+        object_bucket_[object] = bucket;
+        ++histogram[bucket];
+    }
+}
+
+
+
+/**
+* @brief Scattering pass of the rebuild for the objects in [begin, end)
+*/
+void SpatialHash::scatterRange(const std::vector<BoundingSphere>& spheres, glm::uint32 begin, glm::uint32 end, glm::uint32* offsets)
+{
+    for (glm::uint32 object = begin; object < end; ++object)
+    {
+        glm::uint32 index = offsets[object_bucket_[object]]++;
+        Entry& entry = entries_[index];
+
+        entry.center_ = spheres[object].center_;
+        entry.radius_ = spheres[object].radius_;
+        entry.id_     = object;
+        getCell(entry.center_, entry.cell_);
+
+        object_entry_[object] = index;
+    }
+}
+
+
+
+/**
+* @brief Find the objects overlapping a sphere
+*
+* @param sphere  Query sphere
+* @param objects List the ids of the objects found are appended to
+*/
+void SpatialHash::query(const BoundingSphere& sphere, ObjectList& objects) const
+{
+    query(sphere, INVALID_ID, objects);
+}
+
+
+
+/**
+* @brief Find the objects overlapping a given object (not including itself)
+*
+* @param object_id Id of the object
+* @param objects   List the ids of the objects found are appended to
+*/
+void SpatialHash::queryNeighbours(glm::uint32 object_id, ObjectList& objects) const
+{
+    const Entry& entry = entries_[object_entry_[object_id]];
+
+    query(BoundingSphere(entry.center_, entry.radius_), object_id, objects);
+}
+
+
+
+void SpatialHash::query(const BoundingSphere& sphere, glm::uint32 exclude_id, ObjectList& objects) const
+{
+    if (entries_.empty())
+        return;
+
+    glm::f32 range = sphere.radius_ + max_radius_;
+    glm::int32 cell_min[3], cell_max[3];
+    getCell(sphere.center_ - glm::vec3(range), cell_min);
+    getCell(sphere.center_ + glm::vec3(range), cell_max);
+
+    glm::uint64 num_cells = (glm::uint64)(cell_max[0] - cell_min[0] + 1) *
+                            (glm::uint64)(cell_max[1] - cell_min[1] + 1) *
+                            (glm::uint64)(cell_max[2] - cell_min[2] + 1);
+
+    // Very large query: cheaper to scan every object than every cell
+    if (num_cells > entries_.size())
+    {
+        for (std::vector<Entry>::const_iterator iter = entries_.begin(); iter != entries_.end(); ++iter)
+        {
+            glm::vec3 d (iter->center_ - sphere.center_);
+            glm::f32  r = iter->radius_ + sphere.radius_;
+
+            if (iter->id_ != exclude_id && glm::dot(d, d) <= r * r)
+                objects.push_back(iter->id_);
+        }
+        return;
+    }
+
+    for (glm::int32 z = cell_min[2]; z <= cell_max[2]; ++z)
+        for (glm::int32 y = cell_min[1]; y <= cell_max[1]; ++y)
+            for (glm::int32 x = cell_min[0]; x <= cell_max[0]; ++x)
+            {
+                glm::uint32 bucket = getBucket(x, y, z);
+
+                for (glm::uint32 index = bucket_start_[bucket]; index < bucket_start_[bucket + 1]; ++index)
+                {
+                    const Entry& entry = entries_[index];
+
+                    // Other cells hashed to the same bucket are visited on their own turn
+                    if (entry.cell_[0] != x || entry.cell_[1] != y || entry.cell_[2] != z)
+                        continue;
+
+                    glm::vec3 d (entry.center_ - sphere.center_);
+                    glm::f32  r = entry.radius_ + sphere.radius_;
+
+                    if (entry.id_ != exclude_id && glm::dot(d, d) <= r * r)
+                        objects.push_back(entry.id_);
+                }
+            }
+}
+
+
+
+glm::f32 SpatialHash::getCellSize() const
+{
+    return cell_size_;
+}
+
+
+
+glm::uint32 SpatialHash::getNumObjects() const
+{
+    return entries_.size();
+}
+
+
+
+glm::uint32 SpatialHash::getNumBuckets() const
+{
+    return bucket_mask_ + 1;
+}
+
+}   // end namespace JU
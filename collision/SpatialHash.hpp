@@ -0,0 +1,91 @@
+/*
+ * SpatialHash.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef SPATIALHASH_HPP_
+#define SPATIALHASH_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingSphere
+// Global includes
+#include <glm/glm.hpp>          // vec3, f32, int32, uint32
+#include <vector>               // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Uniform grid of small spheres stored in a hash table (debris, projectiles, particles)
+     *
+     * @detail Each object is stored in the cell that contains its center, and cells are hashed into a table with about
+     *         two buckets per object. There is no incremental update: 'build' rebuilds everything from scratch with a
+     *         counting sort, so all the objects of a bucket are contiguous in one flat array. The counting and
+     *         scattering passes can be split across threads (each thread owns a contiguous range of objects and its
+     *         own histogram), and the result does not depend on the number of threads.
+     *
+     *         Queries look at the cells overlapping the query sphere enlarged by the largest object radius, so the
+     *         grid works best when the cell size is about the diameter of the typical object.
+     *
+     *         All queries append the ids of the objects found to the given list (they do not clear it). Object ids
+     *         are the indices in the vector given to 'build'.
+     */
+    class SpatialHash
+    {
+        public:
+            typedef std::vector<glm::uint32> ObjectList;
+
+        public:
+            SpatialHash(glm::f32 cell_size);
+            virtual ~SpatialHash();
+
+            // Construction
+            void build(const std::vector<BoundingSphere>& spheres, glm::uint32 num_threads = 1);
+            void clear();
+
+            // Queries
+            void query(const BoundingSphere& sphere, ObjectList& objects) const;
+            void queryNeighbours(glm::uint32 object_id, ObjectList& objects) const;
+
+            // Getters
+            glm::f32 getCellSize() const;
+            glm::uint32 getNumObjects() const;
+            glm::uint32 getNumBuckets() const;
+
+        private:
+            /**
+             * @brief Object as stored in the sorted array (everything a neighbour scan touches is in here)
+             */
+            struct Entry
+            {
+                glm::vec3   center_;    //!< Center of the sphere
+                glm::f32    radius_;    //!< Radius of the sphere
+                glm::int32  cell_[3];   //!< Cell coordinates (to filter out other cells hashed to the same bucket)
+                glm::uint32 id_;        //!< Object id
+            };
+
+            static const glm::uint32 INVALID_ID = 0xFFFFFFFF;
+
+        private:
+            inline void getCell(const glm::vec3& point, glm::int32 cell[3]) const;
+            inline glm::uint32 getBucket(glm::int32 x, glm::int32 y, glm::int32 z) const;
+            void countRange(const std::vector<BoundingSphere>& spheres, glm::uint32 begin, glm::uint32 end, glm::uint32* histogram);
+            void scatterRange(const std::vector<BoundingSphere>& spheres, glm::uint32 begin, glm::uint32 end, glm::uint32* offsets);
+            void query(const BoundingSphere& sphere, glm::uint32 exclude_id, ObjectList& objects) const;
+
+        private:
+            glm::f32                 cell_size_;        //!< Side of a cell
+            glm::f32                 inv_cell_size_;    //!< Inverse of the side of a cell
+            glm::uint32              bucket_mask_;      //!< Number of buckets minus one (the number of buckets is a power of two)
+            glm::f32                 max_radius_;       //!< Largest object radius (how much to enlarge the queries)
+            std::vector<glm::uint32> bucket_start_;     //!< First entry of each bucket (plus one extra for the end)
+            std::vector<Entry>       entries_;          //!< Objects sorted by bucket
+            std::vector<glm::uint32> object_entry_;     //!< Entry of each object id
+            std::vector<glm::uint32> object_bucket_;    //!< Bucket of each object id (scratch for the rebuild)
+            std::vector<glm::uint32> histograms_;       //!< One histogram per thread (scratch for the rebuild)
+    };
+
+}   // end namespace JU
+
+#endif /* SPATIALHASH_HPP_ */
@@ -0,0 +1,361 @@
+/*
+ * SweepAndPrune.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "SweepAndPrune.hpp"
+#include "Intersection.hpp"     // testBoxBox
+// Global includes
+#include <algorithm>            // std::remove_if
+#include <cstdio>               // std::printf
+
+namespace JU
+{
+
+/**
+* @brief Non-Default Constructor
+*
+* @param num_axis Number of axis to keep sorted: 1 (X only) or 3
+*/
+SweepAndPrune::SweepAndPrune(glm::uint32 num_axis) : num_axis_(num_axis), num_objects_(0), num_swaps_(0)
+{
+    if (num_axis_ != 1 && num_axis_ != 3)
+    {
+        std::printf("SweepAndPrune: %u axis not supported, using 3\n", num_axis_);
+        num_axis_ = 3;
+    }
+}
+
+
+
+/**
+* @brief Destructor
+*/
+SweepAndPrune::~SweepAndPrune()
+{
+}
+
+
+
+/**
+* @brief Add a new object
+*
+* @detail Its endpoints are appended to the lists and will be sorted into place (and its pairs reported) by the next update
+*
+* @param box Box of the object
+*
+* @return Id of the object
+*/
+glm::uint32 SweepAndPrune::addObject(const BoundingBox& box)
+{
+    glm::uint32 object_id;
+
+    if (free_ids_.size())
+    {
+        object_id = free_ids_.back();
+        free_ids_.pop_back();
+        boxes_[object_id] = box;
+        alive_[object_id] = true;
+    }
+    else
+    {
+        object_id = boxes_.size();
+        boxes_.push_back(box);
+        alive_.push_back(true);
+    }
+
+    for (glm::uint32 axis = 0; axis < num_axis_; ++axis)
+    {
+        Endpoint min_endpoint = { box.pmin_[axis], object_id << 1 };
+        Endpoint max_endpoint = { box.pmax_[axis], (object_id << 1) | 1 };
+        endpoints_[axis].push_back(min_endpoint);
+        endpoints_[axis].push_back(max_endpoint);
+    }
+
+    ++num_objects_;
+
+    return object_id;
+}
+
+
+
+/**
+* @brief Remove an object
+*
+* @detail All the pairs it was part of are reported as removed by the next update
+*
+* @param object_id Id of the object
+*/
+void SweepAndPrune::removeObject(glm::uint32 object_id)
+{
+    if (object_id >= alive_.size() || !alive_[object_id])
+        return;
+
+    alive_[object_id] = false;
+    removed_ids_.push_back(object_id);
+    --num_objects_;
+
+    for (PairSet::iterator iter = pairs_.begin(); iter != pairs_.end(); )
+    {
+        glm::uint32 a = static_cast<glm::uint32>(*iter >> 32);
+        glm::uint32 b = static_cast<glm::uint32>(*iter & 0xFFFFFFFF);
+
+        if (a == object_id || b == object_id)
+        {
+            recordChange(*iter, true);
+            iter = pairs_.erase(iter);
+        }
+        else
+            ++iter;
+    }
+}
+
+
+
+/**
+* @brief Set the new box of an object (it takes effect in the next update)
+*
+* @param object_id Id of the object
+* @param box       New box
+*/
+void SweepAndPrune::updateObject(glm::uint32 object_id, const BoundingBox& box)
+{
+    boxes_[object_id] = box;
+}
+
+
+
+/**
+* @brief Re-sort the endpoints and update the pair cache
+*
+* @param added   List where the pairs that started overlapping since the last update are appended
+* @param removed List where the pairs that stopped overlapping since the last update are appended
+*/
+void SweepAndPrune::update(PairList& added, PairList& removed)
+{
+    // Drop the endpoints of removed objects
+    if (removed_ids_.size())
+    {
+        const std::vector<bool>& alive = alive_;
+        for (glm::uint32 axis = 0; axis < num_axis_; ++axis)
+        {
+            EndpointList& endpoints = endpoints_[axis];
+            endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                           [&alive](const Endpoint& e) { return !alive[e.getObject()]; }),
+                            endpoints.end());
+        }
+
+        free_ids_.insert(free_ids_.end(), removed_ids_.begin(), removed_ids_.end());
+        removed_ids_.clear();
+    }
+
+    // Refresh the endpoint values from the boxes
+    for (glm::uint32 axis = 0; axis < num_axis_; ++axis)
+    {
+        EndpointList& endpoints = endpoints_[axis];
+        for (EndpointList::iterator iter = endpoints.begin(); iter != endpoints.end(); ++iter)
+        {
+            const BoundingBox& box = boxes_[iter->getObject()];
+            iter->value_ = iter->isMax() ? box.pmax_[axis] : box.pmin_[axis];
+        }
+    }
+
+    num_swaps_ = 0;
+
+    if (num_axis_ == 3)
+    {
+        for (glm::uint32 axis = 0; axis < 3; ++axis)
+            sortAxis(axis);
+    }
+    else
+    {
+        sortAxis(0);
+        sweepAxis();
+    }
+
+    // Report the net changes
+    for (PairChangeMap::const_iterator iter = changes_.begin(); iter != changes_.end(); ++iter)
+    {
+        bool is_overlapping = pairs_.count(iter->first) != 0;
+        if (is_overlapping == iter->second)
+            continue;
+
+        ObjectPair pair (static_cast<glm::uint32>(iter->first >> 32), static_cast<glm::uint32>(iter->first & 0xFFFFFFFF));
+        if (is_overlapping)
+            added.push_back(pair);
+        else
+            removed.push_back(pair);
+    }
+
+    changes_.clear();
+}
+
+
+
+/**
+* @brief Insertion sort of the endpoints along one axis
+*
+* @detail In three-axis mode every swap of a minimum and a maximum endpoint updates the pair cache
+*
+* @param axis Axis to sort
+*/
+void SweepAndPrune::sortAxis(glm::uint32 axis)
+{
+    EndpointList& endpoints = endpoints_[axis];
+    bool track_pairs = (num_axis_ == 3);
+
+    for (glm::uint32 index = 1; index < endpoints.size(); ++index)
+    {
+        Endpoint endpoint = endpoints[index];
+        glm::uint32 hole = index;
+
+        while (hole > 0 && endpoint < endpoints[hole - 1])
+        {
+            const Endpoint& other = endpoints[hole - 1];
+
+            if (track_pairs && endpoint.isMax() != other.isMax())
+            {
+                if (endpoint.isMax())
+                    // A maximum moved below a minimum: they stopped overlapping along this axis
+                    removePair(endpoint.getObject(), other.getObject());
+                else if (testBoxBox(boxes_[endpoint.getObject()], boxes_[other.getObject()]))
+                    // A minimum moved below a maximum: they may overlap now
+                    addPair(endpoint.getObject(), other.getObject());
+            }
+
+            endpoints[hole] = other;
+            --hole;
+            ++num_swaps_;
+        }
+
+        endpoints[hole] = endpoint;
+    }
+}
+
+
+
+/**
+* @brief Sweep the sorted X endpoints and rebuild the pair cache (one-axis mode)
+*/
+void SweepAndPrune::sweepAxis()
+{
+    const EndpointList& endpoints = endpoints_[0];
+    std::vector<glm::uint32> active;
+    PairSet pairs;
+    pairs.reserve(pairs_.size());
+
+    for (EndpointList::const_iterator iter = endpoints.begin(); iter != endpoints.end(); ++iter)
+    {
+        glm::uint32 object = iter->getObject();
+
+        if (iter->isMax())
+        {
+            // Swap-and-pop removal; the active list is short and unordered
+            for (glm::uint32 index = 0; index < active.size(); ++index)
+            {
+                if (active[index] == object)
+                {
+                    active[index] = active.back();
+                    active.pop_back();
+                    break;
+                }
+            }
+        }
+        else
+        {
+            const BoundingBox& box = boxes_[object];
+            for (std::vector<glm::uint32>::const_iterator other = active.begin(); other != active.end(); ++other)
+            {
+                const BoundingBox& other_box = boxes_[*other];
+                if (   box.pmax_.y >= other_box.pmin_.y && box.pmin_.y <= other_box.pmax_.y
+                    && box.pmax_.z >= other_box.pmin_.z && box.pmin_.z <= other_box.pmax_.z)
+                    pairs.insert(getPairKey(object, *other));
+            }
+            active.push_back(object);
+        }
+    }
+
+    // Diff against the previous cache
+    for (PairSet::const_iterator iter = pairs.begin(); iter != pairs.end(); ++iter)
+        if (!pairs_.count(*iter))
+            recordChange(*iter, false);
+    for (PairSet::const_iterator iter = pairs_.begin(); iter != pairs_.end(); ++iter)
+        if (!pairs.count(*iter))
+            recordChange(*iter, true);
+
+    pairs_.swap(pairs);
+}
+
+
+
+void SweepAndPrune::addPair(glm::uint32 a, glm::uint32 b)
+{
+    glm::uint64 key = getPairKey(a, b);
+
+    if (pairs_.insert(key).second)
+        recordChange(key, false);
+}
+
+
+
+void SweepAndPrune::removePair(glm::uint32 a, glm::uint32 b)
+{
+    glm::uint64 key = getPairKey(a, b);
+
+    if (pairs_.erase(key))
+        recordChange(key, true);
+}
+
+
+
+/**
+* @brief Remember the state of a pair before its first change since the last update
+*
+* @param key             Pair key
+* @param was_overlapping State of the pair before the change
+*/
+void SweepAndPrune::recordChange(glm::uint64 key, bool was_overlapping)
+{
+    changes_.insert(std::make_pair(key, was_overlapping));
+}
+
+
+
+/**
+* @brief Get all the pairs currently overlapping
+*
+* @param pairs List where the pairs are appended
+*/
+void SweepAndPrune::getPairs(PairList& pairs) const
+{
+    pairs.reserve(pairs.size() + pairs_.size());
+
+    for (PairSet::const_iterator iter = pairs_.begin(); iter != pairs_.end(); ++iter)
+        pairs.push_back(ObjectPair(static_cast<glm::uint32>(*iter >> 32), static_cast<glm::uint32>(*iter & 0xFFFFFFFF)));
+}
+
+
+
+glm::uint32 SweepAndPrune::getNumObjects() const
+{
+    return num_objects_;
+}
+
+
+
+glm::uint32 SweepAndPrune::getNumPairs() const
+{
+    return pairs_.size();
+}
+
+
+
+glm::uint32 SweepAndPrune::getNumSwaps() const
+{
+    return num_swaps_;
+}
+
+}   // end namespace JU
@@ -0,0 +1,108 @@
+/*
+ * SweepAndPrune.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef SWEEPANDPRUNE_HPP_
+#define SWEEPANDPRUNE_HPP_
+
+// Local includes
+#include "BoundingVolumes.hpp"  // BoundingBox
+// Global includes
+#include <glm/glm.hpp>          // f32, uint32
+#include <vector>               // std::vector
+#include <utility>              // std::pair
+#include <unordered_set>        // std::unordered_set
+#include <unordered_map>        // std::unordered_map
+
+namespace JU
+{
+    /**
+     * @brief Sort-and-sweep broadphase with a persistent pair cache
+     *
+     * @detail The endpoints of the boxes are kept sorted across frames and re-sorted with an insertion sort, which is
+     *         close to O(n) when objects move only a little each frame.
+     *
+     *         + With three axis every swap between a minimum and a maximum endpoint means that two objects start or
+     *           stop overlapping along that axis, so the pair cache is updated from the swaps alone: O(n + swaps).
+     *         + With one axis (X) the sorted list is swept after sorting and the resulting set is diffed against the
+     *           cache: O(n + overlapping pairs on X). Cheaper to maintain, better when objects are spread along X.
+     *
+     *         Every call to 'update' reports the pairs that started and stopped overlapping since the previous call.
+     */
+    class SweepAndPrune
+    {
+        public:
+            typedef std::pair<glm::uint32, glm::uint32> ObjectPair;     //!< Object ids, smallest first
+            typedef std::vector<ObjectPair>             PairList;
+
+        public:
+            explicit SweepAndPrune(glm::uint32 num_axis = 3);
+            virtual ~SweepAndPrune();
+
+            // Objects
+            glm::uint32 addObject(const BoundingBox& box);
+            void removeObject(glm::uint32 object_id);
+            void updateObject(glm::uint32 object_id, const BoundingBox& box);
+
+            // Broadphase
+            void update(PairList& added, PairList& removed);
+            void getPairs(PairList& pairs) const;
+
+            // Getters
+            glm::uint32 getNumObjects() const;
+            glm::uint32 getNumPairs() const;
+            glm::uint32 getNumSwaps() const;
+
+        private:
+            /**
+             * @brief Endpoint of a box along one axis
+             */
+            struct Endpoint
+            {
+                glm::f32    value_;     //!< Coordinate of the endpoint
+                glm::uint32 data_;      //!< Object id in the upper bits, 1 in the lowest bit for a maximum endpoint
+
+                inline glm::uint32 getObject() const { return data_ >> 1; }
+                inline bool        isMax()     const { return data_ & 1; }
+                // Minimum endpoints go first on ties so touching boxes are seen as overlapping
+                inline bool operator<(const Endpoint& rhs) const
+                {
+                    return value_ < rhs.value_ || (value_ == rhs.value_ && !isMax() && rhs.isMax());
+                }
+            };
+
+            typedef std::vector<Endpoint>                     EndpointList;
+            typedef std::unordered_set<glm::uint64>           PairSet;
+            typedef std::unordered_map<glm::uint64, bool>     PairChangeMap;
+
+        private:
+            static inline glm::uint64 getPairKey(glm::uint32 a, glm::uint32 b)
+            {
+                return a < b ? (static_cast<glm::uint64>(a) << 32) | b : (static_cast<glm::uint64>(b) << 32) | a;
+            }
+
+            void sortAxis(glm::uint32 axis);
+            void sweepAxis();
+            void addPair(glm::uint32 a, glm::uint32 b);
+            void removePair(glm::uint32 a, glm::uint32 b);
+            void recordChange(glm::uint64 key, bool was_overlapping);
+
+        private:
+            glm::uint32              num_axis_;         //!< Number of sorted axis (1 or 3)
+            EndpointList             endpoints_[3];     //!< Sorted endpoints along each axis
+            std::vector<BoundingBox> boxes_;            //!< Box of each object
+            std::vector<bool>        alive_;            //!< Is the object id in use?
+            std::vector<glm::uint32> free_ids_;         //!< Ids that can be reused
+            std::vector<glm::uint32> removed_ids_;      //!< Ids removed since the last update (their endpoints are still sorted)
+            glm::uint32              num_objects_;      //!< Number of objects alive
+            PairSet                  pairs_;            //!< Pairs of overlapping objects
+            PairChangeMap            changes_;          //!< Pairs touched since the last update, with their state before
+            glm::uint32              num_swaps_;        //!< Swaps performed by the last update (for profiling)
+    };
+
+}   // end namespace JU
+
+#endif /* SWEEPANDPRUNE_HPP_ */
@@ -0,0 +1,386 @@
+/*
+ * TriangleBVH.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "TriangleBVH.hpp"
+#include "Intersection.hpp"         // testRayBox, testRayTriangle
+// Global includes
+#include <algorithm>                // std::min
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>          // __m128
+    #define JU_PACKET_SSE 1
+#endif
+
+namespace JU
+{
+
+/**
+* @brief Default Constructor
+*/
+TriangleBVH::TriangleBVH()
+{
+}
+
+
+
+/**
+* @brief Destructor
+*/
+TriangleBVH::~TriangleBVH()
+{
+}
+
+
+
+/**
+* @brief Build the tree from an indexed triangle mesh
+*
+* @param positions Vertex positions
+* @param indices   Three indices into positions per triangle
+*/
+void TriangleBVH::build(const std::vector<glm::vec3>& positions, const std::vector<glm::uint32>& indices)
+{
+    std::vector<glm::vec3> vertices;
+    vertices.reserve(indices.size() - indices.size() % 3);
+
+    for (glm::uint32 index = 0; index + 2 < indices.size(); index += 3)
+    {
+        vertices.push_back(positions[indices[index + 0]]);
+        vertices.push_back(positions[indices[index + 1]]);
+        vertices.push_back(positions[indices[index + 2]]);
+    }
+
+    build(vertices);
+}
+
+
+
+/**
+* @brief Build the tree from a triangle soup
+*
+* @param vertices Three consecutive vertices per triangle
+*/
+void TriangleBVH::build(const std::vector<glm::vec3>& vertices)
+{
+    glm::uint32 num_triangles = vertices.size() / 3;
+
+    triangles_.resize(num_triangles);
+    std::vector<BoundingBox> boxes(num_triangles);
+
+    for (glm::uint32 index = 0; index < num_triangles; ++index)
+    {
+        Triangle& triangle = triangles_[index];
+        triangle.v0_ = vertices[3 * index + 0];
+        triangle.v1_ = vertices[3 * index + 1];
+        triangle.v2_ = vertices[3 * index + 2];
+
+        boxes[index] = BoundingBox(triangle.v0_, triangle.v0_);
+        boxes[index].merge(triangle.v1_);
+        boxes[index].merge(triangle.v2_);
+    }
+
+    bvh_.build(boxes);
+}
+
+
+
+/**
+* @brief Closest triangle hit by a ray
+*
+* @param ray   Ray in model coordinates
+* @param t_max Length of the segment to test (in units of the ray direction)
+* @param hit   Closest hit (only written if there is one)
+*
+* @return Was any triangle hit?
+*/
+bool TriangleBVH::raycast(const Ray& ray, glm::f32 t_max, RayHit& hit) const
+{
+    const std::vector<BVH::Node>&   nodes   = bvh_.getNodes();
+    const std::vector<glm::uint32>& indices = bvh_.getObjectIndices();
+
+    glm::f32 t_node;
+    if (nodes.empty() || !testRayBox(ray, nodes[0].box_, t_max, t_node))
+        return false;
+
+    bool found = false;
+    glm::f32 t_closest = t_max;
+
+    glm::uint32 stack[BVH::MAX_STACK_DEPTH];
+    glm::f32    stack_t[BVH::MAX_STACK_DEPTH];
+    glm::uint32 stack_size = 0;
+    stack[stack_size]     = 0;
+    stack_t[stack_size++] = t_node;
+
+    while (stack_size)
+    {
+        --stack_size;
+        if (stack_t[stack_size] > t_closest)
+            continue;
+
+        const BVH::Node& node = nodes[stack[stack_size]];
+
+        if (node.isLeaf())
+        {
+            for (glm::uint32 index = node.first_; index < node.first_ + node.count_; ++index)
+            {
+                const Triangle& triangle = triangles_[indices[index]];
+                glm::f32 t, u, v;
+
+                if (testRayTriangle(ray, triangle.v0_, triangle.v1_, triangle.v2_, t_closest, t, u, v))
+                {
+                    t_closest      = t;
+                    hit.t_         = t;
+                    hit.triangle_  = indices[index];
+                    hit.u_         = u;
+                    hit.v_         = v;
+                    found          = true;
+                }
+            }
+        }
+        else
+        {
+            glm::f32 t_left, t_right;
+            bool hit_left  = testRayBox(ray, nodes[node.first_].box_,     t_closest, t_left);
+            bool hit_right = testRayBox(ray, nodes[node.first_ + 1].box_, t_closest, t_right);
+
+            // Push the furthest child first so the closest one is popped first
+            if (hit_left && hit_right && t_left < t_right)
+            {
+                stack[stack_size] = node.first_ + 1; stack_t[stack_size++] = t_right;
+                stack[stack_size] = node.first_;     stack_t[stack_size++] = t_left;
+            }
+            else
+            {
+                if (hit_left)  { stack[stack_size] = node.first_;     stack_t[stack_size++] = t_left;  }
+                if (hit_right) { stack[stack_size] = node.first_ + 1; stack_t[stack_size++] = t_right; }
+            }
+        }
+    }
+
+    return found;
+}
+
+
+
+/**
+* @brief Is there any triangle between the origin of the ray and t_max? (line of sight)
+*
+* @detail Stops at the first hit found, whatever its distance
+*
+* @param ray   Ray in model coordinates
+* @param t_max Length of the segment to test (in units of the ray direction)
+*
+* @return Is the segment blocked?
+*/
+bool TriangleBVH::occluded(const Ray& ray, glm::f32 t_max) const
+{
+    const std::vector<BVH::Node>&   nodes   = bvh_.getNodes();
+    const std::vector<glm::uint32>& indices = bvh_.getObjectIndices();
+
+    if (nodes.empty())
+        return false;
+
+    glm::uint32 stack[BVH::MAX_STACK_DEPTH];
+    glm::uint32 stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size)
+    {
+        const BVH::Node& node = nodes[stack[--stack_size]];
+        glm::f32 t_node;
+
+        if (!testRayBox(ray, node.box_, t_max, t_node))
+            continue;
+
+        if (node.isLeaf())
+        {
+            for (glm::uint32 index = node.first_; index < node.first_ + node.count_; ++index)
+            {
+                const Triangle& triangle = triangles_[indices[index]];
+                glm::f32 t, u, v;
+
+                if (testRayTriangle(ray, triangle.v0_, triangle.v1_, triangle.v2_, t_max, t, u, v))
+                    return true;
+            }
+        }
+        else
+        {
+            stack[stack_size++] = node.first_ + 1;
+            stack[stack_size++] = node.first_;
+        }
+    }
+
+    return false;
+}
+
+
+
+/**
+* @brief Batched line of sight queries
+*
+* @detail The rays are processed in packets of PACKET_SIZE. Rays in a packet should be coherent (e.g. from the same
+*         origin towards nearby targets) so the packet visits roughly the same nodes.
+*
+* @param rays     Rays in model coordinates
+* @param t_max    Length of the segment to test for each ray
+* @param num_rays Number of rays
+* @param results  Is each segment blocked?
+*/
+void TriangleBVH::occluded(const Ray* rays, const glm::f32* t_max, glm::uint32 num_rays, bool* results) const
+{
+    for (glm::uint32 first = 0; first < num_rays; first += PACKET_SIZE)
+        occludedPacket(rays + first, t_max + first, std::min(PACKET_SIZE, num_rays - first), results + first);
+}
+
+
+
+#if JU_PACKET_SSE
+
+/**
+* @brief Line of sight queries for one packet of up to PACKET_SIZE rays
+*
+* @detail Inactive lanes (already blocked, or missing in the last packet) are masked out of every test
+*/
+void TriangleBVH::occludedPacket(const Ray* rays, const glm::f32* t_max, glm::uint32 num_rays, bool* results) const
+{
+    const std::vector<BVH::Node>&   nodes   = bvh_.getNodes();
+    const std::vector<glm::uint32>& indices = bvh_.getObjectIndices();
+
+    for (glm::uint32 lane = 0; lane < num_rays; ++lane)
+        results[lane] = false;
+
+    if (nodes.empty())
+        return;
+
+    // Transpose the packet to SoA (unused lanes replicate the first ray and start inactive)
+    float ox[4], oy[4], oz[4], dx[4], dy[4], dz[4], ix[4], iy[4], iz[4], tm[4];
+    for (glm::uint32 lane = 0; lane < PACKET_SIZE; ++lane)
+    {
+        const Ray& ray = rays[lane < num_rays ? lane : 0];
+        ox[lane] = ray.origin_.x;        oy[lane] = ray.origin_.y;        oz[lane] = ray.origin_.z;
+        dx[lane] = ray.direction_.x;     dy[lane] = ray.direction_.y;     dz[lane] = ray.direction_.z;
+        ix[lane] = ray.inv_direction_.x; iy[lane] = ray.inv_direction_.y; iz[lane] = ray.inv_direction_.z;
+        tm[lane] = t_max[lane < num_rays ? lane : 0];
+    }
+
+    __m128 o_x = _mm_loadu_ps(ox), o_y = _mm_loadu_ps(oy), o_z = _mm_loadu_ps(oz);
+    __m128 d_x = _mm_loadu_ps(dx), d_y = _mm_loadu_ps(dy), d_z = _mm_loadu_ps(dz);
+    __m128 i_x = _mm_loadu_ps(ix), i_y = _mm_loadu_ps(iy), i_z = _mm_loadu_ps(iz);
+    __m128 t_far_max = _mm_loadu_ps(tm);
+    __m128 zero = _mm_setzero_ps();
+    __m128 one  = _mm_set1_ps(1.0f);
+    __m128 eps  = _mm_set1_ps(1e-8f);
+    __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+    int active = (1 << num_rays) - 1;
+
+    glm::uint32 stack[BVH::MAX_STACK_DEPTH];
+    glm::uint32 stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size && active)
+    {
+        const BVH::Node& node = nodes[stack[--stack_size]];
+
+        // Slab test of the node box against the four rays
+        __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmin_.x), o_x), i_x);
+        __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmax_.x), o_x), i_x);
+        __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmin_.y), o_y), i_y);
+        __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmax_.y), o_y), i_y);
+        __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmin_.z), o_z), i_z);
+        __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.box_.pmax_.z), o_z), i_z);
+
+        __m128 t_enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)), _mm_max_ps(_mm_min_ps(t0z, t1z), zero));
+        __m128 t_exit  = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)), _mm_min_ps(_mm_max_ps(t0z, t1z), t_far_max));
+
+        if (!(_mm_movemask_ps(_mm_cmple_ps(t_enter, t_exit)) & active))
+            continue;
+
+        if (!node.isLeaf())
+        {
+            stack[stack_size++] = node.first_ + 1;
+            stack[stack_size++] = node.first_;
+            continue;
+        }
+
+        // Moller-Trumbore against the four rays
+        for (glm::uint32 index = node.first_; index < node.first_ + node.count_ && active; ++index)
+        {
+            const Triangle& triangle = triangles_[indices[index]];
+            glm::vec3 edge1 (triangle.v1_ - triangle.v0_);
+            glm::vec3 edge2 (triangle.v2_ - triangle.v0_);
+
+            __m128 e1x = _mm_set1_ps(edge1.x), e1y = _mm_set1_ps(edge1.y), e1z = _mm_set1_ps(edge1.z);
+            __m128 e2x = _mm_set1_ps(edge2.x), e2y = _mm_set1_ps(edge2.y), e2z = _mm_set1_ps(edge2.z);
+
+            // pvec = cross(direction, edge2)
+            __m128 px = _mm_sub_ps(_mm_mul_ps(d_y, e2z), _mm_mul_ps(d_z, e2y));
+            __m128 py = _mm_sub_ps(_mm_mul_ps(d_z, e2x), _mm_mul_ps(d_x, e2z));
+            __m128 pz = _mm_sub_ps(_mm_mul_ps(d_x, e2y), _mm_mul_ps(d_y, e2x));
+
+            __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            __m128 inv_det = _mm_div_ps(one, det);
+
+            // tvec = origin - v0
+            __m128 tx = _mm_sub_ps(o_x, _mm_set1_ps(triangle.v0_.x));
+            __m128 ty = _mm_sub_ps(o_y, _mm_set1_ps(triangle.v0_.y));
+            __m128 tz = _mm_sub_ps(o_z, _mm_set1_ps(triangle.v0_.z));
+
+            __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inv_det);
+
+            // qvec = cross(tvec, edge1)
+            __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+            __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+            __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+            __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d_x, qx), _mm_mul_ps(d_y, qy)), _mm_mul_ps(d_z, qz)), inv_det);
+            __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inv_det);
+
+            __m128 hit = _mm_cmpge_ps(_mm_andnot_ps(sign_mask, det), eps);
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(u, zero));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(u, one));
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(t, zero));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(t, t_far_max));
+
+            int hit_mask = _mm_movemask_ps(hit) & active;
+            for (glm::uint32 lane = 0; lane < num_rays; ++lane)
+                if (hit_mask & (1 << lane))
+                    results[lane] = true;
+
+            active &= ~hit_mask;
+        }
+    }
+}
+
+#else
+
+void TriangleBVH::occludedPacket(const Ray* rays, const glm::f32* t_max, glm::uint32 num_rays, bool* results) const
+{
+    for (glm::uint32 lane = 0; lane < num_rays; ++lane)
+        results[lane] = occluded(rays[lane], t_max[lane]);
+}
+
+#endif
+
+
+
+glm::uint32 TriangleBVH::getNumTriangles() const
+{
+    return triangles_.size();
+}
+
+
+
+const BVH& TriangleBVH::getBVH() const
+{
+    return bvh_;
+}
+
+}   // end namespace JU
@@ -0,0 +1,78 @@
+/*
+ * TriangleBVH.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef TRIANGLEBVH_HPP_
+#define TRIANGLEBVH_HPP_
+
+// Local includes
+#include "BVH.hpp"          // BVH
+#include "Ray.hpp"          // Ray
+// Global includes
+#include <glm/glm.hpp>      // vec3, f32, uint32
+#include <vector>           // std::vector
+
+namespace JU
+{
+    /**
+     * @brief Closest hit of a ray against a triangle mesh
+     */
+    struct RayHit
+    {
+        glm::f32    t_;         //!< Distance along the ray (in units of the ray direction)
+        glm::uint32 triangle_;  //!< Index of the triangle hit (same order as the triangles it was built from)
+        glm::f32    u_;         //!< Barycentric coordinate of the hit point (weight of the second vertex)
+        glm::f32    v_;         //!< Barycentric coordinate of the hit point (weight of the third vertex)
+    };
+
+    /**
+     * @brief Triangle BVH of a mesh for ray queries (picking, line of sight)
+     *
+     * @detail The triangles are copied in model coordinates, so rays must be transformed to model coordinates before
+     *         querying an instance of the mesh. The batched 'occluded' query traverses the tree with packets of
+     *         PACKET_SIZE rays, testing boxes and triangles against the whole packet with SSE.
+     */
+    class TriangleBVH
+    {
+        public:
+            static const glm::uint32 PACKET_SIZE = 4;
+
+        public:
+            TriangleBVH();
+            virtual ~TriangleBVH();
+
+            void build(const std::vector<glm::vec3>& positions, const std::vector<glm::uint32>& indices);
+            void build(const std::vector<glm::vec3>& vertices);
+
+            // Single rays
+            bool raycast(const Ray& ray, glm::f32 t_max, RayHit& hit) const;
+            bool occluded(const Ray& ray, glm::f32 t_max) const;
+
+            // Batched visibility
+            void occluded(const Ray* rays, const glm::f32* t_max, glm::uint32 num_rays, bool* results) const;
+
+            glm::uint32 getNumTriangles() const;
+            const BVH& getBVH() const;
+
+        private:
+            struct Triangle
+            {
+                glm::vec3 v0_;
+                glm::vec3 v1_;
+                glm::vec3 v2_;
+            };
+
+        private:
+            void occludedPacket(const Ray* rays, const glm::f32* t_max, glm::uint32 num_rays, bool* results) const;
+
+        private:
+            BVH                   bvh_;         //!< Tree over the boxes of the triangles
+            std::vector<Triangle> triangles_;   //!< Vertices of each triangle
+    };
+
+}   // end namespace JU
+
+#endif /* TRIANGLEBVH_HPP_ */
@@ -38,4 +38,15 @@ glm::mat4 CameraFirstPerson::getViewMatrix(void) const
     return getTransformFromParent();
 }
 
+
+/**
+* @brief View frustum of the camera
+*
+* @return Frustum with its planes in world coordinates
+*/
+Frustum CameraFirstPerson::getFrustum(void) const
+{
+    return Frustum(intrinsic_.getPerspectiveMatrix() * getViewMatrix());
+}
+
 } // namespace JU
@@ -10,6 +10,7 @@
 
 #include "CameraIntrinsic.hpp"      // CameraIntrinsic object contained
 #include "../core/Transform3D.hpp"     // Transform3D
+#include "../collision/Frustum.hpp"    // Frustum
 
 
 namespace JU
@@ -29,6 +30,7 @@ class CameraFirstPerson : public Transform3D
         // CameraInterface
         void update(const Transform3D &first_person);
         glm::mat4 getViewMatrix(void) const;
+        Frustum getFrustum(void) const;
 
     public:
         CameraIntrinsic intrinsic_;     //!< Intrinsic parameters of this camera
@@ -177,6 +177,17 @@ glm::mat4 CameraThirdPerson::getViewMatrix(void) const
 {
     return getTransformFromParent();
 }
+
+/**
+* @brief View frustum of the camera
+*
+* @return Frustum with its planes in world coordinates
+*/
+Frustum CameraThirdPerson::getFrustum(void) const
+{
+    return Frustum(intrinsic_.getPerspectiveMatrix() * getViewMatrix());
+}
+
 } // namespace JU
 
 
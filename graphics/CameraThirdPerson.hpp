@@ -11,6 +11,7 @@
 // Local includes
 #include "CameraIntrinsic.hpp"      // CamneraIntrinsic object contained
 #include "../core/Transform3D.hpp"     // Transform3D
+#include "../collision/Frustum.hpp"    // Frustum
 #include "../core/Defs.hpp"         // JU::f32
 
 // Global includes
@@ -40,6 +41,7 @@ class CameraThirdPerson : public Transform3D
         // CameraInterface
         void update(const Transform3D &object_3d);
         glm::mat4 getViewMatrix(void) const;
+        Frustum getFrustum(void) const;
 
         // Setters
         void update(const Transform3D &target, JU::f32 distance_delta, JU::f32 inclination_delta, JU::f32 azimuth_delta);
@@ -10,6 +10,7 @@
 
 #include <glm/glm.hpp>      // glm::mat4
 #include <vector>           // std::vector
+#include "RenderQueue.hpp"  // RenderQueue
 
 namespace JU
 {
@@ -20,7 +21,9 @@ class GLSLProgram;
 /**
  * @brief      Pure Virtual Class to draw objects
  *
- * @details    All derived classes will need to implement the 'draw' function
+ * @details    All derived classes will need to implement the 'draw' function. 'submit' queues the object in a
+ *             RenderQueue instead of drawing it right away; by default the queue just calls 'draw' in its turn, but
+ *             derived classes can submit items the queue knows how to batch (see GLMeshInstance).
  */
 class DrawInterface
 {
@@ -30,6 +33,13 @@ class DrawInterface
                           const glm::mat4 & model,
                           const glm::mat4 &view,
                           const glm::mat4 &projection) const = 0;
+
+        virtual void submit(RenderQueue &queue,
+                            const GLSLProgram &program,
+                            const glm::mat4 & model) const
+        {
+            queue.add(program, *this, model);
+        }
 };
 
 typedef std::vector<DrawInterface *> DrawList;
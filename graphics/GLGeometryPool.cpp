@@ -0,0 +1,418 @@
+/*
+ * GLGeometryPool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "GLGeometryPool.hpp"
+#include "GLMesh.hpp"           // GLMesh
+#include "GLSLProgram.hpp"      // static constants for attribute locations
+#include "GLStateCache.hpp"     // GLStateCache
+// Global includes
+#include <cstdio>               // std::printf
+
+namespace JU
+{
+
+namespace
+{
+    enum BufferIndex
+    {
+        VERTICES,
+        INDICES,
+        INSTANCE_IDS,
+        COMMANDS,
+        NUM_BUFFERS
+    };
+}
+
+
+
+/**
+* @brief Default constructor
+*/
+GLGeometryPool::GLGeometryPool() : is_initialized_(false), vao_handle_(0), num_instances_(0)
+{
+    for (JU::uint32 buffer = 0; buffer < NUM_BUFFERS; ++buffer)
+        vbo_handles_[buffer] = 0;
+}
+
+
+
+/**
+* @brief Destructor
+*/
+GLGeometryPool::~GLGeometryPool()
+{
+    release();
+}
+
+
+
+/**
+* @brief Create the buffers and the VAO
+*
+* @param layout       Layout of the vertices of all the meshes in the pool
+* @param max_vertices Capacity of the vertex buffer (in vertices)
+* @param max_indices  Capacity of the index buffer (in indices)
+*
+* @return Successful?
+*/
+bool GLGeometryPool::init(const VertexLayout& layout, JU::uint32 max_vertices, JU::uint32 max_indices)
+{
+    if (is_initialized_)
+        release();
+
+    layout_ = layout;
+
+    gl::GenVertexArrays(1, &vao_handle_);
+    GLStateCache::bindVertexArray(vao_handle_);
+
+    gl::GenBuffers(NUM_BUFFERS, vbo_handles_);
+
+    // VERTICES (uninitialized until each mesh uploads its range)
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[VERTICES]);
+    gl::BufferData(gl::ARRAY_BUFFER, static_cast<GLsizeiptr>(max_vertices) * layout_.getStride(), NULL, gl::STATIC_DRAW);
+    layout_.setAttribPointers();
+
+    // INSTANCE IDS: 0, 1, 2... one per instance (the draws of a batch start at their base instance)
+    std::vector<JU::uint32> instance_ids (MAX_BATCH_INSTANCES);
+    for (JU::uint32 instance = 0; instance < MAX_BATCH_INSTANCES; ++instance)
+        instance_ids[instance] = instance;
+
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[INSTANCE_IDS]);
+    gl::BufferData(gl::ARRAY_BUFFER, instance_ids.size() * sizeof(JU::uint32), &instance_ids[0], gl::STATIC_DRAW);
+    gl::VertexAttribIPointer(GLSLProgram::INSTANCE_ID_ATTRIBUTE_LOCATION, 1, gl::UNSIGNED_INT, 0, NULL);
+    gl::VertexAttribDivisor(GLSLProgram::INSTANCE_ID_ATTRIBUTE_LOCATION, 1);
+    gl::EnableVertexAttribArray(GLSLProgram::INSTANCE_ID_ATTRIBUTE_LOCATION);
+
+    // INDICES (the element buffer binding is part of the VAO)
+    GLStateCache::bindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[INDICES]);
+    gl::BufferData(gl::ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(max_indices) * sizeof(JU::uint32), NULL, gl::STATIC_DRAW);
+
+    GLStateCache::bindVertexArray(0);
+
+    vertex_allocator_.reset(max_vertices);
+    index_allocator_.reset(max_indices);
+    vCommands_.clear();
+    num_instances_ = 0;
+
+    is_initialized_ = true;
+
+    return true;
+}
+
+
+
+/**
+* @brief Release the buffers and the VAO
+*
+* @detail The meshes still in the pool are left pointing at deleted buffers: release them first.
+*/
+void GLGeometryPool::release()
+{
+    if (!is_initialized_)
+        return;
+
+    GLStateCache::deleteBuffers(NUM_BUFFERS, vbo_handles_);
+    GLStateCache::deleteVertexArrays(1, &vao_handle_);
+
+    for (JU::uint32 buffer = 0; buffer < NUM_BUFFERS; ++buffer)
+        vbo_handles_[buffer] = 0;
+    vao_handle_ = 0;
+
+    vCommands_.clear();
+    num_instances_ = 0;
+    is_initialized_ = false;
+}
+
+
+
+/**
+* @brief Reserve ranges of the vertex and index buffers
+*
+* @param num_vertices Number of vertices
+* @param num_indices  Number of indices
+* @param vertices     Range of the vertex buffer reserved
+* @param indices      Range of the index buffer reserved
+*
+* @return Successful? (false if the pool is out of space; nothing is reserved then)
+*/
+bool GLGeometryPool::allocate(JU::uint32 num_vertices, JU::uint32 num_indices, Range& vertices, Range& indices)
+{
+    JU::uint32 first_vertex, first_index;
+
+    if (!vertex_allocator_.allocate(num_vertices, first_vertex))
+    {
+        std::printf("Geometry pool is out of vertices (%i requested, %i free)\n", num_vertices, vertex_allocator_.getNumFree());
+        return false;
+    }
+
+    if (!index_allocator_.allocate(num_indices, first_index))
+    {
+        std::printf("Geometry pool is out of indices (%i requested, %i free)\n", num_indices, index_allocator_.getNumFree());
+        vertex_allocator_.free(Range(first_vertex, num_vertices));
+        return false;
+    }
+
+    vertices = Range(first_vertex, num_vertices);
+    indices  = Range(first_index, num_indices);
+
+    return true;
+}
+
+
+
+/**
+* @brief Give back ranges reserved with allocate
+*/
+void GLGeometryPool::free(const Range& vertices, const Range& indices)
+{
+    vertex_allocator_.free(vertices);
+    index_allocator_.free(indices);
+}
+
+
+
+/**
+* @brief Copy the vertices and indices of a mesh into its ranges
+*
+* @param vertices    Range of the vertex buffer
+* @param vertex_data Interleaved vertices (see VertexLayout::interleave)
+* @param indices     Range of the index buffer
+* @param index_data  Indices (relative to the first vertex of the range)
+*/
+void GLGeometryPool::upload(const Range& vertices, const JU::f32* vertex_data, const Range& indices, const JU::uint32* index_data)
+{
+    JU::uint32 stride = layout_.getStride();
+
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[VERTICES]);
+    gl::BufferSubData(gl::ARRAY_BUFFER, static_cast<GLintptr>(vertices.first_) * stride, static_cast<GLsizeiptr>(vertices.count_) * stride, vertex_data);
+
+    // Bound through the VAO so the binding of another VAO is left alone
+    GLStateCache::bindVertexArray(vao_handle_);
+    gl::BufferSubData(gl::ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(indices.first_) * sizeof(JU::uint32), static_cast<GLsizeiptr>(indices.count_) * sizeof(JU::uint32), index_data);
+}
+
+
+
+/**
+* @brief Bind the VAO of the pool
+*/
+void GLGeometryPool::bind() const
+{
+    GLStateCache::bindVertexArray(vao_handle_);
+}
+
+
+
+/**
+* @brief Draw a single mesh of the pool (the VAO must be bound)
+*/
+void GLGeometryPool::drawElements(const Range& vertices, const Range& indices) const
+{
+    gl::DrawElementsBaseVertex(gl::TRIANGLES, indices.count_, gl::UNSIGNED_INT, (GLubyte *)NULL + indices.first_ * sizeof(JU::uint32), vertices.first_);
+}
+
+
+
+/**
+* @brief Start collecting the draws of a new batch
+*/
+void GLGeometryPool::beginBatch()
+{
+    vCommands_.clear();
+    num_instances_ = 0;
+}
+
+
+
+/**
+* @brief Add a mesh of the pool to the current batch
+*
+* @param mesh           Mesh initialized in this pool
+* @param instance_count Number of instances of the mesh (numbered after the ones already in the batch)
+*
+* @return Successful? (false if the mesh is not in this pool or the batch is full)
+*/
+bool GLGeometryPool::addDraw(const GLMesh& mesh, JU::uint32 instance_count)
+{
+    if (mesh.getPool() != this)
+    {
+        std::printf("Mesh is not in this geometry pool\n");
+        return false;
+    }
+
+    if (num_instances_ + instance_count > MAX_BATCH_INSTANCES)
+        return false;
+
+    const Range& vertices = mesh.getVertexRange();
+    const Range& indices  = mesh.getIndexRange();
+
+    DrawElementsIndirectCommand command;
+    command.count_          = indices.count_;
+    command.instance_count_ = instance_count;
+    command.first_index_    = indices.first_;
+    command.base_vertex_    = vertices.first_;
+    command.base_instance_  = num_instances_;
+
+    vCommands_.push_back(command);
+    num_instances_ += instance_count;
+
+    return true;
+}
+
+
+
+/**
+* @brief Submit all the draws of the current batch
+*
+* @detail The commands are uploaded to the indirect buffer (orphaning its previous contents) and drawn with a single
+*         glMultiDrawElementsIndirect if ARB_multi_draw_indirect is loaded, or one glDrawElementsIndirect each
+*         otherwise. The batch is kept, so it can be drawn again (e.g. for another pass).
+*
+* @return Number of GL draw calls issued
+*/
+JU::uint32 GLGeometryPool::drawBatch()
+{
+    if (vCommands_.empty())
+        return 0;
+
+    GLsizeiptr size = vCommands_.size() * sizeof(DrawElementsIndirectCommand);
+
+    GLStateCache::bindVertexArray(vao_handle_);
+    GLStateCache::bindBuffer(gl::DRAW_INDIRECT_BUFFER, vbo_handles_[COMMANDS]);
+    gl::BufferData(gl::DRAW_INDIRECT_BUFFER, size, &vCommands_[0], gl::STREAM_DRAW);
+
+    JU::uint32 num_calls;
+
+    if (hasMultiDrawIndirect())
+    {
+        gl::MultiDrawElementsIndirect(gl::TRIANGLES, gl::UNSIGNED_INT, NULL, vCommands_.size(), 0);
+        num_calls = 1;
+    }
+    else
+    {
+        for (JU::uint32 command = 0; command < vCommands_.size(); ++command)
+            gl::DrawElementsIndirect(gl::TRIANGLES, gl::UNSIGNED_INT, (GLubyte *)NULL + command * sizeof(DrawElementsIndirectCommand));
+        num_calls = vCommands_.size();
+    }
+
+    GLStateCache::bindBuffer(gl::DRAW_INDIRECT_BUFFER, 0);
+
+    return num_calls;
+}
+
+
+
+const VertexLayout& GLGeometryPool::getVertexLayout() const
+{
+    return layout_;
+}
+
+
+
+JU::uint32 GLGeometryPool::getNumBatchDraws() const
+{
+    return vCommands_.size();
+}
+
+
+
+JU::uint32 GLGeometryPool::getNumBatchInstances() const
+{
+    return num_instances_;
+}
+
+
+
+/**
+* @brief Was ARB_multi_draw_indirect (core in GL 4.3) loaded with the rest of the functions?
+*/
+bool GLGeometryPool::hasMultiDrawIndirect()
+{
+    return gl::exts::var_ARB_multi_draw_indirect && gl::MultiDrawElementsIndirect;
+}
+
+
+
+void GLGeometryPool::RangeAllocator::reset(JU::uint32 capacity)
+{
+    vFree_.assign(1, Range(0, capacity));
+}
+
+
+
+/**
+* @brief Reserve the first free range big enough for 'count' elements
+*
+* @return Successful?
+*/
+bool GLGeometryPool::RangeAllocator::allocate(JU::uint32 count, JU::uint32& first)
+{
+    for (std::vector<Range>::iterator range = vFree_.begin(); range != vFree_.end(); ++range)
+    {
+        if (range->count_ < count)
+            continue;
+
+        first = range->first_;
+        range->first_ += count;
+        range->count_ -= count;
+
+        if (range->count_ == 0)
+            vFree_.erase(range);
+
+        return true;
+    }
+
+    return false;
+}
+
+
+
+/**
+* @brief Give back a range, merging it with the free ranges right before and after it
+*/
+void GLGeometryPool::RangeAllocator::free(const Range& range)
+{
+    if (range.count_ == 0)
+        return;
+
+    std::vector<Range>::iterator next = vFree_.begin();
+    while (next != vFree_.end() && next->first_ < range.first_)
+        ++next;
+
+    bool merge_previous = next != vFree_.begin() && (next - 1)->first_ + (next - 1)->count_ == range.first_;
+    bool merge_next     = next != vFree_.end() && range.first_ + range.count_ == next->first_;
+
+    if (merge_previous && merge_next)
+    {
+        (next - 1)->count_ += range.count_ + next->count_;
+        vFree_.erase(next);
+    }
+    else if (merge_previous)
+        (next - 1)->count_ += range.count_;
+    else if (merge_next)
+    {
+        next->first_  = range.first_;
+        next->count_ += range.count_;
+    }
+    else
+        vFree_.insert(next, range);
+}
+
+
+
+JU::uint32 GLGeometryPool::RangeAllocator::getNumFree() const
+{
+    JU::uint32 num_free = 0;
+
+    for (JU::uint32 range = 0; range < vFree_.size(); ++range)
+        num_free += vFree_[range].count_;
+
+    return num_free;
+}
+
+} /* namespace JU */
@@ -0,0 +1,120 @@
+/*
+ * GLGeometryPool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef GLGEOMETRYPOOL_HPP_
+#define GLGEOMETRYPOOL_HPP_
+
+// Local includes
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+#include "../core/Defs.hpp"     // uint32
+#include "VertexLayout.hpp"     // VertexLayout
+// Global includes
+#include <vector>               // std::vector
+
+namespace JU
+{
+
+// Forward declarations
+class GLMesh;
+
+/**
+ * @brief Shared vertex and index buffers that many GLMesh objects suballocate ranges from
+ *
+ * @details All the meshes in a pool have the same VertexLayout, so a single VAO describes them all: drawing any of them
+ *          needs no VAO or buffer switch, only the range of the mesh (its first index and base vertex). The indices
+ *          are 32 bit and relative to the first vertex of their mesh.
+ *
+ *          The batch functions collect a DrawElementsIndirect command per visible mesh and submit them all at once:
+ *          with a single glMultiDrawElementsIndirect if ARB_multi_draw_indirect is loaded, or one
+ *          glDrawElementsIndirect per command (still without any state change in between) otherwise. The instances
+ *          of a batch are numbered consecutively, and the number of each one is fed to the vertex shader in the
+ *          VertexInstanceID attribute (see GLSLProgram::INSTANCE_ID_ATTRIBUTE_LOCATION) so it can look up its own
+ *          data (e.g. its model matrix).
+ */
+class GLGeometryPool
+{
+    public:
+        static const JU::uint32 MAX_BATCH_INSTANCES = 65536;   //!< Instances a batch can number
+
+        /**
+         * @brief Range of vertices or indices in one of the buffers
+         */
+        struct Range
+        {
+            Range(JU::uint32 first = 0, JU::uint32 count = 0) : first_(first), count_(count) {}
+
+            JU::uint32 first_;
+            JU::uint32 count_;
+        };
+
+        /**
+         * @brief Layout GL expects in the indirect draw buffer
+         */
+        struct DrawElementsIndirectCommand
+        {
+            GLuint  count_;             //!< Number of indices
+            GLuint  instance_count_;
+            GLuint  first_index_;
+            GLint   base_vertex_;
+            GLuint  base_instance_;     //!< Number of the first instance in the batch
+        };
+
+    public:
+        GLGeometryPool();
+        ~GLGeometryPool();
+
+        bool init(const VertexLayout& layout, JU::uint32 max_vertices, JU::uint32 max_indices);
+        void release();
+
+        bool allocate(JU::uint32 num_vertices, JU::uint32 num_indices, Range& vertices, Range& indices);
+        void free(const Range& vertices, const Range& indices);
+        void upload(const Range& vertices, const JU::f32* vertex_data, const Range& indices, const JU::uint32* index_data);
+
+        void bind() const;
+        void drawElements(const Range& vertices, const Range& indices) const;
+
+        void beginBatch();
+        bool addDraw(const GLMesh& mesh, JU::uint32 instance_count = 1);
+        JU::uint32 drawBatch();
+
+        const VertexLayout& getVertexLayout() const;
+        JU::uint32 getNumBatchDraws() const;
+        JU::uint32 getNumBatchInstances() const;
+        static bool hasMultiDrawIndirect();
+
+    private:
+        /**
+         * @brief First-fit allocator of ranges of a buffer, merging the free ranges that touch
+         */
+        class RangeAllocator
+        {
+            public:
+                void reset(JU::uint32 capacity);
+                bool allocate(JU::uint32 count, JU::uint32& first);
+                void free(const Range& range);
+                JU::uint32 getNumFree() const;
+
+            private:
+                std::vector<Range> vFree_;   //!< Free ranges sorted by their first element
+        };
+
+        GLGeometryPool(const GLGeometryPool&);              // Non-copyable: it owns the GL objects
+        GLGeometryPool& operator=(const GLGeometryPool&);
+
+        bool                                        is_initialized_;
+        GLuint                                      vao_handle_;        //!< VAO of the pool
+        GLuint                                      vbo_handles_[4];    //!< Vertices, indices, instance ids, indirect commands
+        VertexLayout                                layout_;            //!< Layout of all the vertices in the pool
+        RangeAllocator                              vertex_allocator_;
+        RangeAllocator                              index_allocator_;
+        std::vector<DrawElementsIndirectCommand>    vCommands_;         //!< Commands of the current batch
+        JU::uint32                                  num_instances_;     //!< Instances in the current batch
+};
+
+} /* namespace JU */
+
+#endif /* GLGEOMETRYPOOL_HPP_ */
@@ -0,0 +1,185 @@
+/*
+ * GLInstanceBatch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "GLInstanceBatch.hpp"
+#include "GLMesh.hpp"               // GLMesh
+#include "GLMeshInstance.hpp"       // GLMeshInstance
+#include "GLSLProgram.hpp"          // GLSLProgram
+#include "GLSLProgramExt.hpp"       // VIEW_MATRIX_STRING, PROJECTION_MATRIX_STRING
+#include "TextureManager.hpp"       // unbindAllTextures
+#include "GLStateCache.hpp"         // GLStateCache
+#include "UniformBlockManager.hpp"  // UniformBlockManager
+// Global includes
+#include <glm/gtc/matrix_transform.hpp>     // glm::scale
+
+namespace JU
+{
+
+GLInstanceBatch::GLInstanceBatch() : vbo_handle_(0), vbo_capacity_(0), num_groups_(0), last_group_(0)
+{
+}
+
+
+
+GLInstanceBatch::~GLInstanceBatch()
+{
+    release();
+}
+
+
+
+/**
+* @brief Delete the instance VBO
+*/
+void GLInstanceBatch::release()
+{
+    if (vbo_handle_)
+        GLStateCache::deleteBuffers(1, &vbo_handle_);
+
+    vbo_handle_   = 0;
+    vbo_capacity_ = 0;
+}
+
+
+
+/**
+* @brief Start collecting the instances of a new batch
+*
+* @param view       View matrix
+* @param projection Projection matrix (both are also used to pick the level of detail of each instance)
+*/
+void GLInstanceBatch::begin(const glm::mat4& view, const glm::mat4& projection)
+{
+    view_       = view;
+    projection_ = projection;
+
+    if (UniformBlockManager::isInitialized())
+        UniformBlockManager::setCamera(view_, projection_);
+
+    for (JU::uint32 group = 0; group < num_groups_; ++group)
+        vGroups_[group].vModels_.clear();
+
+    num_groups_ = 0;
+    last_group_ = 0;
+}
+
+
+
+/**
+* @brief Add an instance to the batch
+*
+* @param instance   Instance to draw (it must outlive the batch: its material is bound on 'draw')
+* @param model      Model matrix (without the scale factors of the instance)
+*/
+void GLInstanceBatch::add(const GLMeshInstance& instance, const glm::mat4& model)
+{
+    JU::f32 x, y, z;
+    instance.getScale(x, y, z);
+
+    glm::mat4 new_model = glm::scale(model, glm::vec3(x, y, z));
+    const GLMesh* mesh  = instance.getMesh(instance.selectLOD(view_ * new_model, projection_));
+
+    JU::uint32 group = last_group_;
+
+    if (group >= num_groups_ || vGroups_[group].mesh_ != mesh || !vGroups_[group].instance_->hasSameMaterial(instance))
+    {
+        for (group = 0; group < num_groups_; ++group)
+            if (vGroups_[group].mesh_ == mesh && vGroups_[group].instance_->hasSameMaterial(instance))
+                break;
+
+        if (group == num_groups_)
+        {
+            if (num_groups_ == vGroups_.size())
+                vGroups_.push_back(Group());
+
+            vGroups_[group].mesh_     = mesh;
+            vGroups_[group].instance_ = &instance;
+            ++num_groups_;
+        }
+
+        last_group_ = group;
+    }
+
+    vGroups_[group].vModels_.push_back(new_model);
+}
+
+
+
+/**
+* @brief Draw all the instances of the batch
+*
+* @detail The model matrices are uploaded in a single BufferSubData (the VBO is orphaned first, so GL does not wait for
+*         the draws of the previous batch), then there is one DrawElementsInstanced per group.
+*
+* @param program Program in use
+*
+* @return Number of draw calls
+*/
+JU::uint32 GLInstanceBatch::draw(const GLSLProgram& program)
+{
+    if (num_groups_ == 0)
+        return 0;
+
+    vModels_.clear();
+    for (JU::uint32 group = 0; group < num_groups_; ++group)
+        vModels_.insert(vModels_.end(), vGroups_[group].vModels_.begin(), vGroups_[group].vModels_.end());
+
+    if (!vbo_handle_)
+        gl::GenBuffers(1, &vbo_handle_);
+
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handle_);
+
+    if (vModels_.size() > vbo_capacity_)
+        vbo_capacity_ = vModels_.size();
+
+    gl::BufferData(gl::ARRAY_BUFFER, vbo_capacity_ * sizeof(glm::mat4), NULL, gl::STREAM_DRAW);
+    gl::BufferSubData(gl::ARRAY_BUFFER, 0, vModels_.size() * sizeof(glm::mat4), &vModels_[0]);
+
+    // Programs that declare the camera block read the matrices set in 'begin'
+    if (!UniformBlockManager::isInitialized() || !program.hasUniformBlock(UniformBlockManager::CAMERA_BLOCK_STRING))
+    {
+        program.setUniform(GLSLProgramExt::VIEW_MATRIX_STRING, view_);
+        program.setUniform(GLSLProgramExt::PROJECTION_MATRIX_STRING, projection_);
+    }
+
+    JU::uint32 first_instance = 0;
+
+    for (JU::uint32 group = 0; group < num_groups_; ++group)
+    {
+        const Group& current = vGroups_[group];
+
+        current.instance_->bindMaterial(program);
+        current.mesh_->drawInstanced(vbo_handle_, first_instance, current.vModels_.size());
+        TextureManager::unbindAllTextures();
+
+        first_instance += current.vModels_.size();
+    }
+
+    return num_groups_;
+}
+
+
+
+JU::uint32 GLInstanceBatch::getNumGroups() const
+{
+    return num_groups_;
+}
+
+
+
+JU::uint32 GLInstanceBatch::getNumInstances() const
+{
+    JU::uint32 num_instances = 0;
+
+    for (JU::uint32 group = 0; group < num_groups_; ++group)
+        num_instances += vGroups_[group].vModels_.size();
+
+    return num_instances;
+}
+
+} /* namespace JU */
@@ -0,0 +1,79 @@
+/*
+ * GLInstanceBatch.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef GLINSTANCEBATCH_HPP_
+#define GLINSTANCEBATCH_HPP_
+
+// Local includes
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+#include "../core/Defs.hpp"     // uint32
+// Global includes
+#include <glm/glm.hpp>          // glm::mat4
+#include <vector>               // std::vector
+
+namespace JU
+{
+
+// Forward declarations
+class GLSLProgram;
+class GLMesh;
+class GLMeshInstance;
+
+/**
+ * @brief Draws many GLMeshInstance objects with one instanced draw call per mesh and material
+ *
+ * @details The instances added to a batch are grouped by the GLMesh of the level of detail they need and by their
+ *          material and textures (see GLMeshInstance::hasSameMaterial). On 'draw', the model matrices of all the
+ *          instances (scale factors included) are uploaded to a single instance VBO, and each group sets its material,
+ *          binds its textures and draws all its instances with a single DrawElementsInstanced.
+ *
+ *          The vertex shader gets the model matrix of the instance in the InstanceModelMatrix attribute (see
+ *          GLSLProgram::INSTANCE_MODEL_ATTRIBUTE_LOCATION) and the ViewMatrix and ProjectionMatrix uniforms, instead of
+ *          the per object matrix uniforms GLMeshInstance::draw sets.
+ */
+class GLInstanceBatch
+{
+    public:
+        GLInstanceBatch();
+        ~GLInstanceBatch();
+
+        void release();
+
+        void begin(const glm::mat4& view, const glm::mat4& projection);
+        void add(const GLMeshInstance& instance, const glm::mat4& model);
+        JU::uint32 draw(const GLSLProgram& program);
+
+        JU::uint32 getNumGroups() const;
+        JU::uint32 getNumInstances() const;
+
+    private:
+        /**
+         * @brief Instances that share a mesh and a material
+         */
+        struct Group
+        {
+            const GLMesh*           mesh_;
+            const GLMeshInstance*   instance_;      //!< First instance added (its material is the one of the group)
+            std::vector<glm::mat4>  vModels_;       //!< Model matrices of the instances
+        };
+
+        GLInstanceBatch(const GLInstanceBatch&);                // Non-copyable: it owns the instance VBO
+        GLInstanceBatch& operator=(const GLInstanceBatch&);
+
+        GLuint                  vbo_handle_;        //!< Model matrices of all the instances of the batch
+        GLuint                  vbo_capacity_;      //!< Matrices the VBO has room for
+        glm::mat4               view_;
+        glm::mat4               projection_;
+        std::vector<Group>      vGroups_;
+        JU::uint32              num_groups_;        //!< Groups in use (the rest keep their memory for the next batch)
+        JU::uint32              last_group_;        //!< Group of the last instance added (consecutive instances often share it)
+        std::vector<glm::mat4>  vModels_;           //!< Staging copy of all the model matrices, group after group
+};
+
+} /* namespace JU */
+
+#endif /* GLINSTANCEBATCH_HPP_ */
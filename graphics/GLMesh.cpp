@@ -9,19 +9,45 @@
 #include "GLMesh.hpp"
 #include "Mesh2.hpp"        // Mesh2
 #include "GLSLProgram.hpp"  // static constants for attribute locations
+#include "MeshOptimizer.hpp" // MeshOptimizer
+#include "MeshCache.hpp"    // MeshCache
+#include "GLStateCache.hpp" // GLStateCache
 // Global includes
 #include <iostream>         // std::cout, std::endl
+#include <cstdio>           // std::printf
 
 
 namespace JU
 {
 
+namespace
+{
+    /**
+    * @brief Narrow the triangle indices to 'IndexType' and upload them to the buffer bound to GL_ELEMENT_ARRAY_BUFFER
+    */
+    template <typename IndexType>
+    void uploadIndices(const VectorTriangleIndices& vTriangleIndices)
+    {
+        std::vector<IndexType> indices (vTriangleIndices.size() * 3);
+
+        for (JU::uint32 triangle = 0; triangle < vTriangleIndices.size(); ++triangle)
+        {
+            indices[triangle * 3 + 0] = static_cast<IndexType>(vTriangleIndices[triangle].v0_);
+            indices[triangle * 3 + 1] = static_cast<IndexType>(vTriangleIndices[triangle].v1_);
+            indices[triangle * 3 + 2] = static_cast<IndexType>(vTriangleIndices[triangle].v2_);
+        }
+
+        gl::BufferData(gl::ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(IndexType), indices.empty() ? NULL : &indices[0], gl::STATIC_DRAW);
+    }
+}
+
+
 /**
 * @brief Non-Default Constructor
 *
 * @param mesh Mesh2 object containing the data for this object
 */
-GLMesh::GLMesh() : is_initialized_(false), vao_handle_(0), vbo_handles_(nullptr), num_buffers_(0), num_triangles_(0)
+GLMesh::GLMesh() : is_initialized_(false), vao_handle_(0), vbo_handles_(nullptr), num_buffers_(0), num_triangles_(0), index_type_(gl::UNSIGNED_SHORT), pool_(nullptr)
 {
 }
 
@@ -40,14 +66,24 @@ GLMesh::~GLMesh()
 */
 void GLMesh::release()
 {
+    // Give the ranges back to the pool
+    if (pool_)
+    {
+        pool_->free(vertex_range_, index_range_);
+        pool_ = nullptr;
+    }
+
     // Delete the buffers
-    gl::DeleteBuffers(num_buffers_, vbo_handles_);
+    GLStateCache::deleteBuffers(num_buffers_, vbo_handles_);
     // Delete the vertex array
-    gl::DeleteVertexArrays(1, &vao_handle_);
+    GLStateCache::deleteVertexArrays(1, &vao_handle_);
     // Release the handles
     delete [] vbo_handles_;
 
+    vao_handle_  = 0;
+    vbo_handles_ = nullptr;
     num_buffers_ = num_triangles_ = 0;
+    vSubMeshes_.clear();
     is_initialized_ = false;
 }
 
@@ -55,202 +91,308 @@ void GLMesh::release()
 /**
 * @brief Create Vertex Buffer Object
 *
-* @detail If the data is not yet in a VBO, create and update the handle to it
+* @detail If the data is not yet in a VBO, create and update the handle to it. All the attributes the mesh has data
+*         for are uploaded.
+*
+* @param mesh     Mesh2 object
+* @param optimize Reorder the triangles and vertices for the GPU vertex caches before uploading them
 *
 * @return Successful?
 *
 * \todo Avoid duplicity of data by not duplicating vertices
 * \todo Warning, this assumes each face is a triangle
 */
-bool GLMesh::init(const Mesh2& mesh)
+bool GLMesh::init(const Mesh2& mesh, bool optimize)
+{
+    return init(mesh, VertexLayout::fromMesh(mesh), optimize);
+}
+
+
+/**
+* @brief Create Vertex Buffer Object with a subset of the attributes
+*
+* @param mesh   Mesh2 object
+* @param layout   Attributes to upload (the ones the mesh has no data for are dropped)
+* @param optimize Reorder the triangles and vertices for the GPU vertex caches before uploading them (see MeshOptimizer)
+*
+* @return Successful?
+*/
+bool GLMesh::init(const Mesh2& mesh, const VertexLayout& layout, bool optimize)
 {
     if (is_initialized_)
         release();
 
-    return initVBOs(mesh);
+    if (!optimize)
+        return initVBOs(mesh, layout);
+
+    Mesh2 optimized (mesh);
+    MeshOptimizer::optimize(optimized);
+
+    return initVBOs(optimized, layout);
 }
 
 
 /**
-* @brief Create Vertmesh.getTriangleIndices()ex Buffer Object
+* @brief Upload the mesh to ranges of a geometry pool instead of its own buffers
 *
-* @detail If the data is not yet in a VBO, create and update the handle to it
+* @param mesh     Mesh2 object (it must have data for all the attributes of the layout of the pool)
+* @param pool     Pool to suballocate the vertices and indices from
+* @param optimize Reorder the triangles and vertices for the GPU vertex caches before uploading them (see MeshOptimizer)
 *
-* @param name Id of the Mesh2
-* @param positions Vector with all vertex positions
-* @param normals Vector with all vertex normals
-* @param colors Vector with all vertex colors
-* @param tex_coords Vector with all vertex colors
-* @param faces Vector with all info about the faces of the Mesh2
+* @return Successful?
+*/
+bool GLMesh::init(const Mesh2& mesh, GLGeometryPool& pool, bool optimize)
+{
+    if (is_initialized_)
+        release();
 
+    if (!optimize)
+        return initPool(mesh, pool);
+
+    Mesh2 optimized (mesh);
+    MeshOptimizer::optimize(optimized);
+
+    return initPool(optimized, pool);
+}
+
+
+/**
+* @brief Create Vertex Buffer Objects from a mapped cache file
+*
+* @detail The blobs in the cache are already in the GPU layout, so they are uploaded straight from the mapped pages.
+*
+* @param cache Open MeshCache
+*
+* @return Successful?
+*/
+bool GLMesh::init(const MeshCache& cache)
+{
+    if (is_initialized_)
+        release();
+
+    if (!cache.isOpen())
+    {
+        std::printf("Mesh cache is not open\n");
+        return false;
+    }
+
+    const MeshCache::Header& header = cache.getHeader();
+
+    layout_ = VertexLayout(header.attributes_);
+
+    // Vertex VBO and index VBO
+    num_buffers_ = 2;
+
+    // Create and bind VAO
+    gl::GenVertexArrays(1, &vao_handle_);
+    GLStateCache::bindVertexArray(vao_handle_);
+
+    // Create Buffers
+    vbo_handles_ = new GLuint[num_buffers_];
+    gl::GenBuffers(num_buffers_, vbo_handles_);
+
+    // INTERLEAVED VERTICES
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
+    gl::BufferData(gl::ARRAY_BUFFER, header.num_vertices_ * header.stride_, cache.getVertices(), gl::STATIC_DRAW);
+    layout_.setAttribPointers();
+
+    // TRIANGLE INDICES
+    num_triangles_ = header.num_triangles_;
+
+    switch (header.index_size_)
+    {
+        case 1:  index_type_ = gl::UNSIGNED_BYTE;  break;
+        case 2:  index_type_ = gl::UNSIGNED_SHORT; break;
+        default: index_type_ = gl::UNSIGNED_INT;   break;
+    }
+
+    GLStateCache::bindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[1]);
+    gl::BufferData(gl::ELEMENT_ARRAY_BUFFER, num_triangles_ * 3 * header.index_size_, cache.getIndices(), gl::STATIC_DRAW);
+
+    vSubMeshes_ = cache.getSubMeshes();
+    is_initialized_ = true;
+
+    return true;
+}
+
+
+/**
+* @brief Create Vertex Buffer Objects
+*
+* @detail The vertices are expanded through the vertex indices of the mesh into one interleaved buffer (one packed
+*         vertex after another, see VertexLayout), so there is a single copy pass and a single VBO to bind for all
+*         the attributes. The triangle indices go to a second VBO.
+*
+* @param mesh   Mesh2 object
+* @param layout Attributes to upload (the ones the mesh has no data for are dropped)
+*
 * @return Successful?
 *
 * \todo Avoid duplicity of data by not duplicating vertices
 * \todo Warning, this assumes each face is a triangle
 */
-bool GLMesh::initVBOs(const Mesh2& mesh)
+bool GLMesh::initVBOs(const Mesh2& mesh, const VertexLayout& layout)
 {
     const std::string& name                       = mesh.getName();
-    const VectorPositions&       vPositions       = mesh.getPositions();
-    const VectorNormals&         vNormals         = mesh.getNormals();
-    const VectorTangents&        vTangents        = mesh.getTangents();
-    const VectorTexCoords&       vTexCoords       = mesh.getTexCoords();
-    const VectorVertexIndices&   vVertexIndices   = mesh.getVertexIndices();
     const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
 
-	// Attribute data sizes
-	const JU::uint8 POSITION_VECTOR_SIZE = 3;
-	const JU::uint8 NORMAL_VECTOR_SIZE 	 = 3;
-	const JU::uint8 TEX_VECTOR_SIZE      = 2;
-	const JU::uint8 TANGENT_VECTOR_SIZE  = 4;
-
-	// Compute number of VBOs needed
-	num_buffers_ = 0;
+    VertexLayout available (VertexLayout::fromMesh(mesh));
 
-    if (vPositions.size())
-        num_buffers_++;
-    else
+    if (!available.has(VertexLayout::POSITION))
     {
         std::printf("Mesh %s has no positions\n", name.c_str());
     }
-    if (vTriangleIndices.size())
-        num_buffers_++;
-    else
+    if (vTriangleIndices.empty())
     {
         std::printf("Mesh %s has no indices\n", name.c_str());
     }
-    if (vNormals.size())
-        num_buffers_++;
-    if (vTangents.size())
-        num_buffers_++;
-    if (vTexCoords.size())
-        num_buffers_++;
+    if (layout.getAttributes() & ~available.getAttributes())
+    {
+        std::printf("Mesh %s is missing some of the requested attributes (0x%x of 0x%x)\n", name.c_str(), available.getAttributes(), layout.getAttributes());
+    }
+
+    layout_ = VertexLayout(layout.getAttributes() & available.getAttributes());
+
+    // Vertex VBO and index VBO
+    num_buffers_ = 2;
 
     // Create and bind VAO
     gl::GenVertexArrays(1, &vao_handle_);
-    gl::BindVertexArray(vao_handle_);
+    GLStateCache::bindVertexArray(vao_handle_);
 
     // Create Buffers
     vbo_handles_ = new GLuint[num_buffers_];
     gl::GenBuffers(num_buffers_, vbo_handles_);
 
-    // The size of the VBOs must be equal to the number of unique vertices
-    JU::uint32 num_vertices = vVertexIndices.size();
+    // INTERLEAVED VERTICES
+    std::vector<JU::f32> vertices;
+    layout_.interleave(mesh, vertices);
+
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
+    gl::BufferData(gl::ARRAY_BUFFER, vertices.size() * sizeof(JU::f32), vertices.empty() ? NULL : &vertices[0], gl::STATIC_DRAW);
+    layout_.setAttribPointers();
 
-    JU::uint8 vbo_index = 0;
+    // TRIANGLE INDICES (the smallest type that can address all the vertices)
+    num_triangles_ = vTriangleIndices.size();
+    JU::uint32 num_vertices = mesh.getVertexIndices().size();
 
-    // VERTEX POSITIONS
-    if (vPositions.size())
+    GLStateCache::bindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[1]);
+
+    if (num_vertices <= 0xFF + 1)
+    {
+        index_type_ = gl::UNSIGNED_BYTE;
+        uploadIndices<JU::uint8>(vTriangleIndices);
+    }
+    else if (num_vertices <= 0xFFFF + 1)
+    {
+        index_type_ = gl::UNSIGNED_SHORT;
+        uploadIndices<JU::uint16>(vTriangleIndices);
+    }
+    else
     {
-        float *aPositions   = new float [num_vertices * POSITION_VECTOR_SIZE];
+        index_type_ = gl::UNSIGNED_INT;
+        uploadIndices<JU::uint32>(vTriangleIndices);
+    }
 
-        for (JU::uint32 index = 0; index < num_vertices; ++index)
-        {
-            aPositions[index * POSITION_VECTOR_SIZE + 0] = vPositions[vVertexIndices[index].position_].x;
-            aPositions[index * POSITION_VECTOR_SIZE + 1] = vPositions[vVertexIndices[index].position_].y;
-            aPositions[index * POSITION_VECTOR_SIZE + 2] = vPositions[vVertexIndices[index].position_].z;
-        }
+    vSubMeshes_ = mesh.getSubMeshes();
+    is_initialized_ = true;
+
+    return true;
+}
 
-        // Position VBO
-        gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[vbo_index]);
-        gl::BufferData(gl::ARRAY_BUFFER, num_vertices * POSITION_VECTOR_SIZE * sizeof(aPositions[0]), aPositions, gl::STATIC_DRAW);
-        gl::VertexAttribPointer(GLSLProgram::POSITION_ATTRIBUTE_LOCATION, POSITION_VECTOR_SIZE, gl::FLOAT, gl::FALSE_, 0, (GLubyte *)NULL);
-        gl::EnableVertexAttribArray(GLSLProgram::POSITION_ATTRIBUTE_LOCATION);   // Vertex positions
 
-        delete [] aPositions;
 
-        ++vbo_index;
-    }
+/**
+* @brief Copy the vertices and indices into ranges of a geometry pool
+*
+* @param mesh Mesh2 object
+* @param pool Pool to suballocate the vertices and indices from
+*
+* @return Successful? (false if the mesh lacks attributes of the pool or the pool is full)
+*/
+bool GLMesh::initPool(const Mesh2& mesh, GLGeometryPool& pool)
+{
+    const std::string& name                       = mesh.getName();
+    const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
+
+    layout_ = pool.getVertexLayout();
 
-    // VERTEX NORMALS
-    if (vNormals.size())
+    if (layout_.getAttributes() & ~VertexLayout::fromMesh(mesh).getAttributes())
     {
-        float *aNormals     = new float [num_vertices * NORMAL_VECTOR_SIZE];
+        std::printf("Mesh %s is missing some of the attributes of the geometry pool (0x%x of 0x%x)\n", name.c_str(), VertexLayout::fromMesh(mesh).getAttributes(), layout_.getAttributes());
+        return false;
+    }
 
-        for (JU::uint32 index = 0; index < num_vertices; ++index)
-        {
-            aNormals[index * NORMAL_VECTOR_SIZE + 0] = vNormals[vVertexIndices[index].normal_].x;
-            aNormals[index * NORMAL_VECTOR_SIZE + 1] = vNormals[vVertexIndices[index].normal_].y;
-            aNormals[index * NORMAL_VECTOR_SIZE + 2] = vNormals[vVertexIndices[index].normal_].z;
-        }
+    JU::uint32 num_vertices = mesh.getVertexIndices().size();
 
-        // Normal VBO
-        gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[vbo_index]);
-        gl::BufferData(gl::ARRAY_BUFFER, num_vertices * NORMAL_VECTOR_SIZE * sizeof(aNormals[0]), aNormals, gl::STATIC_DRAW);
-        gl::VertexAttribPointer(GLSLProgram::NORMAL_ATTRIBUTE_LOCATION, NORMAL_VECTOR_SIZE, gl::FLOAT, gl::FALSE_, 0, (GLubyte *)NULL);
-        gl::EnableVertexAttribArray(GLSLProgram::NORMAL_ATTRIBUTE_LOCATION);   // Vertex normals
+    if (!pool.allocate(num_vertices, vTriangleIndices.size() * 3, vertex_range_, index_range_))
+    {
+        std::printf("Mesh %s does not fit in the geometry pool\n", name.c_str());
+        return false;
+    }
 
-        delete [] aNormals;
+    std::vector<JU::f32> vertices;
+    layout_.interleave(mesh, vertices);
 
-        ++vbo_index;
+    std::vector<JU::uint32> indices (vTriangleIndices.size() * 3);
+    for (JU::uint32 triangle = 0; triangle < vTriangleIndices.size(); ++triangle)
+    {
+        indices[triangle * 3 + 0] = vTriangleIndices[triangle].v0_;
+        indices[triangle * 3 + 1] = vTriangleIndices[triangle].v1_;
+        indices[triangle * 3 + 2] = vTriangleIndices[triangle].v2_;
     }
 
-    // VERTEX TEXTURE COORDINATES
-    if (vTexCoords.size())
-    {
-        float *aTexCoords   = new float [num_vertices * TEX_VECTOR_SIZE];
+    pool.upload(vertex_range_, vertices.empty() ? NULL : &vertices[0], index_range_, indices.empty() ? NULL : &indices[0]);
 
-        for (JU::uint32 index = 0; index < num_vertices; ++index)
-        {
-            aTexCoords[index * TEX_VECTOR_SIZE + 0] = vTexCoords[vVertexIndices[index].tex_].s;
-            aTexCoords[index * TEX_VECTOR_SIZE + 1] = vTexCoords[vVertexIndices[index].tex_].t;
-        }
+    pool_           = &pool;
+    num_triangles_  = vTriangleIndices.size();
+    index_type_     = gl::UNSIGNED_INT;
+    vSubMeshes_     = mesh.getSubMeshes();
+    is_initialized_ = true;
 
-        // Texture Coordinates VBO
-        gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[vbo_index]);
-        gl::BufferData(gl::ARRAY_BUFFER, num_vertices * TEX_VECTOR_SIZE * sizeof(aTexCoords[0]), aTexCoords, gl::STATIC_DRAW);
-        gl::VertexAttribPointer(GLSLProgram::TEXCOORD_ATTRIBUTE_LOCATION, TEX_VECTOR_SIZE, gl::FLOAT, gl::FALSE_, 0, (GLubyte *)NULL);
-        gl::EnableVertexAttribArray(GLSLProgram::TEXCOORD_ATTRIBUTE_LOCATION);   // Vertex texture coordinates
+    return true;
+}
 
-        delete [] aTexCoords;
 
-        ++vbo_index;
-    }
 
-    if (vTangents.size())
-    {
-        float *aTangents = new float [num_vertices * TANGENT_VECTOR_SIZE];
+const VertexLayout& GLMesh::getVertexLayout() const
+{
+    return layout_;
+}
 
-        for (JU::uint32 index = 0; index < num_vertices; ++index)
-        {
-            aTangents[index * TANGENT_VECTOR_SIZE + 0] = vTangents[index].x;
-            aTangents[index * TANGENT_VECTOR_SIZE + 1] = vTangents[index].y;
-            aTangents[index * TANGENT_VECTOR_SIZE + 2] = vTangents[index].z;
-            aTangents[index * TANGENT_VECTOR_SIZE + 3] = vTangents[index].w;
-        }
 
-        gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[vbo_index]);
-        gl::BufferData(gl::ARRAY_BUFFER, num_vertices * TANGENT_VECTOR_SIZE * sizeof(aTangents[0]), aTangents, gl::STATIC_DRAW);
-        gl::VertexAttribPointer(GLSLProgram::TANGENT_ATTRIBUTE_LOCATION, TANGENT_VECTOR_SIZE, gl::FLOAT, gl::FALSE_, 0, (GLubyte *)NULL);
-        gl::EnableVertexAttribArray(GLSLProgram::TANGENT_ATTRIBUTE_LOCATION);   // Vertex tangents
 
-        delete [] aTangents;
+GLenum GLMesh::getIndexType() const
+{
+    return index_type_;
+}
 
-        ++vbo_index;
-    }
 
-    if (vTriangleIndices.size())
-    {
-        num_triangles_ = vTriangleIndices.size();
-        JU::uint16* aIndices = new JU::uint16[num_triangles_ * 3];
 
-        for (JU::uint32 triangle = 0; triangle < num_triangles_; ++triangle)
-        {
-            aIndices[triangle * 3 + 0] = vTriangleIndices[triangle].v0_;
-            aIndices[triangle * 3 + 1] = vTriangleIndices[triangle].v1_;
-            aIndices[triangle * 3 + 2] = vTriangleIndices[triangle].v2_;
-        }
+const GLGeometryPool* GLMesh::getPool() const
+{
+    return pool_;
+}
 
-        // Allocate and initialize VBO for vertex indices
-        gl::BindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[vbo_index]);
-        gl::BufferData(gl::ELEMENT_ARRAY_BUFFER, num_triangles_ * 3 * sizeof(aIndices[0]), aIndices, gl::STATIC_DRAW);
 
-        delete [] aIndices;
-    }
 
-    is_initialized_ = true;
+const GLGeometryPool::Range& GLMesh::getVertexRange() const
+{
+    return vertex_range_;
+}
 
-    return true;
+
+
+const GLGeometryPool::Range& GLMesh::getIndexRange() const
+{
+    return index_range_;
+}
+
+
+
+const VectorSubMeshes& GLMesh::getSubMeshes() const
+{
+    return vSubMeshes_;
 }
 
 
@@ -258,7 +400,7 @@ bool GLMesh::initVBOs(const Mesh2& mesh)
 /**
 * @brief    Draw using OpenGL API
 *
-* @detail   + Bind the VAO for this GLMesh.
+* @detail   + Bind the VAO for this GLMesh (or the one of its pool).
 *           + Draw.
 *           + Unbind
 *
@@ -268,9 +410,89 @@ bool GLMesh::initVBOs(const Mesh2& mesh)
 */
 void GLMesh::draw(void) const
 {
-    gl::BindVertexArray(vao_handle_);
-    gl::BindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[num_buffers_ - 1]);
-    gl::DrawElements(gl::TRIANGLES, 3 * num_triangles_, gl::UNSIGNED_SHORT, 0);
+    bind();
+    drawElements();
+}
+
+
+
+/**
+* @brief    Bind the VAO of the mesh (or the one of its pool) and its index buffer
+*/
+void GLMesh::bind() const
+{
+    if (pool_)
+    {
+        pool_->bind();
+        return;
+    }
+
+    GLStateCache::bindVertexArray(vao_handle_);
+    GLStateCache::bindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[num_buffers_ - 1]);
+}
+
+
+
+/**
+* @brief    Draw the triangles of the mesh (its VAO must be bound, see 'bind')
+*/
+void GLMesh::drawElements() const
+{
+    if (pool_)
+        pool_->drawElements(vertex_range_, index_range_);
+    else
+        gl::DrawElements(gl::TRIANGLES, 3 * num_triangles_, index_type_, 0);
+}
+
+
+
+/**
+* @brief    Draw several instances of the mesh with a single call
+*
+* @detail   The model matrices of the instances are read from 'instance_vbo' (one glm::mat4 per instance, starting at
+*           'first_instance') into the INSTANCE_MODEL attribute, which advances once per instance. The attribute is
+*           disabled again after the draw, so the VAO of the mesh (or of its pool) is left ready for draw().
+*
+* @param instance_vbo   Buffer with the model matrices
+* @param first_instance Matrix of the first instance in the buffer
+* @param num_instances  Number of instances to draw
+*/
+void GLMesh::drawInstanced(GLuint instance_vbo, JU::uint32 first_instance, JU::uint32 num_instances) const
+{
+    if (pool_)
+        pool_->bind();
+    else
+        GLStateCache::bindVertexArray(vao_handle_);
+
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, instance_vbo);
+
+    for (JU::uint32 column = 0; column < 4; ++column)
+    {
+        GLuint location = GLSLProgram::INSTANCE_MODEL_ATTRIBUTE_LOCATION + column;
+
+        gl::VertexAttribPointer(location, 4, gl::FLOAT, gl::FALSE_, sizeof(glm::mat4), (GLubyte *)NULL + (first_instance * 4 + column) * sizeof(glm::vec4));
+        gl::VertexAttribDivisor(location, 1);
+        gl::EnableVertexAttribArray(location);
+    }
+
+    if (pool_)
+    {
+        gl::DrawElementsInstancedBaseVertex(gl::TRIANGLES, index_range_.count_, gl::UNSIGNED_INT, (GLubyte *)NULL + index_range_.first_ * sizeof(JU::uint32), num_instances, vertex_range_.first_);
+    }
+    else
+    {
+        GLStateCache::bindBuffer(gl::ELEMENT_ARRAY_BUFFER, vbo_handles_[num_buffers_ - 1]);
+        gl::DrawElementsInstanced(gl::TRIANGLES, 3 * num_triangles_, index_type_, 0, num_instances);
+    }
+
+    // The VAO is shared with the non-instanced draws (and, in a pool, with other meshes): leave it as it was
+    for (JU::uint32 column = 0; column < 4; ++column)
+    {
+        GLuint location = GLSLProgram::INSTANCE_MODEL_ATTRIBUTE_LOCATION + column;
+
+        gl::DisableVertexAttribArray(location);
+        gl::VertexAttribDivisor(location, 0);
+    }
 }
 
 } // namespace JU
@@ -11,6 +11,8 @@
 // Local includes
 #include "gl_core_4_2.hpp"      // glLoadGen generated header file
 #include "GraphicsDefs.hpp"     // VectorPositions, VectorNormas...
+#include "VertexLayout.hpp"     // VertexLayout
+#include "GLGeometryPool.hpp"   // GLGeometryPool
 // Global includes
 #include <string>               // std::string
 
@@ -19,6 +21,7 @@ namespace JU
 
 // Forward declarations
 class Mesh2;
+class MeshCache;
 
 /**
  * @brief      Mesh2 adapter to OpenGL.
@@ -29,6 +32,9 @@ class Mesh2;
  *              There should only be a GLMesh per Mesh2 object; if we want to have two instances of the same model,
  *              this is accomplish by creating to GLMeshInstance objects, both sharing the same GLMesh under the hood.
  *
+ *              The vertices are interleaved in a single VBO (see VertexLayout), followed by the index VBO. A mesh
+ *              initialized in a GLGeometryPool owns no GL objects: it uses a range of the buffers of the pool instead.
+ *
  */
 class GLMesh
 {
@@ -38,8 +44,22 @@ class GLMesh
 
         void release();
         virtual void draw(void) const;
-        bool init(const Mesh2& mesh);
-        bool initVBOs(const Mesh2& mesh);
+        void bind() const;
+        void drawElements() const;
+        void drawInstanced(GLuint instance_vbo, JU::uint32 first_instance, JU::uint32 num_instances) const;
+        bool init(const Mesh2& mesh, bool optimize = false);
+        bool init(const Mesh2& mesh, const VertexLayout& layout, bool optimize = false);
+        bool init(const MeshCache& cache);
+        bool init(const Mesh2& mesh, GLGeometryPool& pool, bool optimize = false);
+        bool initVBOs(const Mesh2& mesh, const VertexLayout& layout);
+        bool initPool(const Mesh2& mesh, GLGeometryPool& pool);
+
+        const VertexLayout& getVertexLayout() const;
+        GLenum getIndexType() const;
+        const GLGeometryPool* getPool() const;
+        const GLGeometryPool::Range& getVertexRange() const;
+        const GLGeometryPool::Range& getIndexRange() const;
+        const VectorSubMeshes& getSubMeshes() const;
 
     private:
         bool        is_initialized_;    //!< Is mesh initialized
@@ -47,6 +67,12 @@ class GLMesh
         GLuint*     vbo_handles_;       //!< Array of vbo handles
         JU::uint8   num_buffers_;       //!< Number of vbos
         GLuint      num_triangles_;     //!< Number of triangles
+        GLenum      index_type_;        //!< Type of the indices (UNSIGNED_BYTE, UNSIGNED_SHORT or UNSIGNED_INT)
+        VertexLayout layout_;           //!< Layout of the interleaved vertices
+        GLGeometryPool* pool_;          //!< Pool the mesh is in (NULL if it has its own buffers)
+        GLGeometryPool::Range vertex_range_;    //!< Vertices of the mesh in the pool
+        GLGeometryPool::Range index_range_;     //!< Indices of the mesh in the pool
+        VectorSubMeshes vSubMeshes_;    //!< Ranges of triangles of each source mesh (see Mesh2)
 };
 
 } // namespace JU
@@ -20,10 +20,14 @@
 #include "TextureManager.hpp"               // bindTexture
 #include "Material.hpp"						// Material
 #include "GLSLProgramExt.hpp"				// extended setUniform helper functions
+#include "UniformBlockManager.hpp"          // UniformBlockManager
 
 namespace JU
 {
 
+// About one pixel at a 1000 pixel high viewport
+const JU::f32 GLMeshInstance::DEFAULT_LOD_THRESHOLD = 0.001f;
+
 /**
 * @brief Non-Default constructor
 *
@@ -37,7 +41,7 @@ GLMeshInstance::GLMeshInstance(const GLMesh *mesh,
                                float scaleY,
                                float scaleZ,
                                const Material* material) :
-        mesh_(mesh), scaleX_(scaleX), scaleY_(scaleY), scaleZ_(scaleZ)
+        mesh_(mesh), scaleX_(scaleX), scaleY_(scaleY), scaleZ_(scaleZ), lod_threshold_(DEFAULT_LOD_THRESHOLD)
 {
 	if (material)
 		material_ = new Material(material);
@@ -68,6 +72,20 @@ void GLMeshInstance::addNormalTexture(const std::string &texture_name)
 
 
 
+/**
+* @brief Add the next (coarser) level of detail
+*
+* @param mesh  Simplified version of the mesh (e.g. from MeshSimplifier::buildLODs)
+* @param error Error bound of the level in object space (before the scale factors)
+*/
+void GLMeshInstance::addLOD(const GLMesh* mesh, JU::f32 error)
+{
+    lod_meshes_.push_back(mesh);
+    lod_errors_.push_back(error);
+}
+
+
+
 /**
 * @brief Set the mesh
 *
@@ -110,6 +128,18 @@ void GLMeshInstance::setMaterial(const Material* material)
 }
 
 
+
+/**
+* @brief Set the largest error allowed on screen when picking a level of detail
+*
+* @param threshold Projected error as a fraction of the screen height
+*/
+void GLMeshInstance::setLODThreshold(JU::f32 threshold)
+{
+    lod_threshold_ = threshold;
+}
+
+
 /**
 * @brief Set scale factors
 *
@@ -125,6 +155,112 @@ void GLMeshInstance::getScale(JU::f32& x, JU::f32& y, JU::f32& z) const
 }
 
 
+
+JU::uint32 GLMeshInstance::getNumLODs() const
+{
+    return lod_meshes_.size() + 1;
+}
+
+
+
+/**
+* @brief Mesh of a level of detail
+*
+* @param lod Level of detail (0 is the full resolution mesh)
+*/
+const GLMesh* GLMeshInstance::getMesh(JU::uint32 lod) const
+{
+    return (lod == 0) ? mesh_ : lod_meshes_[lod - 1];
+}
+
+
+
+/**
+* @brief Pick the coarsest level of detail whose error is below the threshold once projected on the screen
+*
+* @detail The error of a level is scaled by the largest scale of the model view matrix and projected at the distance
+*         of the origin of the model (without the division by the distance for orthographic projections).
+*
+* @param mv         Model view matrix (including the scale factors)
+* @param projection Projection matrix
+*
+* @return Level of detail (0 is the full resolution mesh)
+*/
+JU::uint32 GLMeshInstance::selectLOD(const glm::mat4& mv, const glm::mat4& projection) const
+{
+    if (lod_meshes_.empty())
+        return 0;
+
+    JU::f32 scale = glm::max(glm::length(glm::vec3(mv[0])), glm::max(glm::length(glm::vec3(mv[1])), glm::length(glm::vec3(mv[2]))));
+
+    // The screen is 2 units high in NDC
+    JU::f32 projected = 0.5f * scale * projection[1][1];
+
+    if (projection[2][3] != 0.0f)
+    {
+        JU::f32 distance = -mv[3].z;
+        if (distance <= 0.0f)
+            return 0;
+        projected /= distance;
+    }
+
+    for (JU::uint32 lod = lod_meshes_.size(); lod > 0; --lod)
+        if (lod_errors_[lod - 1] * projected <= lod_threshold_)
+            return lod;
+
+    return 0;
+}
+
+
+/**
+* @brief Do both instances look the same (same material coefficients and textures)?
+*
+* @detail Each instance keeps its own copy of the material, so the coefficients are compared rather than the pointers.
+*/
+bool GLMeshInstance::hasSameMaterial(const GLMeshInstance& instance) const
+{
+    if ((material_ == 0) != (instance.material_ == 0))
+        return false;
+
+    if (material_ && (material_->ka_ != instance.material_->ka_ ||
+                      material_->kd_ != instance.material_->kd_ ||
+                      material_->ks_ != instance.material_->ks_ ||
+                      material_->shininess_ != instance.material_->shininess_))
+        return false;
+
+    return color_texture_name_list_ == instance.color_texture_name_list_ &&
+           normal_map_texture_name_ == instance.normal_map_texture_name_;
+}
+
+
+
+/**
+* @brief Load the material uniforms and bind the textures
+*
+* @detail The textures stay bound until TextureManager::unbindAllTextures is called.
+*/
+void GLMeshInstance::bindMaterial(const GLSLProgram &program) const
+{
+    if (material_)
+    {
+    	GLSLProgramExt::setUniform(program, *material_);
+    }
+
+    // Bind all COLOR TEXTURES
+    for (JU::uint32 index = 0; index < color_texture_name_list_.size(); ++index)
+    {
+        std::ostringstream oss;;
+        oss << GLSLProgram::COLOR_TEX_PREFIX << index;
+        TextureManager::bindTexture(program, color_texture_name_list_[index], oss.str());
+    }
+
+    // Bind NORMAL TEXTURE
+    if (normal_map_texture_name_.size() != 0)
+    	TextureManager::bindTexture(program, normal_map_texture_name_,GLSLProgram::NORMAL_MAP_TEX_PREFIX);
+}
+
+
+
 /**
 * @brief Destructor
 */
@@ -142,6 +278,7 @@ GLMeshInstance::~GLMeshInstance()
 * @detail   It needs to:
 *           + Activate the GLMeshInstance Shader Program
 *           + Set the Uniform variables
+*           + Draw the level of detail picked by selectLOD
 *           + Deactivate the Shader Program
 *
 * @param model      Model matrix
@@ -152,37 +289,100 @@ void GLMeshInstance::draw(const GLSLProgram &program, const glm::mat4 & model, c
 {
     // Update Model matrix with the local scale
     glm::mat4 new_model = model * glm::scale(glm::vec3(scaleX_, scaleY_, scaleZ_));
-    // View * Model
-    glm::mat4 mv = view * new_model;
-    // Compute MVP matrix_transform
-    glm::mat4 MVP (projection * view * new_model);
 
-    // LOAD UNIFORMS
-    program.setUniform("Model", new_model);
-    program.setUniform("ModelViewMatrix", mv);
-    program.setUniform("NormalMatrix", glm::mat3(glm::vec3(mv[0]), glm::vec3(mv[1]), glm::vec3(mv[2])));
-    program.setUniform("MVP", MVP);
+    // Only uploaded when the camera changes, so drawing the instances of a frame one by one still uploads it once
+    if (UniformBlockManager::isInitialized())
+        UniformBlockManager::setCamera(view, projection);
 
-    if (material_)
+    setMatrixUniforms(program, new_model, view, projection);
+
+    bindMaterial(program);
+
+    getMesh(selectLOD(view * new_model, projection))->draw();
+
+    TextureManager::unbindAllTextures();
+}
+
+
+
+/**
+* @brief Queue the level of detail picked by selectLOD (see RenderQueue)
+*
+* @param queue  Queue of the frame (it has the view and projection matrices)
+* @param model  Model matrix
+*/
+void GLMeshInstance::submit(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model) const
+{
+    glm::mat4 new_model = model * glm::scale(glm::vec3(scaleX_, scaleY_, scaleZ_));
+
+    queue.add(program, *this, *getMesh(selectLOD(queue.getView() * new_model, queue.getProjection())), new_model);
+}
+
+
+
+/**
+* @brief Draw a queued level of detail, skipping the binds the previous draw of the queue already did
+*
+* @param program        Program in use
+* @param mesh           Level of detail
+* @param model          Model matrix (including the scale factors)
+* @param view           View matrix
+* @param projection     Projection matrix
+* @param bind_material  Must the material and textures be bound (or are they already)?
+* @param bind_mesh      Must the VAO of the mesh be bound (or is it already)?
+*/
+void GLMeshInstance::drawQueued(const GLSLProgram &program,
+                                const GLMesh &mesh,
+                                const glm::mat4 &model,
+                                const glm::mat4 &view,
+                                const glm::mat4 &projection,
+                                bool bind_material,
+                                bool bind_mesh) const
+{
+    setMatrixUniforms(program, model, view, projection);
+
+    if (bind_material)
     {
-    	GLSLProgramExt::setUniform(program, *material_);
+        TextureManager::unbindAllTextures();
+        bindMaterial(program);
     }
 
-    // Bind all COLOR TEXTURES
-    for (JU::uint32 index = 0; index < color_texture_name_list_.size(); ++index)
+    if (bind_mesh)
+        mesh.bind();
+
+    mesh.drawElements();
+}
+
+
+
+/**
+* @brief Load the matrix uniforms of a draw
+*
+* @detail A program that declares the camera block reads the view and projection from the buffer set once per frame
+*         (see UniformBlockManager::setCamera), so only the model matrix is loaded.
+*
+* @param model      Model matrix (including the scale factors)
+* @param view       View matrix
+* @param projection Projection matrix
+*/
+void GLMeshInstance::setMatrixUniforms(const GLSLProgram &program, const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection)
+{
+    if (UniformBlockManager::isInitialized() && program.hasUniformBlock(UniformBlockManager::CAMERA_BLOCK_STRING))
     {
-        std::ostringstream oss;;
-        oss << GLSLProgram::COLOR_TEX_PREFIX << index;
-        TextureManager::bindTexture(program, color_texture_name_list_[index], oss.str());
+        program.setUniform("Model", model);
+        return;
     }
 
-    // Bind NORMAL TEXTURE
-    if (normal_map_texture_name_.size() != 0)
-    	TextureManager::bindTexture(program, normal_map_texture_name_,GLSLProgram::NORMAL_MAP_TEX_PREFIX);
-
-    mesh_->draw();
+    // View * Model
+    glm::mat4 mv = view * model;
+    // Compute MVP matrix_transform
+    glm::mat4 MVP (projection * view * model);
 
-    TextureManager::unbindAllTextures();
+    // LOAD UNIFORMS
+    program.setUniform("Model", model);
+    program.setUniform("ModelViewMatrix", mv);
+    program.setUniform("NormalMatrix", glm::mat3(glm::vec3(mv[0]), glm::vec3(mv[1]), glm::vec3(mv[2])));
+    program.setUniform("MVP", MVP);
 }
 
 } // namespace JU
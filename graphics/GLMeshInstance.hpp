@@ -15,6 +15,8 @@
 // Global Includes
 #include <string>               // std:string
 #include <map>                  // std::map
+#include <vector>               // std::vector
+#include <glm/glm.hpp>          // glm::mat4
 
 namespace JU
 {
@@ -35,7 +37,10 @@ class Material;
 class GLMeshInstance : public DrawInterface
 {
     public:
-		GLMeshInstance() : mesh_(0), scaleX_(1.0f), scaleY_(1.0f), scaleZ_(1.0f), material_(0) {}
+		static const JU::f32 DEFAULT_LOD_THRESHOLD;
+
+    public:
+		GLMeshInstance() : mesh_(0), scaleX_(1.0f), scaleY_(1.0f), scaleZ_(1.0f), material_(0), lod_threshold_(DEFAULT_LOD_THRESHOLD) {}
 
         GLMeshInstance(const GLMesh* mesh,
                        JU::f32 scaleX = 1.0f,
@@ -46,19 +51,43 @@ class GLMeshInstance : public DrawInterface
 
         void addColorTexture(const std::string &texture_name);
         void addNormalTexture(const std::string &texture_name);
+        void addLOD(const GLMesh* mesh, JU::f32 error);
 
         // Setters
         void setMesh(const GLMesh* mesh);
         void setScale(JU::f32 x, JU::f32 y, JU::f32 z);
         void setMaterial(const Material* material);
+        void setLODThreshold(JU::f32 threshold);
 
         // Getters
         void getScale(JU::f32& x, JU::f32& y, JU::f32& z) const;
+        JU::uint32 getNumLODs() const;
+        const GLMesh* getMesh(JU::uint32 lod = 0) const;
+
+        JU::uint32 selectLOD(const glm::mat4& mv, const glm::mat4& projection) const;
+        bool hasSameMaterial(const GLMeshInstance& instance) const;
+        void bindMaterial(const GLSLProgram &program) const;
 
         void draw(const GLSLProgram &program,
         		  const glm::mat4 & model,
         		  const glm::mat4 &view,
         		  const glm::mat4 &projection) const;
+        virtual void submit(RenderQueue &queue,
+                            const GLSLProgram &program,
+                            const glm::mat4 & model) const;
+        void drawQueued(const GLSLProgram &program,
+                        const GLMesh &mesh,
+                        const glm::mat4 &model,
+                        const glm::mat4 &view,
+                        const glm::mat4 &projection,
+                        bool bind_material,
+                        bool bind_mesh) const;
+
+    private:
+        static void setMatrixUniforms(const GLSLProgram &program,
+                                      const glm::mat4 &model,
+                                      const glm::mat4 &view,
+                                      const glm::mat4 &projection);
 
     private:
         const GLMesh* mesh_;                //!< Shared Mesh object
@@ -68,6 +97,9 @@ class GLMeshInstance : public DrawInterface
         Material* material_;					//!< Material coefficients
         std::vector<std::string> color_texture_name_list_;
         std::string normal_map_texture_name_;
+        std::vector<const GLMesh*> lod_meshes_;     //!< Levels of detail 1, 2... (level 0 is 'mesh_')
+        std::vector<JU::f32> lod_errors_;           //!< Error bound of each level of detail (object space)
+        JU::f32 lod_threshold_;                     //!< Largest projected error allowed (fraction of the screen height)
 
 };
 
@@ -8,6 +8,7 @@
 // Local includes
 #include "GLParticleSystem.hpp"		// GLParticleSystem
 #include "GLSLProgram.hpp"			// GLSLProgram
+#include "GLStateCache.hpp"			// GLStateCache
 
 namespace JU
 {
@@ -23,9 +24,9 @@ GLParticleSystem::GLParticleSystem() : max_particles_(0)
 GLParticleSystem::~GLParticleSystem()
 {
     // Delete the buffers
-    gl::DeleteBuffers(2, vbo_handles_);
+    GLStateCache::deleteBuffers(2, vbo_handles_);
     // Delete the vertex array
-    gl::DeleteVertexArrays(1, &vao_handle_);
+    GLStateCache::deleteVertexArrays(1, &vao_handle_);
     // Release the handles
     delete [] vbo_handles_;
 }
@@ -70,14 +71,14 @@ bool GLParticleSystem::initVBOs(void)
     // ----------------------
     // VAO
     gl::GenVertexArrays(1, &vao_handle_);
-    gl::BindVertexArray(vao_handle_);
+    GLStateCache::bindVertexArray(vao_handle_);
 
     // VBO
     vbo_handles_ = new GLuint[2];
     gl::GenBuffers(2, vbo_handles_);
 
     // Position VBO
-    gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
 
     gl::BufferData(gl::ARRAY_BUFFER,
                  max_particles_ * sizeof(positions_[0]),
@@ -94,7 +95,7 @@ bool GLParticleSystem::initVBOs(void)
     gl::EnableVertexAttribArray(0);   // Vertex positions
 
     // Color VBO
-    gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[1]);
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[1]);
 
     gl::BufferData(gl::ARRAY_BUFFER,
                  max_particles_ * sizeof(colors_[0]),
@@ -181,20 +182,20 @@ void GLParticleSystem::draw(const GLSLProgram &program, const glm::mat4 & model,
     program.setUniform("MVP", projection * mv);
 
     // Position VBO
-    gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[0]);
     gl::BufferSubData(gl::ARRAY_BUFFER,
     					0,
     					positions_.size() * sizeof(positions_[0]),
                  	 	&positions_[0]);
 
     // Color VBO
-    gl::BindBuffer(gl::ARRAY_BUFFER, vbo_handles_[1]);
+    GLStateCache::bindBuffer(gl::ARRAY_BUFFER, vbo_handles_[1]);
     gl::BufferSubData(gl::ARRAY_BUFFER,
     					0,
     					colors_.size() * sizeof(colors_[0]),
                  	 	&colors_[0]);
 
-    gl::BindVertexArray(vao_handle_);
+    GLStateCache::bindVertexArray(vao_handle_);
     gl::DrawArrays(gl::POINTS, 0, positions_.size());
 }
 
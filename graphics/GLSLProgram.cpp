@@ -2,13 +2,16 @@
 
 // Local includes
 #include "GLSLProgram.hpp"    // GLSLProgram
+#include "GLStateCache.hpp"   // GLStateCache
+#include "ProgramBinaryCache.hpp"   // ProgramBinaryCache
 
 
 // Global includes
-#include <fstream>
 #include <sstream>
 #include <iostream>
 #include <sys/stat.h>
+#include <cstring>          // std::strcmp
+#include <cstdio>           // std::fopen, std::fread
 
 namespace JU
 {
@@ -31,9 +34,11 @@ const std::string GLSLProgram::COLOR_ATTRIBUTE_NAME("VertexColor");
 const std::string GLSLProgram::NORMAL_ATTRIBUTE_NAME("VertexNormal");
 const std::string GLSLProgram::TANGENT_ATTRIBUTE_NAME("VertexTangent");
 const std::string GLSLProgram::TEXCOORD_ATTRIBUTE_NAME("VertexTexCoord");
+const std::string GLSLProgram::INSTANCE_ID_ATTRIBUTE_NAME("VertexInstanceID");
+const std::string GLSLProgram::INSTANCE_MODEL_ATTRIBUTE_NAME("InstanceModelMatrix");
 
 
-GLSLProgram::GLSLProgram() : handle_(0), linked_(false)
+GLSLProgram::GLSLProgram() : handle_(0), linked_(false), num_uniforms_(0)
 {
 }
 
@@ -58,26 +63,24 @@ bool GLSLProgram::compileShaderFromFile(const char * fileName, GLSLShader::GLSLS
 
     std::printf("Compiling file %s\n", fileName);
 
-    std::ifstream inFile( fileName, std::ios::in );
-    if (!inFile)
+    std::string code;
+    if (!readFile(fileName, code))
     {
+        log_string_ = "Unable to read file.";
         return false;
     }
 
-    std::ostringstream code;
-    while (inFile.good())
-    {
-        JU::int32 c = inFile.get();
-        if (!inFile.eof())
-            code << (char) c;
-    }
-    inFile.close();
-
-    return compileShaderFromString(code.str(), type);
+    return compileShaderFromString(code, type);
 }
 
 
 
+/**
+* @brief Compile a shader and attach it to the program
+*
+* @detail With the ProgramBinaryCache enabled the shader is only stored, and compiled by link() if the program has no
+*         cached binary: true does not mean it compiles then.
+*/
 bool GLSLProgram::compileShaderFromString(const std::string & source, GLSLShader::GLSLShaderType type)
 {
     if (handle_ <= 0)
@@ -90,6 +93,32 @@ bool GLSLProgram::compileShaderFromString(const std::string & source, GLSLShader
         }
     }
 
+    if (ProgramBinaryCache::isEnabled())
+    {
+        PendingShader shader;
+        shader.type_   = type;
+        shader.source_ = insertDefines(source);
+        vPendingShaders_.push_back(shader);
+        return true;
+    }
+
+    return compileShader(insertDefines(source), type);
+}
+
+
+
+/**
+* @brief Add a "#define name value" line (after the #version line) to the shaders compiled from now on
+*/
+void GLSLProgram::addDefine(const char * name, const char * value)
+{
+    defines_ += std::string("#define ") + name + " " + value + "\n";
+}
+
+
+
+bool GLSLProgram::compileShader(const std::string & source, GLSLShader::GLSLShaderType type)
+{
     GLuint shaderhandle_ = 0;
 
     switch (type)
@@ -149,11 +178,61 @@ bool GLSLProgram::compileShaderFromString(const std::string & source, GLSLShader
 
 
 
+/**
+* @brief Link the program
+*
+* @detail With the ProgramBinaryCache enabled the program is loaded from its binary if there is a valid one; otherwise
+*         the pending shaders are compiled, the program linked and its binary stored.
+*/
 bool GLSLProgram::link()
 {
     if( linked_ ) return true;
     if( handle_ <= 0 ) return false;
 
+    if (vPendingShaders_.empty())
+        return linkProgram();
+
+    std::vector<PendingShader> vShaders;
+    vShaders.swap(vPendingShaders_);
+
+    // The null characters keep different splits of the same text apart
+    std::string program_text (bindings_);
+    for (JU::uint32 shader = 0; shader < vShaders.size(); ++shader)
+    {
+        program_text += '\0';
+        program_text += std::to_string(vShaders[shader].type_);
+        program_text += '\0';
+        program_text += vShaders[shader].source_;
+    }
+
+    JU::uint64 key = ProgramBinaryCache::computeKey(program_text);
+
+    if (ProgramBinaryCache::load(handle_, key))
+    {
+        linked_ = true;
+        buildUniformTable();
+        buildUniformBlockList();
+        return linked_;
+    }
+
+    for (JU::uint32 shader = 0; shader < vShaders.size(); ++shader)
+        if (!compileShader(vShaders[shader].source_, vShaders[shader].type_))
+            return false;
+
+    gl::ProgramParameteri(handle_, gl::PROGRAM_BINARY_RETRIEVABLE_HINT, gl::TRUE_);
+
+    if (!linkProgram())
+        return false;
+
+    ProgramBinaryCache::save(handle_, key);
+
+    return linked_;
+}
+
+
+
+bool GLSLProgram::linkProgram()
+{
     gl::LinkProgram(handle_);
 
     GLint status = 0;
@@ -180,6 +259,8 @@ bool GLSLProgram::link()
     else
     {
         linked_ = true;
+        buildUniformTable();
+        buildUniformBlockList();
         return linked_;
     }
 }
@@ -191,7 +272,7 @@ void GLSLProgram::use() const
     if(handle_ <= 0 || (!linked_))
         return;
 
-    gl::UseProgram(handle_);
+    GLStateCache::useProgram(handle_);
 }
 
 
@@ -220,6 +301,7 @@ bool GLSLProgram::isLinked() const
 void GLSLProgram::bindAttribLocation(GLuint location, const char * name)
 {
     gl::BindAttribLocation(handle_, location, name);
+    bindings_ += "attrib " + std::to_string(location) + " " + name + "\n";
 }
 
 
@@ -227,22 +309,14 @@ void GLSLProgram::bindAttribLocation(GLuint location, const char * name)
 void GLSLProgram::bindFragDataLocation(GLuint location, const char * name)
 {
     gl::BindFragDataLocation(handle_, location, name);
+    bindings_ += "fragdata " + std::to_string(location) + " " + name + "\n";
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, float x, float y, float z) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::Uniform3f(loc,x,y,z);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), x,y,z);
 }
 
 
@@ -256,96 +330,150 @@ void GLSLProgram::setUniform(const char* name, const glm::vec3 & v) const
 
 void GLSLProgram::setUniform(const char* name, const glm::vec4 & v) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::Uniform4f(loc,v.x,v.y,v.z,v.w);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), v);
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, const glm::mat4 & m) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::UniformMatrix4fv(loc, 1, gl::FALSE_, &m[0][0]);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), m);
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, const glm::mat3 & m) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::UniformMatrix3fv(loc, 1, gl::FALSE_, &m[0][0]);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), m);
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, float val) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::Uniform1f(loc, val);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), val);
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, JU::int32 val) const
 {
-    GLint loc = getUniformLocation(name);
-
-    if (loc >= 0)
-    {
-        gl::Uniform1i(loc, val);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+    setUniform(findUniform(name), val);
 }
 
 
 
 void GLSLProgram::setUniform(const char* name, bool val) const
 {
-    GLint loc = getUniformLocation(name);
+    setUniform(findUniform(name), val);
+}
 
-    if (loc >= 0)
-    {
-        gl::Uniform1i(loc, val);
-    }
-    else
-    {
-        debug << "Uniform: " << name << " not found." << std::endl;
-    }
+
+
+/**
+* @brief Does the program declare an active uniform block with that name?
+*/
+bool GLSLProgram::hasUniformBlock(const char* name) const
+{
+    for (JU::uint32 block = 0; block < vUniformBlocks_.size(); ++block)
+        if (vUniformBlocks_[block] == name)
+            return true;
+
+    return false;
+}
+
+
+
+/**
+* @brief Connect a uniform block to a binding point (see UniformBlockManager)
+*
+* @return False if the program has no such active block
+*/
+bool GLSLProgram::bindUniformBlock(const char* name, GLuint binding) const
+{
+    if (!hasUniformBlock(name))
+        return false;
+
+    gl::UniformBlockBinding(handle_, gl::GetUniformBlockIndex(handle_, name), binding);
+
+    return true;
+}
+
+
+
+/**
+* @brief Handle to set a uniform without looking its name up
+*
+* @param name Name of the uniform (e.g. "light_pos[2].position")
+*
+* @return Handle (not valid if the program has no such active uniform)
+*/
+GLSLProgram::UniformHandle GLSLProgram::getUniformHandle(const char* name) const
+{
+    return UniformHandle(getUniformLocation(name));
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, float x, float y, float z) const
+{
+    if (handle.isValid())
+        gl::Uniform3f(handle.location_, x, y, z);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, const glm::vec3 & v) const
+{
+    setUniform(handle, v.x, v.y, v.z);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, const glm::vec4 & v) const
+{
+    if (handle.isValid())
+        gl::Uniform4f(handle.location_, v.x, v.y, v.z, v.w);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, const glm::mat4 & m) const
+{
+    if (handle.isValid())
+        gl::UniformMatrix4fv(handle.location_, 1, gl::FALSE_, &m[0][0]);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, const glm::mat3 & m) const
+{
+    if (handle.isValid())
+        gl::UniformMatrix3fv(handle.location_, 1, gl::FALSE_, &m[0][0]);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, float val) const
+{
+    if (handle.isValid())
+        gl::Uniform1f(handle.location_, val);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, int val) const
+{
+    if (handle.isValid())
+        gl::Uniform1i(handle.location_, val);
+}
+
+
+
+void GLSLProgram::setUniform(UniformHandle handle, bool val) const
+{
+    if (handle.isValid())
+        gl::Uniform1i(handle.location_, val);
 }
 
 
@@ -469,7 +597,178 @@ bool GLSLProgram::validate()
 
 GLint GLSLProgram::getUniformLocation(const char * name) const
 {
-    return gl::GetUniformLocation(handle_, name);
+    if (vUniforms_.empty())
+        return -1;
+
+    JU::uint32 mask = vUniforms_.size() - 1;
+
+    for (JU::uint32 slot = hashName(name) & mask; vUniforms_[slot].location_ >= 0; slot = (slot + 1) & mask)
+        if (std::strcmp(vUniforms_[slot].name_.c_str(), name) == 0)
+            return vUniforms_[slot].location_;
+
+    return -1;
+}
+
+
+
+GLSLProgram::UniformHandle GLSLProgram::findUniform(const char * name) const
+{
+    UniformHandle handle (getUniformLocation(name));
+
+    if (!handle.isValid())
+    {
+        debug << "Uniform: " << name << " not found." << std::endl;
+    }
+
+    return handle;
+}
+
+
+
+/**
+* @brief Enumerate the active uniforms into the name to location table
+*
+* @detail The elements of arrays of basic types are listed once, as "name[0]", so every element is added (and the
+*         name of the array alone, as GL accepts it too). The uniforms in blocks have no location and are skipped.
+*/
+void GLSLProgram::buildUniformTable()
+{
+    GLint num_uniforms = 0, max_length = 0;
+
+    gl::GetProgramiv(handle_, gl::ACTIVE_UNIFORMS, &num_uniforms);
+    gl::GetProgramiv(handle_, gl::ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+    JU::uint32 capacity = 16;
+    while (capacity < 2 * static_cast<JU::uint32>(num_uniforms))
+        capacity <<= 1;
+
+    UniformEntry empty;
+    empty.location_ = -1;
+    vUniforms_.assign(capacity, empty);
+    num_uniforms_ = 0;
+
+    std::vector<GLchar> name (max_length + 1);
+
+    for (GLint index = 0; index < num_uniforms; ++index)
+    {
+        GLint   size = 0;
+        GLenum  type;
+        GLsizei written = 0;
+
+        gl::GetActiveUniform(handle_, index, name.size(), &written, &size, &type, &name[0]);
+
+        GLint location = gl::GetUniformLocation(handle_, &name[0]);
+        if (location < 0)
+            continue;
+
+        std::string uniform_name (&name[0], written);
+        insertUniform(uniform_name, location);
+
+        if (uniform_name.size() > 3 && uniform_name.compare(uniform_name.size() - 3, 3, "[0]") == 0)
+        {
+            std::string base_name = uniform_name.substr(0, uniform_name.size() - 3);
+            insertUniform(base_name, location);
+
+            for (GLint element = 1; element < size; ++element)
+            {
+                std::string element_name = base_name + "[" + std::to_string(element) + "]";
+                insertUniform(element_name, gl::GetUniformLocation(handle_, element_name.c_str()));
+            }
+        }
+    }
+}
+
+
+
+void GLSLProgram::buildUniformBlockList()
+{
+    GLint num_blocks = 0;
+
+    gl::GetProgramiv(handle_, gl::ACTIVE_UNIFORM_BLOCKS, &num_blocks);
+
+    vUniformBlocks_.clear();
+
+    for (GLint index = 0; index < num_blocks; ++index)
+    {
+        GLint length = 0;
+        gl::GetActiveUniformBlockiv(handle_, index, gl::UNIFORM_BLOCK_NAME_LENGTH, &length);
+
+        std::vector<GLchar> name (length + 1);
+        GLsizei written = 0;
+        gl::GetActiveUniformBlockName(handle_, index, name.size(), &written, &name[0]);
+
+        vUniformBlocks_.push_back(std::string(&name[0], written));
+    }
+}
+
+
+
+void GLSLProgram::insertUniform(const std::string & name, GLint location)
+{
+    if (location < 0 || getUniformLocation(name.c_str()) >= 0)
+        return;
+
+    // Arrays of basic types add one name per element: keep the table at most half full
+    if (2 * (num_uniforms_ + 1) > vUniforms_.size())
+    {
+        std::vector<UniformEntry> old_uniforms;
+        old_uniforms.swap(vUniforms_);
+
+        UniformEntry empty;
+        empty.location_ = -1;
+        vUniforms_.assign(old_uniforms.size() * 2, empty);
+        num_uniforms_ = 0;
+
+        for (JU::uint32 slot = 0; slot < old_uniforms.size(); ++slot)
+            if (old_uniforms[slot].location_ >= 0)
+                insertUniform(old_uniforms[slot].name_, old_uniforms[slot].location_);
+    }
+
+    JU::uint32 mask = vUniforms_.size() - 1;
+    JU::uint32 slot = hashName(name.c_str()) & mask;
+
+    while (vUniforms_[slot].location_ >= 0)
+        slot = (slot + 1) & mask;
+
+    vUniforms_[slot].name_     = name;
+    vUniforms_[slot].location_ = location;
+    ++num_uniforms_;
+}
+
+
+
+/**
+* @brief FNV-1a hash of a name
+*/
+JU::uint32 GLSLProgram::hashName(const char * name)
+{
+    JU::uint32 hash = 2166136261u;
+
+    for (; *name; ++name)
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+
+    return hash;
+}
+
+
+
+/**
+* @brief Insert the defines after the #version line (which must come first) or at the start if there is none
+*/
+std::string GLSLProgram::insertDefines(const std::string & source) const
+{
+    if (defines_.empty())
+        return source;
+
+    std::string::size_type version = source.find("#version");
+    if (version == std::string::npos)
+        return defines_ + source;
+
+    std::string::size_type end_of_line = source.find('\n', version);
+    if (end_of_line == std::string::npos)
+        return source + "\n" + defines_;
+
+    return source.substr(0, end_of_line + 1) + defines_ + source.substr(end_of_line + 1);
 }
 
 
@@ -483,4 +782,32 @@ bool GLSLProgram::fileExists( const std::string & fileName )
     return 0 == ret;
 }
 
+
+
+/**
+* @brief Read a whole file with a single read
+*
+* @return Successful?
+*/
+bool GLSLProgram::readFile(const char * fileName, std::string & contents)
+{
+    std::FILE* file = std::fopen(fileName, "rb");
+    if (!file)
+        return false;
+
+    bool success = std::fseek(file, 0, SEEK_END) == 0;
+    long size = success ? std::ftell(file) : -1;
+    success = size >= 0 && std::fseek(file, 0, SEEK_SET) == 0;
+
+    if (success)
+    {
+        contents.resize(size);
+        success = size == 0 || std::fread(&contents[0], 1, size, file) == static_cast<std::size_t>(size);
+    }
+
+    std::fclose(file);
+
+    return success;
+}
+
 } // namespace JU
@@ -10,6 +10,7 @@
 #include <string>               // std::string
 #include <glm/glm.hpp>          // glm::vecX
 #include <unordered_map>        // std::unordered_map
+#include <vector>               // std::vector
 
 namespace JU
 {
@@ -32,6 +33,14 @@ namespace GLSLShader
  * @brief   Class encapsulating a GLSL Program
  *
  * @detail  Class encapsulating a GLSL Program that also adds some member functions to set uniform variables. This class was mostly copied from the Cookbook code.
+ *
+ *          The active uniforms are enumerated once when the program is linked, into a hash table from their names to
+ *          their locations, so setting a uniform by name does not query the driver. A UniformHandle skips the hash
+ *          lookup too: get it once (e.g. after linking) and use it every frame.
+ *
+ *          If the ProgramBinaryCache is enabled the shaders are not compiled as they are added: link() first looks
+ *          for a binary of the program (keyed by the sources, defines and attribute bindings) and only compiles and
+ *          links from source if there is none, storing the new binary. Compile errors are then reported by link().
  */
 class GLSLProgram
 {
@@ -39,6 +48,17 @@ class GLSLProgram
         // TYPEDEFS
         typedef std::unordered_map<std::string, JU::uint32> HashMapSamplerTexUnit;
 
+        /**
+         * @brief Location of a uniform of a program (only valid for that program)
+         */
+        struct UniformHandle
+        {
+            explicit UniformHandle(GLint location = -1) : location_(location) {}
+            bool isValid() const { return location_ >= 0; }
+
+            GLint location_;    //!< -1 if the program has no such active uniform
+        };
+
     public:
 
         static const std::string COLOR_TEX_PREFIX;
@@ -49,17 +69,22 @@ class GLSLProgram
         static const std::string NORMAL_ATTRIBUTE_NAME;
         static const std::string TANGENT_ATTRIBUTE_NAME;
         static const std::string TEXCOORD_ATTRIBUTE_NAME;
+        static const std::string INSTANCE_ID_ATTRIBUTE_NAME;
+        static const std::string INSTANCE_MODEL_ATTRIBUTE_NAME;
 
         static const JU::uint8 POSITION_ATTRIBUTE_LOCATION  = 0;
         static const JU::uint8 COLOR_ATTRIBUTE_LOCATION     = 1;
         static const JU::uint8 NORMAL_ATTRIBUTE_LOCATION    = 2;
         static const JU::uint8 TANGENT_ATTRIBUTE_LOCATION   = 3;
         static const JU::uint8 TEXCOORD_ATTRIBUTE_LOCATION  = 4;
+        static const JU::uint8 INSTANCE_ID_ATTRIBUTE_LOCATION = 5;   //!< Number of the instance in a GLGeometryPool batch
+        static const JU::uint8 INSTANCE_MODEL_ATTRIBUTE_LOCATION = 6;    //!< Model matrix of an instance (mat4: locations 6 to 9)
 
         GLSLProgram();
 
         bool compileShaderFromFile(const char * fileName, GLSLShader::GLSLShaderType type);
         bool compileShaderFromString(const std::string & source, GLSLShader::GLSLShaderType type);
+        void addDefine(const char * name, const char * value = "");
         bool link();
         bool validate();
         void use() const;
@@ -82,20 +107,66 @@ class GLSLProgram
         void setUniform(const char* name, bool val ) const;
         void setSamplerUniform(const char* name);
 
+        bool hasUniformBlock(const char* name) const;
+        bool bindUniformBlock(const char* name, GLuint binding) const;
+
+        UniformHandle getUniformHandle(const char* name) const;
+        void setUniform(UniformHandle handle, float x, float y, float z) const;
+        void setUniform(UniformHandle handle, const glm::vec3 & v) const;
+        void setUniform(UniformHandle handle, const glm::vec4 & v) const;
+        void setUniform(UniformHandle handle, const glm::mat4 & m) const;
+        void setUniform(UniformHandle handle, const glm::mat3 & m) const;
+        void setUniform(UniformHandle handle, float val ) const;
+        void setUniform(UniformHandle handle, int val ) const;
+        void setUniform(UniformHandle handle, bool val ) const;
+
         JU::int32 getSamplerTexUnit(const char* name) const;
 
         void printActiveUniforms() const;
         void printActiveAttribs() const;
 
     private:
+        /**
+         * @brief Shader whose compilation waits for link() (see ProgramBinaryCache)
+         */
+        struct PendingShader
+        {
+            GLSLShader::GLSLShaderType  type_;
+            std::string                 source_;
+        };
+
+        /**
+         * @brief Slot of the table of active uniforms
+         */
+        struct UniformEntry
+        {
+            std::string name_;
+            GLint       location_;  //!< -1 if the slot is empty
+        };
+
+        bool  compileShader(const std::string & source, GLSLShader::GLSLShaderType type);
+        bool  linkProgram();
+        std::string insertDefines(const std::string & source) const;
         GLint getUniformLocation(const char * name ) const;
+        UniformHandle findUniform(const char * name) const;
+        void  buildUniformTable();
+        void  buildUniformBlockList();
+        void  insertUniform(const std::string & name, GLint location);
+        static JU::uint32 hashName(const char * name);
         bool  fileExists(const std::string & fileName);
+        static bool readFile(const char * fileName, std::string & contents);
 
     private:
         GLuint                  handle_;
         bool                    linked_;
         std::string             log_string_;
         HashMapSamplerTexUnit   hmSamplerToTexUnit_;
+        std::vector<UniformEntry> vUniforms_;     //!< Open-addressing table of the active uniforms (power-of-two size)
+        JU::uint32              num_uniforms_;      //!< Names in the table
+        std::vector<std::string> vUniformBlocks_;   //!< Names of the active uniform blocks
+        std::string             defines_;           //!< "#define" lines inserted in every shader
+        std::string             bindings_;          //!< Attribute and fragment data bindings (part of the cache key)
+        std::vector<PendingShader> vPendingShaders_;    //!< Shaders to compile in link() if there is no binary
 };
 
 } // namespace JU
@@ -9,6 +9,10 @@
 #include "GLSLProgramExt.hpp"
 #include "GLSLProgram.hpp"			// GLSLProgram
 #include "Material.hpp"				// Material
+#include "UniformBlockManager.hpp"	// UniformBlockManager
+// Global includes
+#include <string>					// std::string, std::to_string
+#include <vector>					// std::vector
 
 namespace JU
 {
@@ -41,8 +45,62 @@ const char* GLSLProgramExt::SHININESS_STRING				= "material.shininess";
 
 
 
+namespace
+{
+	enum LightArray
+	{
+		POSITIONAL_ARRAY,
+		DIRECTIONAL_ARRAY,
+		SPOTLIGHT_ARRAY,
+		NUM_LIGHT_ARRAYS
+	};
+
+	enum LightMember
+	{
+		POSITION_MEMBER,
+		DIRECTION_MEMBER,
+		INTENSITY_MEMBER,
+		CUTOFF_MEMBER,
+		NUM_LIGHT_MEMBERS
+	};
+
+	/**
+	* @brief Name of a member of an element of a light array (e.g. "light_pos[3].position")
+	*
+	* @detail The names are formatted the first time they are needed and kept, so setting the lights every frame
+	*         builds no strings. The pointer is only valid until the next call.
+	*/
+	const char* getLightUniformName(LightArray array, JU::uint32 index, LightMember member)
+	{
+		static const char* prefixes[NUM_LIGHT_ARRAYS] = { GLSLProgramExt::POSITIONAL_ARRAY_PREFIX_STRING,
+														  GLSLProgramExt::DIRECTIONAL_ARRAY_PREFIX_STRING,
+														  GLSLProgramExt::SPOTLIGHT_ARRAY_PREFIX_STRING };
+		static const char* members[NUM_LIGHT_MEMBERS] = { GLSLProgramExt::LIGHT_POSITION_STRING,
+														  GLSLProgramExt::LIGHT_DIRECTION_STRING,
+														  GLSLProgramExt::LIGHT_INTENSITY_STRING,
+														  GLSLProgramExt::LIGHT_CUTOFF_STRING };
+		static std::vector<std::string> names[NUM_LIGHT_ARRAYS][NUM_LIGHT_MEMBERS];
+
+		std::vector<std::string>& array_names = names[array][member];
+
+		while (array_names.size() <= index)
+			array_names.push_back(std::string(prefixes[array]) + "[" + std::to_string(array_names.size()) + "]." + members[member]);
+
+		return array_names[index].c_str();
+	}
+}
+
+
+
 void GLSLProgramExt::setUniform(const GLSLProgram& program, const Material& material)
 {
+	// Programs that declare the material block read it from the shared uniform buffer
+	if (UniformBlockManager::isInitialized() && program.hasUniformBlock(UniformBlockManager::MATERIAL_BLOCK_STRING))
+	{
+		UniformBlockManager::setMaterial(material);
+		return;
+	}
+
 	program.setUniform(KA_STRING, material.ka_);
 	program.setUniform(KD_STRING, material.kd_);
 	program.setUniform(KS_STRING, material.ks_);
@@ -53,16 +111,22 @@ void GLSLProgramExt::setUniform(const GLSLProgram& program, const Material& mate
 
 void GLSLProgramExt::setUniform(const GLSLProgram& program, const LightPositionalVector& lights)
 {
+    // Programs that declare the lights block read them from the shared uniform buffer
+    if (UniformBlockManager::isInitialized() && program.hasUniformBlock(UniformBlockManager::LIGHTS_BLOCK_STRING))
+    {
+        UniformBlockManager::setPositionalLights(lights);
+        return;
+    }
+
     program.setUniform(NUM_POSITIONAL_LIGHTS_STRING, static_cast<int>(lights.size()));
 
     if (lights.size())
     {
     	JU::uint32 counter = 0;
-		std::string prefix = std::string(POSITIONAL_ARRAY_PREFIX_STRING) + std::string("[");
 		for (LightPositionalVector::const_iterator iter = lights.begin(); iter != lights.end(); ++iter)
 		{
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_POSITION_STRING).c_str(), iter->position_);
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_INTENSITY_STRING).c_str(), iter->intensity_);
+		    program.setUniform(getLightUniformName(POSITIONAL_ARRAY, counter, POSITION_MEMBER), iter->position_);
+		    program.setUniform(getLightUniformName(POSITIONAL_ARRAY, counter, INTENSITY_MEMBER), iter->intensity_);
 
 			++counter;
 		}
@@ -73,16 +137,22 @@ void GLSLProgramExt::setUniform(const GLSLProgram& program, const LightPositiona
 
 void GLSLProgramExt::setUniform(const GLSLProgram& program, const LightDirectionalVector& lights)
 {
+    // Programs that declare the lights block read them from the shared uniform buffer
+    if (UniformBlockManager::isInitialized() && program.hasUniformBlock(UniformBlockManager::LIGHTS_BLOCK_STRING))
+    {
+        UniformBlockManager::setDirectionalLights(lights);
+        return;
+    }
+
     program.setUniform(NUM_DIRECTIONAL_LIGHTS_STRING, static_cast<int>(lights.size()));
 
     if (lights.size())
     {
     	JU::uint32 counter = 0;
-		std::string prefix = std::string(DIRECTIONAL_ARRAY_PREFIX_STRING) + std::string("[");
 		for (LightDirectionalVector::const_iterator iter = lights.begin(); iter != lights.end(); ++iter)
 		{
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_DIRECTION_STRING).c_str(), iter->direction_);
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_INTENSITY_STRING).c_str(), iter->intensity_);
+		    program.setUniform(getLightUniformName(DIRECTIONAL_ARRAY, counter, DIRECTION_MEMBER), iter->direction_);
+		    program.setUniform(getLightUniformName(DIRECTIONAL_ARRAY, counter, INTENSITY_MEMBER), iter->intensity_);
 
 			++counter;
 		}
@@ -93,18 +163,24 @@ void GLSLProgramExt::setUniform(const GLSLProgram& program, const LightDirection
 
 void GLSLProgramExt::setUniform(const GLSLProgram& program, const LightSpotlightVector& lights)
 {
+    // Programs that declare the lights block read them from the shared uniform buffer
+    if (UniformBlockManager::isInitialized() && program.hasUniformBlock(UniformBlockManager::LIGHTS_BLOCK_STRING))
+    {
+        UniformBlockManager::setSpotlights(lights);
+        return;
+    }
+
     program.setUniform(NUM_SPOTLIGHT_LIGHTS_STRING, static_cast<int>(lights.size()));
 
     if (lights.size())
     {
     	JU::uint32 counter = 0;
-		std::string prefix = std::string(SPOTLIGHT_ARRAY_PREFIX_STRING) + std::string("[");
 		for (LightSpotlightVector::const_iterator iter = lights.begin(); iter != lights.end(); ++iter)
 		{
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_POSITION_STRING).c_str(),  iter->position_);
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_DIRECTION_STRING).c_str(), iter->direction_);
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_INTENSITY_STRING).c_str(), iter->intensity_);
-		    program.setUniform((prefix + std::to_string(counter) + "]." + LIGHT_CUTOFF_STRING).c_str(),    iter->cutoff_);
+		    program.setUniform(getLightUniformName(SPOTLIGHT_ARRAY, counter, POSITION_MEMBER),  iter->position_);
+		    program.setUniform(getLightUniformName(SPOTLIGHT_ARRAY, counter, DIRECTION_MEMBER), iter->direction_);
+		    program.setUniform(getLightUniformName(SPOTLIGHT_ARRAY, counter, INTENSITY_MEMBER), iter->intensity_);
+		    program.setUniform(getLightUniformName(SPOTLIGHT_ARRAY, counter, CUTOFF_MEMBER),    iter->cutoff_);
 
 			++counter;
 		}
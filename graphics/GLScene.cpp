@@ -6,6 +6,7 @@
  */
 
 #include "GLScene.hpp"              // GLScene
+#include "UniformBlockManager.hpp"  // UniformBlockManager
 
 namespace JU
 {
@@ -57,6 +58,8 @@ GLSLProgram GLScene::compileAndLinkShader(const char* vertex, const char* fragme
         exit(1);
     }
 
+    attachUniformBlocks(program);
+
     program.use();
 
     return program;
@@ -89,6 +92,8 @@ GLSLProgram GLScene::compileAndLinkShader(const char* vertex, const char* geomet
         exit(1);
     }
 
+    attachUniformBlocks(program);
+
     program.use();
 
     return program;
@@ -96,6 +101,29 @@ GLSLProgram GLScene::compileAndLinkShader(const char* vertex, const char* geomet
 
 
 
+/**
+* @brief Share the camera, lights and material uniform buffers with a program of the scene
+*
+* @detail Every program compiled by the scene (usually in 'init') is attached, creating the buffers the first time.
+*         The camera is then set once per frame (see RenderQueue::begin) and the lights and material when they
+*         change, for all the programs at once.
+*
+* @param program Linked program
+*
+* @return False if the uniform buffers could not be created (the program then keeps using plain uniforms)
+*/
+bool GLScene::attachUniformBlocks(const GLSLProgram& program)
+{
+    if (!UniformBlockManager::init())
+        return false;
+
+    UniformBlockManager::attachProgram(program);
+
+    return true;
+}
+
+
+
 const char* GLScene::getGLSLCurrentProgramString() const
 {
     return current_program_iter_->first.c_str();
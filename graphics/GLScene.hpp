@@ -46,6 +46,7 @@ class GLScene
     protected:
         GLSLProgram compileAndLinkShader(const char* vertex, const char* fragment);
         GLSLProgram compileAndLinkShader(const char* vertex, const char* geometry, const char* fragment);
+        bool attachUniformBlocks(const GLSLProgram& program);
 
     protected:
         GLSLProgramMap     glsl_program_map_;      //!< Map of GLSLProgram objects used by this GLScene
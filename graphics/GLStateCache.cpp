@@ -0,0 +1,480 @@
+/*
+ * GLStateCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "GLStateCache.hpp"
+
+namespace JU
+{
+
+namespace
+{
+    const GLuint UNKNOWN = 0xFFFFFFFF;     //!< State not known to the cache (the next call is always issued)
+
+    GLStateCache::Backend gl_backend;       //!< Backend that makes the GL calls
+}
+
+
+
+// STATIC MEMBER VARIABLES
+// -----------------------
+GLStateCache::Backend*                      GLStateCache::backend_ = &gl_backend;
+GLStateCache::Counters                      GLStateCache::counters_ = { 0, 0 };
+GLuint                                      GLStateCache::program_ = UNKNOWN;
+GLuint                                      GLStateCache::vao_ = UNKNOWN;
+std::vector<GLuint>                         GLStateCache::vBuffers_(NUM_BUFFER_TARGETS, UNKNOWN);
+std::unordered_map<GLuint, GLuint>          GLStateCache::hmElementBuffers_;
+JU::uint32                                  GLStateCache::active_unit_ = UNKNOWN;
+std::vector<GLStateCache::TextureBinding>   GLStateCache::vTextures_(MAX_TEXTURE_UNITS, TextureBinding(0, UNKNOWN));
+std::vector<GLStateCache::Capability>       GLStateCache::vCapabilities_;
+
+
+
+// STATIC MEMBER FUNCTIONS
+// -----------------------
+
+/**
+* @brief Replace the backend (e.g. by a RecordingBackend in a test)
+*
+* @param backend Backend to use (NULL goes back to the GL one). The state is invalidated.
+*/
+void GLStateCache::setBackend(Backend* backend)
+{
+    backend_ = backend ? backend : &gl_backend;
+
+    invalidate();
+}
+
+
+
+/**
+* @brief Forget all the state (e.g. after GL calls made without the cache)
+*/
+void GLStateCache::invalidate()
+{
+    program_     = UNKNOWN;
+    vao_         = UNKNOWN;
+    active_unit_ = UNKNOWN;
+
+    vBuffers_.assign(NUM_BUFFER_TARGETS, UNKNOWN);
+    vTextures_.assign(MAX_TEXTURE_UNITS, TextureBinding(0, UNKNOWN));
+    hmElementBuffers_.clear();
+    vCapabilities_.clear();
+}
+
+
+
+/**
+* @brief Reset the counters
+*/
+void GLStateCache::beginFrame()
+{
+    counters_.issued_  = 0;
+    counters_.skipped_ = 0;
+}
+
+
+
+const GLStateCache::Counters& GLStateCache::getCounters()
+{
+    return counters_;
+}
+
+
+
+void GLStateCache::useProgram(GLuint program)
+{
+    if (count(program == program_))
+        return;
+
+    backend_->useProgram(program);
+    program_ = program;
+}
+
+
+
+void GLStateCache::bindVertexArray(GLuint vao)
+{
+    if (count(vao == vao_))
+        return;
+
+    backend_->bindVertexArray(vao);
+    vao_ = vao;
+}
+
+
+
+/**
+* @brief Bind a buffer to a target
+*
+* @detail The element array buffer is remembered per VAO, as GL does. The targets that are not tracked are always issued.
+*/
+void GLStateCache::bindBuffer(GLenum target, GLuint buffer)
+{
+    if (target == gl::ELEMENT_ARRAY_BUFFER)
+    {
+        if (vao_ != UNKNOWN)
+        {
+            std::unordered_map<GLuint, GLuint>::iterator iter = hmElementBuffers_.find(vao_);
+
+            if (count(iter != hmElementBuffers_.end() && iter->second == buffer))
+                return;
+
+            hmElementBuffers_[vao_] = buffer;
+        }
+        else
+            count(false);
+
+        backend_->bindBuffer(target, buffer);
+        return;
+    }
+
+    BufferTarget tracked = getBufferTarget(target);
+
+    if (tracked == OTHER_BUFFER_TARGET)
+    {
+        count(false);
+        backend_->bindBuffer(target, buffer);
+        return;
+    }
+
+    if (count(vBuffers_[tracked] == buffer))
+        return;
+
+    backend_->bindBuffer(target, buffer);
+    vBuffers_[tracked] = buffer;
+}
+
+
+
+/**
+* @brief Make a texture unit active
+*
+* @param unit Unit number (0 for gl::TEXTURE0)
+*/
+void GLStateCache::activeTexture(JU::uint32 unit)
+{
+    if (count(unit == active_unit_))
+        return;
+
+    backend_->activeTexture(gl::TEXTURE0 + unit);
+    active_unit_ = unit;
+}
+
+
+
+/**
+* @brief Bind a texture to the active unit
+*/
+void GLStateCache::bindTexture(GLenum target, GLuint texture)
+{
+    if (active_unit_ >= MAX_TEXTURE_UNITS)
+    {
+        count(false);
+        backend_->bindTexture(target, texture);
+        return;
+    }
+
+    TextureBinding& binding = vTextures_[active_unit_];
+
+    if (count(binding.target_ == target && binding.texture_ == texture))
+        return;
+
+    backend_->bindTexture(target, texture);
+    binding = TextureBinding(target, texture);
+}
+
+
+
+/**
+* @brief Bind a texture to a unit (the unit is made active only if the texture is not already bound to it)
+*
+* @detail Only the last target bound to each unit is remembered, so alternating targets in a unit is always issued.
+*/
+void GLStateCache::bindTexture(JU::uint32 unit, GLenum target, GLuint texture)
+{
+    if (unit < MAX_TEXTURE_UNITS && vTextures_[unit].target_ == target && vTextures_[unit].texture_ == texture)
+    {
+        count(true);
+        return;
+    }
+
+    activeTexture(unit);
+    bindTexture(target, texture);
+}
+
+
+
+void GLStateCache::enable(GLenum capability)
+{
+    setCapability(capability, true);
+}
+
+
+
+void GLStateCache::disable(GLenum capability)
+{
+    setCapability(capability, false);
+}
+
+
+
+/**
+* @brief Delete buffers, forgetting their bindings
+*/
+void GLStateCache::deleteBuffers(GLsizei num, const GLuint* buffers)
+{
+    for (GLsizei index = 0; index < num; ++index)
+    {
+        for (JU::uint32 target = 0; target < NUM_BUFFER_TARGETS; ++target)
+            if (vBuffers_[target] == buffers[index])
+                vBuffers_[target] = UNKNOWN;
+
+        for (std::unordered_map<GLuint, GLuint>::iterator iter = hmElementBuffers_.begin(); iter != hmElementBuffers_.end(); ++iter)
+            if (iter->second == buffers[index])
+                iter->second = UNKNOWN;
+    }
+
+    backend_->deleteBuffers(num, buffers);
+}
+
+
+
+/**
+* @brief Delete VAOs, forgetting their bindings
+*/
+void GLStateCache::deleteVertexArrays(GLsizei num, const GLuint* vaos)
+{
+    for (GLsizei index = 0; index < num; ++index)
+    {
+        if (vao_ == vaos[index])
+            vao_ = UNKNOWN;
+
+        hmElementBuffers_.erase(vaos[index]);
+    }
+
+    backend_->deleteVertexArrays(num, vaos);
+}
+
+
+
+/**
+* @brief Delete textures, forgetting their bindings
+*/
+void GLStateCache::deleteTextures(GLsizei num, const GLuint* textures)
+{
+    for (GLsizei index = 0; index < num; ++index)
+        for (JU::uint32 unit = 0; unit < MAX_TEXTURE_UNITS; ++unit)
+            if (vTextures_[unit].texture_ == textures[index])
+                vTextures_[unit].texture_ = UNKNOWN;
+
+    backend_->deleteTextures(num, textures);
+}
+
+
+
+GLStateCache::BufferTarget GLStateCache::getBufferTarget(GLenum target)
+{
+    switch (target)
+    {
+        case gl::ARRAY_BUFFER:          return ARRAY_BUFFER_TARGET;
+        case gl::UNIFORM_BUFFER:        return UNIFORM_BUFFER_TARGET;
+        case gl::DRAW_INDIRECT_BUFFER:  return DRAW_INDIRECT_BUFFER_TARGET;
+        case gl::COPY_READ_BUFFER:      return COPY_READ_BUFFER_TARGET;
+        case gl::COPY_WRITE_BUFFER:     return COPY_WRITE_BUFFER_TARGET;
+        case gl::TEXTURE_BUFFER:        return TEXTURE_BUFFER_TARGET;
+        default:                        return OTHER_BUFFER_TARGET;
+    }
+}
+
+
+
+void GLStateCache::setCapability(GLenum capability, bool enabled)
+{
+    JU::uint32 index = 0;
+
+    while (index < vCapabilities_.size() && vCapabilities_[index].capability_ != capability)
+        ++index;
+
+    if (index < vCapabilities_.size())
+    {
+        if (count(vCapabilities_[index].enabled_ == enabled))
+            return;
+    }
+    else
+    {
+        count(false);
+
+        Capability state;
+        state.capability_ = capability;
+        vCapabilities_.push_back(state);
+    }
+
+    vCapabilities_[index].enabled_ = enabled;
+
+    if (enabled)
+        backend_->enable(capability);
+    else
+        backend_->disable(capability);
+}
+
+
+
+/**
+* @brief Count a call
+*
+* @param skip Is the call redundant?
+*
+* @return 'skip'
+*/
+bool GLStateCache::count(bool skip)
+{
+    if (skip)
+        ++counters_.skipped_;
+    else
+        ++counters_.issued_;
+
+    return skip;
+}
+
+
+
+// BACKENDS
+// --------
+
+void GLStateCache::Backend::useProgram(GLuint program)                              { gl::UseProgram(program); }
+void GLStateCache::Backend::bindVertexArray(GLuint vao)                             { gl::BindVertexArray(vao); }
+void GLStateCache::Backend::bindBuffer(GLenum target, GLuint buffer)                { gl::BindBuffer(target, buffer); }
+void GLStateCache::Backend::activeTexture(GLenum unit)                              { gl::ActiveTexture(unit); }
+void GLStateCache::Backend::bindTexture(GLenum target, GLuint texture)              { gl::BindTexture(target, texture); }
+void GLStateCache::Backend::enable(GLenum capability)                               { gl::Enable(capability); }
+void GLStateCache::Backend::disable(GLenum capability)                              { gl::Disable(capability); }
+void GLStateCache::Backend::deleteBuffers(GLsizei num, const GLuint* buffers)       { gl::DeleteBuffers(num, buffers); }
+void GLStateCache::Backend::deleteVertexArrays(GLsizei num, const GLuint* vaos)     { gl::DeleteVertexArrays(num, vaos); }
+void GLStateCache::Backend::deleteTextures(GLsizei num, const GLuint* textures)     { gl::DeleteTextures(num, textures); }
+
+
+
+/**
+* @brief Non-Default Constructor
+*
+* @param forward Make the GL calls too (needs a GL context)?
+*/
+GLStateCache::RecordingBackend::RecordingBackend(bool forward) : forward_(forward)
+{
+}
+
+
+
+void GLStateCache::RecordingBackend::useProgram(GLuint program)
+{
+    record(USE_PROGRAM, 0, program);
+    if (forward_) Backend::useProgram(program);
+}
+
+
+
+void GLStateCache::RecordingBackend::bindVertexArray(GLuint vao)
+{
+    record(BIND_VERTEX_ARRAY, 0, vao);
+    if (forward_) Backend::bindVertexArray(vao);
+}
+
+
+
+void GLStateCache::RecordingBackend::bindBuffer(GLenum target, GLuint buffer)
+{
+    record(BIND_BUFFER, target, buffer);
+    if (forward_) Backend::bindBuffer(target, buffer);
+}
+
+
+
+void GLStateCache::RecordingBackend::activeTexture(GLenum unit)
+{
+    record(ACTIVE_TEXTURE, unit, 0);
+    if (forward_) Backend::activeTexture(unit);
+}
+
+
+
+void GLStateCache::RecordingBackend::bindTexture(GLenum target, GLuint texture)
+{
+    record(BIND_TEXTURE, target, texture);
+    if (forward_) Backend::bindTexture(target, texture);
+}
+
+
+
+void GLStateCache::RecordingBackend::enable(GLenum capability)
+{
+    record(ENABLE, capability, 0);
+    if (forward_) Backend::enable(capability);
+}
+
+
+
+void GLStateCache::RecordingBackend::disable(GLenum capability)
+{
+    record(DISABLE, capability, 0);
+    if (forward_) Backend::disable(capability);
+}
+
+
+
+void GLStateCache::RecordingBackend::deleteBuffers(GLsizei num, const GLuint* buffers)
+{
+    for (GLsizei index = 0; index < num; ++index)
+        record(DELETE_BUFFER, 0, buffers[index]);
+    if (forward_) Backend::deleteBuffers(num, buffers);
+}
+
+
+
+void GLStateCache::RecordingBackend::deleteVertexArrays(GLsizei num, const GLuint* vaos)
+{
+    for (GLsizei index = 0; index < num; ++index)
+        record(DELETE_VERTEX_ARRAY, 0, vaos[index]);
+    if (forward_) Backend::deleteVertexArrays(num, vaos);
+}
+
+
+
+void GLStateCache::RecordingBackend::deleteTextures(GLsizei num, const GLuint* textures)
+{
+    for (GLsizei index = 0; index < num; ++index)
+        record(DELETE_TEXTURE, 0, textures[index]);
+    if (forward_) Backend::deleteTextures(num, textures);
+}
+
+
+
+const std::vector<GLStateCache::RecordingBackend::Call>& GLStateCache::RecordingBackend::getCalls() const
+{
+    return vCalls_;
+}
+
+
+
+void GLStateCache::RecordingBackend::clear()
+{
+    vCalls_.clear();
+}
+
+
+
+void GLStateCache::RecordingBackend::record(Function function, GLenum target, GLuint name)
+{
+    Call call;
+    call.function_ = function;
+    call.target_   = target;
+    call.name_     = name;
+
+    vCalls_.push_back(call);
+}
+
+} /* namespace JU */
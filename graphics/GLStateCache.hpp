@@ -0,0 +1,185 @@
+/*
+ * GLStateCache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef GLSTATECACHE_HPP_
+#define GLSTATECACHE_HPP_
+
+// Local includes
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+#include "../core/Defs.hpp"     // uint32
+// Global includes
+#include <vector>               // std::vector
+#include <unordered_map>        // std::unordered_map
+
+namespace JU
+{
+
+/**
+ * @brief Static class that shadows the GL binding state and skips the calls that would not change it
+ *
+ * @details It tracks the program, the VAO, the buffer bound to each common target, the element buffer of each VAO
+ *          (it is VAO state), the active texture unit, the texture of each unit and the enable flags. Every call either
+ *          goes to the backend (issued) or is dropped because the state already matches (skipped); both are counted
+ *          until the next 'beginFrame'.
+ *
+ *          The cache only knows about the calls made through it: code that binds or deletes GL objects directly must
+ *          call 'invalidate' afterwards. Deleting through the cache forgets the deleted objects (GL unbinds them, and
+ *          their names can be reused).
+ *
+ *          The backend makes the GL calls. RecordingBackend records them instead (optionally also forwarding them to
+ *          GL), so the cache and its users can be tested without a GL context.
+ */
+class GLStateCache
+{
+    public:
+        static const JU::uint32 MAX_TEXTURE_UNITS = 32;
+
+        /**
+         * @brief Calls of the current frame
+         */
+        struct Counters
+        {
+            JU::uint32 issued_;     //!< Calls that reached the backend
+            JU::uint32 skipped_;    //!< Calls dropped because they would not change the state
+        };
+
+        /**
+         * @brief GL calls the cache forwards
+         */
+        class Backend
+        {
+            public:
+                virtual ~Backend() {}
+
+                virtual void useProgram(GLuint program);
+                virtual void bindVertexArray(GLuint vao);
+                virtual void bindBuffer(GLenum target, GLuint buffer);
+                virtual void activeTexture(GLenum unit);
+                virtual void bindTexture(GLenum target, GLuint texture);
+                virtual void enable(GLenum capability);
+                virtual void disable(GLenum capability);
+                virtual void deleteBuffers(GLsizei num, const GLuint* buffers);
+                virtual void deleteVertexArrays(GLsizei num, const GLuint* vaos);
+                virtual void deleteTextures(GLsizei num, const GLuint* textures);
+        };
+
+        /**
+         * @brief Backend that records the calls (a mock for tests, or a trace when forwarding them to GL too)
+         */
+        class RecordingBackend : public Backend
+        {
+            public:
+                enum Function
+                {
+                    USE_PROGRAM,
+                    BIND_VERTEX_ARRAY,
+                    BIND_BUFFER,
+                    ACTIVE_TEXTURE,
+                    BIND_TEXTURE,
+                    ENABLE,
+                    DISABLE,
+                    DELETE_BUFFER,
+                    DELETE_VERTEX_ARRAY,
+                    DELETE_TEXTURE
+                };
+
+                struct Call
+                {
+                    Function    function_;
+                    GLenum      target_;    //!< Target, unit or capability (0 if the function has none)
+                    GLuint      name_;      //!< Object (0 if the function has none)
+                };
+
+            public:
+                RecordingBackend(bool forward = false);
+
+                virtual void useProgram(GLuint program);
+                virtual void bindVertexArray(GLuint vao);
+                virtual void bindBuffer(GLenum target, GLuint buffer);
+                virtual void activeTexture(GLenum unit);
+                virtual void bindTexture(GLenum target, GLuint texture);
+                virtual void enable(GLenum capability);
+                virtual void disable(GLenum capability);
+                virtual void deleteBuffers(GLsizei num, const GLuint* buffers);
+                virtual void deleteVertexArrays(GLsizei num, const GLuint* vaos);
+                virtual void deleteTextures(GLsizei num, const GLuint* textures);
+
+                const std::vector<Call>& getCalls() const;
+                void clear();
+
+            private:
+                void record(Function function, GLenum target, GLuint name);
+
+                bool                forward_;   //!< Make the GL calls too?
+                std::vector<Call>   vCalls_;
+        };
+
+    public:
+        static void setBackend(Backend* backend);
+        static void invalidate();
+        static void beginFrame();
+        static const Counters& getCounters();
+
+        static void useProgram(GLuint program);
+        static void bindVertexArray(GLuint vao);
+        static void bindBuffer(GLenum target, GLuint buffer);
+        static void activeTexture(JU::uint32 unit);
+        static void bindTexture(GLenum target, GLuint texture);
+        static void bindTexture(JU::uint32 unit, GLenum target, GLuint texture);
+        static void enable(GLenum capability);
+        static void disable(GLenum capability);
+
+        static void deleteBuffers(GLsizei num, const GLuint* buffers);
+        static void deleteVertexArrays(GLsizei num, const GLuint* vaos);
+        static void deleteTextures(GLsizei num, const GLuint* textures);
+
+    private:
+        enum BufferTarget
+        {
+            ARRAY_BUFFER_TARGET,
+            UNIFORM_BUFFER_TARGET,
+            DRAW_INDIRECT_BUFFER_TARGET,
+            COPY_READ_BUFFER_TARGET,
+            COPY_WRITE_BUFFER_TARGET,
+            TEXTURE_BUFFER_TARGET,
+            NUM_BUFFER_TARGETS,
+            OTHER_BUFFER_TARGET             //!< Not tracked: always issued
+        };
+
+        struct TextureBinding
+        {
+            TextureBinding(GLenum target = 0, GLuint texture = 0) : target_(target), texture_(texture) {}
+
+            GLenum target_;
+            GLuint texture_;
+        };
+
+        struct Capability
+        {
+            GLenum capability_;
+            bool   enabled_;
+        };
+
+        static BufferTarget getBufferTarget(GLenum target);
+        static void setCapability(GLenum capability, bool enabled);
+        static bool count(bool skip);
+
+    private:
+        static Backend*                             backend_;
+        static Counters                             counters_;
+        static GLuint                               program_;
+        static GLuint                               vao_;
+        static std::vector<GLuint>                  vBuffers_;              //!< Buffer bound to each tracked target
+        static std::unordered_map<GLuint, GLuint>   hmElementBuffers_;      //!< Element buffer bound to each VAO
+        static JU::uint32                           active_unit_;
+        static std::vector<TextureBinding>          vTextures_;             //!< Texture bound to each unit
+        static std::vector<Capability>              vCapabilities_;         //!< Capabilities of known state
+};
+
+} /* namespace JU */
+
+#endif /* GLSTATECACHE_HPP_ */
@@ -3,6 +3,7 @@
 
 // Global includes
 #include <vector>               // vector
+#include <string>               // string
 #include <glm/glm.hpp>          // glm::vec*
 // Local includes
 #include "../core/Defs.hpp"     // Built-in data types typdefs
@@ -15,7 +16,7 @@ const int TAB_KEY = 9;
 const int MIDDLE_BUTTON_SCROLL_UP   = 3;
 const int MIDDLE_BUTTON_SCROLL_DOWN = 4;
 
-typedef uint16 VertexIndex;
+typedef uint32 VertexIndex;   //!< Index into the vertex indices (GLMesh narrows it to the smallest GL type that fits)
 
 struct VertexIndices
 {
@@ -45,6 +46,19 @@ struct TriangleIndices
     VertexIndex v2_;
 };
 
+/**
+ * @brief Range of triangles of a mesh that came from one source mesh (e.g. one aiMesh of an imported scene)
+ */
+struct SubMesh
+{
+    SubMesh (const std::string& name = "", JU::uint32 first_triangle = 0, JU::uint32 num_triangles = 0)
+        : name_(name), first_triangle_(first_triangle), num_triangles_(num_triangles) {}
+
+    std::string name_;
+    JU::uint32  first_triangle_;
+    JU::uint32  num_triangles_;
+};
+
 // TYPEDEFS
 typedef std::vector<glm::vec3> VectorPositions;
 typedef VectorPositions::const_iterator VectorPositionsConstIter;
@@ -58,6 +72,8 @@ typedef std::vector<VertexIndices> VectorVertexIndices;
 typedef VectorVertexIndices::const_iterator VectorVertexIndicesConstIter;
 typedef std::vector<TriangleIndices> VectorTriangleIndices;
 typedef VectorTriangleIndices::const_iterator VectorTriangleIndicesConstIter;
+typedef std::vector<SubMesh> VectorSubMeshes;
+typedef VectorSubMeshes::const_iterator VectorSubMeshesConstIter;
 
 } // namespace JU
 
@@ -7,17 +7,60 @@
 
 // Local include
 #include "Mesh2.hpp"
+#include "../collision/Fitting.hpp"     // computeBoundingBox, computeBoundingSphere, computeBoundingOrientedBox
 
 // Global include
 #include <iostream>     // std::cout
+#include <cmath>        // std::sqrt, std::abs
+#include <limits>       // std::numeric_limits
+#include <algorithm>    // std::min, std::max
+#include <thread>       // std::thread
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>  // __m128
+    #define JU_MESH2_SSE 1
+#endif
 
 namespace JU
 {
 
+namespace
+{
+    /**
+     * @brief Tangent (and handedness in w) of a vertex from the sums of the tangents and bitangents of its faces
+     *
+     * @detail If there is no usable tangent (only degenerate faces, or the tangent is along the normal) any unit vector
+     *         perpendicular to the normal will do.
+     */
+    inline glm::vec4 orthogonalizeTangent(const glm::vec3& normal, const glm::vec3& tan, const glm::vec3& bit)
+    {
+        // Gram-Schmidt orthogonalize
+        glm::vec3 tangent (tan - glm::dot(normal, tan) * normal);
+        JU::f32 length = glm::length(tangent);
+
+        if (length > 1e-12f && length < std::numeric_limits<JU::f32>::infinity())
+            tangent /= length;
+        else
+        {
+            glm::vec3 axis (std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f));
+            tangent = glm::cross(normal, axis);
+            length  = glm::length(tangent);
+            tangent = (length > 0.0f) ? tangent / length : glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+
+        // Calculate handedness
+        JU::f32 w = (glm::dot(glm::cross(normal, tan), bit)) < 0.0f ? -1.0f : 1.0f;
+
+        return glm::vec4(tangent, w);
+    }
+}
+
+
+
 /**
 * @brief Default Constructor
 */
-Mesh2::Mesh2()
+Mesh2::Mesh2() : has_obb_(false)
 {
 }
 
@@ -80,9 +123,16 @@ void Mesh2::setNormals(const VectorNormals& vNormals)
 }
 
 
-void Mesh2::setPositions(const VectorPositions& vPositions)
+/**
+* @brief Set the positions and compute their bounding volumes
+*
+* @param num_threads Number of threads to split the bounding box reduction across
+*/
+void Mesh2::setPositions(const VectorPositions& vPositions, JU::uint32 num_threads)
 {
     vPositions_ = vPositions;
+
+    computeBounds(num_threads);
 }
 
 
@@ -98,6 +148,12 @@ void Mesh2::setTangents(const VectorTangents& vTangents)
 }
 
 
+void Mesh2::setSubMeshes(const VectorSubMeshes& vSubMeshes)
+{
+    vSubMeshes_ = vSubMeshes;
+}
+
+
 const VectorVertexIndices& Mesh2::getVertexIndices() const
 {
     return vVertexIndices_;
@@ -133,6 +189,152 @@ const VectorTangents& Mesh2::getTangents() const
     return vTangents_;
 }
 
+const VectorSubMeshes& Mesh2::getSubMeshes() const
+{
+    return vSubMeshes_;
+}
+
+const BoundingBox& Mesh2::getBoundingBox() const
+{
+    return bounding_box_;
+}
+
+const BoundingSphere& Mesh2::getBoundingSphere() const
+{
+    return bounding_sphere_;
+}
+
+/**
+* @brief Bounding box aligned with the principal axes of the positions
+*
+* @detail Only valid after computeOrientedBox (see hasBoundingOrientedBox); until then it is an empty box at the origin.
+*/
+const BoundingOrientedBox& Mesh2::getBoundingOrientedBox() const
+{
+    return bounding_obb_;
+}
+
+bool Mesh2::hasBoundingOrientedBox() const
+{
+    return has_obb_;
+}
+
+/**
+* @brief Compute the bounding box and sphere of the positions
+*
+* @detail Done whenever the positions are set, so the culling and broadphase code never has to and the getters do not
+*         write to the mesh. The oriented box needs a covariance and eigen solve that few meshes use, so it is left to
+*         computeOrientedBox.
+*
+* @param num_threads Number of threads to split the bounding box reduction across
+*/
+void Mesh2::computeBounds(JU::uint32 num_threads)
+{
+    bounding_box_    = computeBoundingBox(vPositions_, num_threads);
+    bounding_sphere_ = computeBoundingSphere(vPositions_);
+    bounding_obb_    = BoundingOrientedBox();
+    has_obb_         = false;
+}
+
+/**
+* @brief Fit the oriented bounding box to the principal axes of the positions
+*
+* @detail Call it once the positions are final (setting them again discards the box)
+*/
+void Mesh2::computeOrientedBox()
+{
+    bounding_obb_ = computeBoundingOrientedBox(vPositions_);
+    has_obb_      = true;
+}
+
+/**
+* @brief Merge the positions, normals, texture coordinates and vertices that are equal within a tolerance
+*
+* @detail Meant for imported meshes, where every submesh (and often every face) has its own copy of each vertex.
+*         Triangles that end up using the same vertex twice are dropped and the submesh ranges are updated; the order
+*         of the triangles is kept, including those outside every submesh. Merged vertices keep the tangent of the
+*         first of them.
+*
+* @param epsilon     Largest difference per component between two values considered equal
+* @param num_threads Number of threads to split the bounding box reduction across
+*/
+void Mesh2::weldVertices(JU::f32 epsilon, JU::uint32 num_threads)
+{
+    JU::uint32 num_vertices = vVertexIndices_.size();
+    bool has_normals        = !vNormals_.empty();
+    bool has_tex_coords     = !vTexCoords_.empty();
+    bool has_tangents       = vTangents_.size() == num_vertices && num_vertices > 0;
+
+    VertexWelder            welder (epsilon, num_vertices);
+    VectorPositions         vPositions;
+    VectorNormals           vNormals;
+    VectorTexCoords         vTexCoords;
+    VectorTangents          vTangents;
+    VectorVertexIndices     vVertexIndices;
+    std::vector<VertexIndex> remap (num_vertices);
+
+    for (JU::uint32 vertex = 0; vertex < num_vertices; ++vertex)
+    {
+        const VertexIndices& indices = vVertexIndices_[vertex];
+
+        glm::vec3 normal     (has_normals    ? vNormals_[indices.normal_] : glm::vec3(0.0f));
+        glm::vec2 tex_coords (has_tex_coords ? vTexCoords_[indices.tex_]  : glm::vec2(0.0f));
+
+        remap[vertex] = welder.addVertex(vPositions_[indices.position_], normal, tex_coords,
+                                         vPositions, vNormals, vTexCoords, vVertexIndices);
+
+        if (has_tangents && remap[vertex] == vTangents.size())
+            vTangents.push_back(vTangents_[vertex]);
+    }
+
+    // Remap the triangles in order, counting the ones kept before each of them: triangles outside every submesh are
+    // kept in place and triangles in overlapping submeshes are only emitted once
+    JU::uint32 num_triangles = vTriangleIndices_.size();
+    std::vector<JU::uint32> kept_before (num_triangles + 1);
+
+    VectorTriangleIndices vTriangleIndices;
+    vTriangleIndices.reserve(num_triangles);
+
+    for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
+    {
+        kept_before[triangle] = vTriangleIndices.size();
+
+        TriangleIndices welded (remap[vTriangleIndices_[triangle].v0_],
+                                remap[vTriangleIndices_[triangle].v1_],
+                                remap[vTriangleIndices_[triangle].v2_]);
+
+        if (welded.v0_ != welded.v1_ && welded.v1_ != welded.v2_ && welded.v2_ != welded.v0_)
+            vTriangleIndices.push_back(welded);
+    }
+    kept_before[num_triangles] = vTriangleIndices.size();
+
+    VectorSubMeshes vSubMeshes (vSubMeshes_);
+    for (JU::uint32 index = 0; index < vSubMeshes.size(); ++index)
+    {
+        SubMesh& submesh = vSubMeshes[index];
+        JU::uint32 begin = std::min(submesh.first_triangle_, num_triangles);
+        JU::uint32 end   = begin + std::min(submesh.num_triangles_, num_triangles - begin);
+
+        submesh.first_triangle_ = kept_before[begin];
+        submesh.num_triangles_  = kept_before[end] - kept_before[begin];
+    }
+
+    if (!has_normals)
+        vNormals.clear();
+    if (!has_tex_coords)
+        vTexCoords.clear();
+
+    setPositions(vPositions, num_threads);
+    vNormals_.swap(vNormals);
+    vTexCoords_.swap(vTexCoords);
+    vTangents_.swap(vTangents);
+    vVertexIndices_.swap(vVertexIndices);
+    vTriangleIndices_.swap(vTriangleIndices);
+    vSubMeshes_.swap(vSubMeshes);
+}
+
+
+
 void Mesh2::export2OBJ(const char *filename) const
 {
     FILE *file = fopen(filename, "w");
@@ -194,68 +396,260 @@ void Mesh2::export2OBJ(const char *filename) const
     fclose(file);
 }
 
-void Mesh2::computeTangents()
+/**
+* @brief Compute the tangent (and handedness in w) of every vertex
+*
+* @detail Works in two passes so no thread ever writes where another does:
+*          + Per face: the tangent and bitangent of ranges of triangles, four at a time with SSE.
+*          + Per vertex: ranges of vertices gather the tangents of the faces around them (vertex to face adjacency),
+*            then Gram-Schmidt orthogonalize against the normal.
+*         The faces around a vertex are summed in the order of the triangles, so the result does not depend on the
+*         number of threads (with one, they are scattered straight into the vertices instead). Faces with degenerate
+*         texture coordinates or edges contribute nothing, and a vertex left without a tangent gets any unit vector
+*         perpendicular to its normal.
+*
+* @param num_threads Number of threads to split each pass across (the calling thread is one of them)
+*/
+void Mesh2::computeTangents(JU::uint32 num_threads)
 {
-	JU::uint32 num_vertices (vVertexIndices_.size());
-	vTangents_.resize(num_vertices);
+    if (vNormals_.empty() || vTexCoords_.empty())
+    {
+        std::printf("Mesh2::computeTangents: mesh %s has no normals or texture coordinates\n", name_.c_str());
+        return;
+    }
+
+    JU::uint32 num_vertices  = vVertexIndices_.size();
+    JU::uint32 num_triangles = vTriangleIndices_.size();
 
-    // Per-Vertex vectors
-    std::vector<glm::vec3> tan (num_vertices, glm::vec3(0.0f, 0.0f, 0.0f));
-    std::vector<glm::vec3> bit (num_vertices, glm::vec3(0.0f, 0.0f, 0.0f));
+    vTangents_.resize(num_vertices);
 
-    // PER-FACE: compute tangent and bitangent and accumulate them
-	for (VectorTriangleIndicesConstIter triangle_iter = vTriangleIndices_.begin(); triangle_iter != vTriangleIndices_.end(); ++triangle_iter)
-	{
-		JU::uint32& p0 (vVertexIndices_[triangle_iter->v0_].position_);
-		JU::uint32& p1 (vVertexIndices_[triangle_iter->v1_].position_);
-		JU::uint32& p2 (vVertexIndices_[triangle_iter->v2_].position_);
+    // PER-FACE: compute tangent and bitangent
+    std::vector<glm::vec3> face_tangents (num_triangles);
+    std::vector<glm::vec3> face_bitangents (num_triangles);
 
-		JU::uint32& t0 (vVertexIndices_[triangle_iter->v0_].tex_);
-		JU::uint32& t1 (vVertexIndices_[triangle_iter->v1_].tex_);
-		JU::uint32& t2 (vVertexIndices_[triangle_iter->v2_].tex_);
+    // Not worth a thread for less than a few thousand triangles
+    const JU::uint32 MIN_ITEMS_PER_THREAD = 8192;
+    JU::uint32 face_threads = std::max(1u, std::min(num_threads, num_triangles / MIN_ITEMS_PER_THREAD));
 
-		// Compute the normal of the face
-        glm::vec3 vec1 (glm::normalize(vPositions_[p1] - vPositions_[p0]));
-        glm::vec3 vec2 (glm::normalize(vPositions_[p2] - vPositions_[p0]));
+    std::vector<std::thread> threads;
+    for (JU::uint32 thread = 1; thread < face_threads; ++thread)
+    {
+        JU::uint32 begin = (JU::uint64)num_triangles * thread / face_threads;
+        JU::uint32 end   = (JU::uint64)num_triangles * (thread + 1) / face_threads;
+        threads.push_back(std::thread(&Mesh2::computeFaceTangents, this, begin, end, std::ref(face_tangents), std::ref(face_bitangents)));
+    }
+    computeFaceTangents(0, num_triangles / face_threads, face_tangents, face_bitangents);
+
+    for (JU::uint32 thread = 0; thread < threads.size(); ++thread)
+        threads[thread].join();
+    threads.clear();
 
-        glm::vec2 tex1 (vTexCoords_[t1] - vTexCoords_[t0]);
-        glm::vec2 tex2 (vTexCoords_[t2] - vTexCoords_[t0]);
+    // PER-VERTEX
+    JU::uint32 vertex_threads = std::max(1u, std::min(num_threads, num_vertices / MIN_ITEMS_PER_THREAD));
 
-        float factor = 1 / (tex1.s*tex2.t - tex2.s*tex1.t);
+    if (vertex_threads == 1)
+    {
+        // Tangents and bitangents are stored in the same order as the vertices
+        std::vector<glm::vec3> tan (num_vertices, glm::vec3(0.0f, 0.0f, 0.0f));
+        std::vector<glm::vec3> bit (num_vertices, glm::vec3(0.0f, 0.0f, 0.0f));
 
-        /* REDO these next two lines. The program is crashing when the factor is inf/nan */
-        if (std::isinf(factor) || std::isnan(factor))
+        for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
         {
-        	std::printf("nan or inf value return in Mesh2::computeTangents\n");
-        	exit(EXIT_FAILURE);
+            const TriangleIndices& indices = vTriangleIndices_[triangle];
+
+            tan[indices.v0_] += face_tangents[triangle];
+            tan[indices.v1_] += face_tangents[triangle];
+            tan[indices.v2_] += face_tangents[triangle];
+            bit[indices.v0_] += face_bitangents[triangle];
+            bit[indices.v1_] += face_bitangents[triangle];
+            bit[indices.v2_] += face_bitangents[triangle];
         }
 
-        glm::vec3 tmp_tan (factor * ( tex2.t * vec1.x - tex1.t * vec2.x),
-                           factor * ( tex2.t * vec1.y - tex1.t * vec2.y),
-                           factor * ( tex2.t * vec1.z - tex1.t * vec2.z));
-        glm::vec3 tmp_bit (factor * (-tex2.s * vec1.x + tex1.s * vec2.x),
-                           factor * (-tex2.s * vec1.y + tex1.s * vec2.y),
-                           factor * (-tex2.s * vec1.z + tex1.s * vec2.z));
+        for (JU::uint32 vertex = 0; vertex < num_vertices; ++vertex)
+            vTangents_[vertex] = orthogonalizeTangent(vNormals_[vVertexIndices_[vertex].normal_], tan[vertex], bit[vertex]);
 
-        // Tangents and bitangents are stored in the same order as the vertices
-		tan[triangle_iter->v0_] += tmp_tan;
-        tan[triangle_iter->v1_] += tmp_tan;
-        tan[triangle_iter->v2_] += tmp_tan;
-        bit[triangle_iter->v0_] += tmp_bit;
-        bit[triangle_iter->v1_] += tmp_bit;
-        bit[triangle_iter->v2_] += tmp_bit;
-	}
-
-	// PER-VERTEX
-	for (JU::uint32 index = 0; index < num_vertices; ++index)
-	{
-		glm::vec3& normal = vNormals_[vVertexIndices_[index].normal_];
-
-		// Gram-Schmidt orthogonalize
-        glm::vec3 tangent (glm::normalize(tan[index] - (glm::dot(normal, tan[index]) * normal)));
-
-        // Calculate handedness}
-        float w = (glm::dot(glm::cross(normal, tan[index]), bit[index])) < 0.0f ? -1.0f : 1.0f;        vTangents_[index] = glm::vec4(tangent, w);
-	}
-}
+        return;
+    }
+
+    // Faces around each vertex, in triangle order (compressed: the faces of vertex v are [first[v], first[v + 1]))
+    std::vector<JU::uint32> first_face (num_vertices + 1, 0);
+    std::vector<JU::uint32> faces (num_triangles * 3);
+
+    for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
+    {
+        ++first_face[vTriangleIndices_[triangle].v0_ + 1];
+        ++first_face[vTriangleIndices_[triangle].v1_ + 1];
+        ++first_face[vTriangleIndices_[triangle].v2_ + 1];
+    }
+
+    for (JU::uint32 vertex = 0; vertex < num_vertices; ++vertex)
+        first_face[vertex + 1] += first_face[vertex];
+
+    std::vector<JU::uint32> next_face (first_face.begin(), first_face.end() - 1);
+    for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
+    {
+        faces[next_face[vTriangleIndices_[triangle].v0_]++] = triangle;
+        faces[next_face[vTriangleIndices_[triangle].v1_]++] = triangle;
+        faces[next_face[vTriangleIndices_[triangle].v2_]++] = triangle;
+    }
+
+    for (JU::uint32 thread = 1; thread < vertex_threads; ++thread)
+    {
+        JU::uint32 begin = (JU::uint64)num_vertices * thread / vertex_threads;
+        JU::uint32 end   = (JU::uint64)num_vertices * (thread + 1) / vertex_threads;
+        threads.push_back(std::thread(&Mesh2::computeVertexTangents, this, begin, end, std::cref(first_face), std::cref(faces),
+                                      std::cref(face_tangents), std::cref(face_bitangents)));
+    }
+    computeVertexTangents(0, num_vertices / vertex_threads, first_face, faces, face_tangents, face_bitangents);
+
+    for (JU::uint32 thread = 0; thread < threads.size(); ++thread)
+        threads[thread].join();
+}
+
+
+
+/**
+* @brief Tangent and bitangent of triangles [begin, end) (zero if the triangle is degenerate)
+*/
+void Mesh2::computeFaceTangents(JU::uint32              begin,
+                                JU::uint32              end,
+                                std::vector<glm::vec3>& face_tangents,
+                                std::vector<glm::vec3>& face_bitangents) const
+{
+    JU::uint32 triangle = begin;
+
+#if JU_MESH2_SSE
+    const __m128 ONE      = _mm_set1_ps(1.0f);
+    const __m128 ZERO     = _mm_setzero_ps();
+    const __m128 INFINITE = _mm_set1_ps(std::numeric_limits<JU::f32>::infinity());
+
+    for (; triangle + 4 <= end; triangle += 4)
+    {
+        // Gather the four triangles in structure of arrays form
+        JU::f32 p[3][3][4], t[3][2][4];
+
+        for (JU::uint32 lane = 0; lane < 4; ++lane)
+        {
+            const TriangleIndices& indices = vTriangleIndices_[triangle + lane];
+            const VertexIndices* corners[3] = { &vVertexIndices_[indices.v0_], &vVertexIndices_[indices.v1_], &vVertexIndices_[indices.v2_] };
+
+            for (JU::uint32 corner = 0; corner < 3; ++corner)
+            {
+                const glm::vec3& position  = vPositions_[corners[corner]->position_];
+                const glm::vec2& tex_coord = vTexCoords_[corners[corner]->tex_];
+
+                p[corner][0][lane] = position.x;
+                p[corner][1][lane] = position.y;
+                p[corner][2][lane] = position.z;
+                t[corner][0][lane] = tex_coord.s;
+                t[corner][1][lane] = tex_coord.t;
+            }
+        }
+
+        // Normalized edges
+        __m128 e1[3], e2[3];
+        for (JU::uint32 axis = 0; axis < 3; ++axis)
+        {
+            __m128 p0 = _mm_loadu_ps(p[0][axis]);
+            e1[axis] = _mm_sub_ps(_mm_loadu_ps(p[1][axis]), p0);
+            e2[axis] = _mm_sub_ps(_mm_loadu_ps(p[2][axis]), p0);
+        }
+
+        __m128 length1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1[0], e1[0]), _mm_mul_ps(e1[1], e1[1])), _mm_mul_ps(e1[2], e1[2]));
+        __m128 length2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2[0], e2[0]), _mm_mul_ps(e2[1], e2[1])), _mm_mul_ps(e2[2], e2[2]));
+        __m128 inv1    = _mm_div_ps(ONE, _mm_sqrt_ps(length1));
+        __m128 inv2    = _mm_div_ps(ONE, _mm_sqrt_ps(length2));
+
+        for (JU::uint32 axis = 0; axis < 3; ++axis)
+        {
+            e1[axis] = _mm_mul_ps(e1[axis], inv1);
+            e2[axis] = _mm_mul_ps(e2[axis], inv2);
+        }
+
+        // Texture coordinate deltas
+        __m128 t0s = _mm_loadu_ps(t[0][0]), t0t = _mm_loadu_ps(t[0][1]);
+        __m128 s1  = _mm_sub_ps(_mm_loadu_ps(t[1][0]), t0s), t1 = _mm_sub_ps(_mm_loadu_ps(t[1][1]), t0t);
+        __m128 s2  = _mm_sub_ps(_mm_loadu_ps(t[2][0]), t0s), t2 = _mm_sub_ps(_mm_loadu_ps(t[2][1]), t0t);
+
+        __m128 factor = _mm_div_ps(ONE, _mm_sub_ps(_mm_mul_ps(s1, t2), _mm_mul_ps(s2, t1)));
+
+        // Both edges non-zero and a finite factor (the comparisons are false for NaN)
+        __m128 valid = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(length1, ZERO), _mm_cmpgt_ps(length2, ZERO)),
+                                  _mm_cmplt_ps(_mm_max_ps(factor, _mm_sub_ps(ZERO, factor)), INFINITE));
+
+        JU::f32 tangent[3][4], bitangent[3][4];
+        for (JU::uint32 axis = 0; axis < 3; ++axis)
+        {
+            __m128 tan = _mm_mul_ps(factor, _mm_sub_ps(_mm_mul_ps(t2, e1[axis]), _mm_mul_ps(t1, e2[axis])));
+            __m128 bit = _mm_mul_ps(factor, _mm_sub_ps(_mm_mul_ps(s1, e2[axis]), _mm_mul_ps(s2, e1[axis])));
+
+            _mm_storeu_ps(tangent[axis], _mm_and_ps(valid, tan));
+            _mm_storeu_ps(bitangent[axis], _mm_and_ps(valid, bit));
+        }
+
+        for (JU::uint32 lane = 0; lane < 4; ++lane)
+        {
+            face_tangents[triangle + lane]   = glm::vec3(tangent[0][lane], tangent[1][lane], tangent[2][lane]);
+            face_bitangents[triangle + lane] = glm::vec3(bitangent[0][lane], bitangent[1][lane], bitangent[2][lane]);
+        }
+    }
+#endif
+
+    // Same operations, in the same order, as the SSE loop
+    for (; triangle < end; ++triangle)
+    {
+        const VertexIndices& i0 = vVertexIndices_[vTriangleIndices_[triangle].v0_];
+        const VertexIndices& i1 = vVertexIndices_[vTriangleIndices_[triangle].v1_];
+        const VertexIndices& i2 = vVertexIndices_[vTriangleIndices_[triangle].v2_];
+
+        glm::vec3 vec1 (vPositions_[i1.position_] - vPositions_[i0.position_]);
+        glm::vec3 vec2 (vPositions_[i2.position_] - vPositions_[i0.position_]);
+        JU::f32 length1 = glm::dot(vec1, vec1);
+        JU::f32 length2 = glm::dot(vec2, vec2);
+        vec1 *= 1.0f / std::sqrt(length1);
+        vec2 *= 1.0f / std::sqrt(length2);
+
+        glm::vec2 tex1 (vTexCoords_[i1.tex_] - vTexCoords_[i0.tex_]);
+        glm::vec2 tex2 (vTexCoords_[i2.tex_] - vTexCoords_[i0.tex_]);
+
+        JU::f32 factor = 1.0f / (tex1.s*tex2.t - tex2.s*tex1.t);
+
+        if (!(length1 > 0.0f && length2 > 0.0f && std::abs(factor) < std::numeric_limits<JU::f32>::infinity()))
+        {
+            face_tangents[triangle]   = glm::vec3(0.0f);
+            face_bitangents[triangle] = glm::vec3(0.0f);
+            continue;
+        }
+
+        face_tangents[triangle]   = factor * (tex2.t * vec1 - tex1.t * vec2);
+        face_bitangents[triangle] = factor * (tex1.s * vec2 - tex2.s * vec1);
+    }
+}
+
+
+
+/**
+* @brief Tangents of vertices [begin, end) from the tangents of the faces around them
+*/
+void Mesh2::computeVertexTangents(JU::uint32                     begin,
+                                  JU::uint32                     end,
+                                  const std::vector<JU::uint32>& first_face,
+                                  const std::vector<JU::uint32>& faces,
+                                  const std::vector<glm::vec3>&  face_tangents,
+                                  const std::vector<glm::vec3>&  face_bitangents)
+{
+    for (JU::uint32 vertex = begin; vertex < end; ++vertex)
+    {
+        glm::vec3 tan (0.0f);
+        glm::vec3 bit (0.0f);
+
+        for (JU::uint32 face = first_face[vertex]; face < first_face[vertex + 1]; ++face)
+        {
+            tan += face_tangents[faces[face]];
+            bit += face_bitangents[faces[face]];
+        }
+
+        vTangents_[vertex] = orthogonalizeTangent(vNormals_[vVertexIndices_[vertex].normal_], tan, bit);
+    }
+}
 } // namespace JU
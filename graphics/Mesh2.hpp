@@ -16,6 +16,8 @@
 // Local includes
 #include "../core/Defs.hpp"	// uint32
 #include "GraphicsDefs.hpp" // VertexPositions, VertexNormals...
+#include "../collision/BoundingVolumes.hpp"   // BoundingBox, BoundingSphere, BoundingOrientedBox
+#include "VertexWelder.hpp"   // VertexWelder
 
 namespace JU
 {
@@ -37,16 +39,19 @@ class Mesh2
 		virtual ~Mesh2();
 
 		// UTILITY FUNCTIONS
-		void computeTangents();
+		void computeTangents(JU::uint32 num_threads = 1);
+		void weldVertices(JU::f32 epsilon = VertexWelder::DEFAULT_EPSILON, JU::uint32 num_threads = 1);
+		void computeOrientedBox();
 
         // SETTERS
         void setVertexIndices(const VectorVertexIndices& vVertexIndices);
         void setTriangleIndices(const VectorTriangleIndices& vTriangleIndices);
         void setName(const std::string& name);
         void setNormals(const VectorNormals& vNormals);
-        void setPositions(const VectorPositions& vPositions);
+        void setPositions(const VectorPositions& vPositions, JU::uint32 num_threads = 1);
         void setTexCoords(const VectorTexCoords& vTexCoords);
         void setTangents(const VectorTangents& vTangents);
+        void setSubMeshes(const VectorSubMeshes& vSubMeshes);
 
         // GETTERS
         const VectorVertexIndices&      getVertexIndices() const;
@@ -56,6 +61,11 @@ class Mesh2
         const VectorPositions&          getPositions() const;
         const VectorTexCoords&          getTexCoords() const;
         const VectorTangents&           getTangents() const;
+        const VectorSubMeshes&          getSubMeshes() const;
+        const BoundingBox&              getBoundingBox() const;
+        const BoundingSphere&           getBoundingSphere() const;
+        const BoundingOrientedBox&      getBoundingOrientedBox() const;
+        bool                            hasBoundingOrientedBox() const;
 
 		// EXPORT AND OUTPUT FUNCTIONS
 		void exportOBJ(void) const;
@@ -64,6 +74,18 @@ class Mesh2
 
 	private:
 
+		void computeBounds(JU::uint32 num_threads);
+		void computeFaceTangents(JU::uint32              begin,
+		                         JU::uint32              end,
+		                         std::vector<glm::vec3>& face_tangents,
+		                         std::vector<glm::vec3>& face_bitangents) const;
+		void computeVertexTangents(JU::uint32                     begin,
+		                           JU::uint32                     end,
+		                           const std::vector<JU::uint32>& first_face,
+		                           const std::vector<JU::uint32>& faces,
+		                           const std::vector<glm::vec3>&  face_tangents,
+		                           const std::vector<glm::vec3>&  face_bitangents);
+
 		std::string     	  name_;          	//!< ID of the Mesh
 		VectorPositions		  vPositions_;    	//!< Vector of vertex coordinates
 		VectorNormals      	  vNormals_;      	//!< Vector of vertex normals
@@ -71,6 +93,13 @@ class Mesh2
 		VectorTangents		  vTangents_;		//!< Vector of vertex tangents
 		VectorVertexIndices   vVertexIndices_;  //!< Vector of face indices
 		VectorTriangleIndices vTriangleIndices_;//!< Vector of triangle indices
+		VectorSubMeshes       vSubMeshes_;      //!< Ranges of triangles of each source mesh (one per aiMesh if imported, empty if built in code)
+
+		// Bounds of vPositions_ (recomputed by 'setPositions', so the getters are safe to call from any thread)
+		BoundingBox           bounding_box_;      //!< Axis-aligned bounding box
+		BoundingSphere        bounding_sphere_;   //!< Bounding sphere
+		BoundingOrientedBox   bounding_obb_;      //!< Bounding box aligned with the principal axes (see computeOrientedBox)
+		bool                  has_obb_;           //!< Does bounding_obb_ match the positions?
 };
 
 } // namespace JU
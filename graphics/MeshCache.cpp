@@ -0,0 +1,582 @@
+/*
+ * MeshCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "MeshCache.hpp"
+#include "Mesh2.hpp"            // Mesh2
+#include "VertexLayout.hpp"     // VertexLayout
+// Global includes
+#include <vector>               // std::vector
+#include <cstdio>               // std::printf, std::fopen, std::fwrite
+#include <cstring>              // std::memset
+#include <cstddef>              // offsetof
+#include <sys/types.h>          // stat
+#include <sys/stat.h>           // stat, fstat
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>        // CreateFileMapping, MapViewOfFile, UnmapViewOfFile
+#else
+    #include <sys/mman.h>       // mmap, munmap
+    #include <fcntl.h>          // open
+    #include <unistd.h>         // close
+#endif
+
+namespace JU
+{
+
+static_assert(sizeof(MeshCache::Header) == 128, "MeshCache::Header must be 128 bytes");
+static_assert(sizeof(MeshCache::SubMeshRecord) == 16, "MeshCache::SubMeshRecord must be 16 bytes");
+
+namespace
+{
+    const char* CACHE_EXTENSION = ".jumc";
+
+    JU::uint64 align(JU::uint64 offset)
+    {
+        return (offset + MeshCache::ALIGNMENT - 1) & ~static_cast<JU::uint64>(MeshCache::ALIGNMENT - 1);
+    }
+
+    /**
+    * @brief Same choice as GLMesh: the smallest type that can address all the vertices
+    */
+    JU::uint32 getIndexSize(JU::uint32 num_vertices)
+    {
+        if (num_vertices <= 0xFF + 1)
+            return 1;
+        if (num_vertices <= 0xFFFF + 1)
+            return 2;
+        return 4;
+    }
+
+    template <typename IndexType>
+    void narrowIndices(const VectorTriangleIndices& vTriangleIndices, std::vector<JU::uint8>& bytes)
+    {
+        bytes.resize(vTriangleIndices.size() * 3 * sizeof(IndexType));
+        IndexType* indices = bytes.empty() ? nullptr : reinterpret_cast<IndexType*>(&bytes[0]);
+
+        for (JU::uint32 triangle = 0; triangle < vTriangleIndices.size(); ++triangle)
+        {
+            *indices++ = static_cast<IndexType>(vTriangleIndices[triangle].v0_);
+            *indices++ = static_cast<IndexType>(vTriangleIndices[triangle].v1_);
+            *indices++ = static_cast<IndexType>(vTriangleIndices[triangle].v2_);
+        }
+    }
+
+    bool writePadded(std::FILE* file, const void* data, JU::uint64 size, JU::uint64 offset)
+    {
+        static const JU::uint8 ZEROS[MeshCache::ALIGNMENT] = { 0 };
+
+        long position = std::ftell(file);
+        if (position < 0 || static_cast<JU::uint64>(position) > offset)
+            return false;
+
+        if (std::fwrite(ZEROS, 1, offset - position, file) != offset - position)
+            return false;
+
+        return size == 0 || std::fwrite(data, 1, size, file) == size;
+    }
+
+    /**
+    * @brief Map a whole file read only
+    *
+    * @detail The mapping stays valid after the handles of the file are closed
+    *
+    * @param filename Name of the file
+    * @param size     Bytes of the file
+    *
+    * @return First byte of the mapping (nullptr if the file could not be opened or mapped)
+    */
+    const JU::uint8* mapFile(const char* filename, std::size_t& size)
+    {
+#if defined(_WIN32)
+        // Shared for writing so MeshCache::updateSourceTime can patch the header of a mapped cache
+        HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+
+        if (!data)
+            return nullptr;
+
+        size = static_cast<std::size_t>(file_size.QuadPart);
+
+        return static_cast<const JU::uint8*>(data);
+#else
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (data == MAP_FAILED)
+            return nullptr;
+
+        size = info.st_size;
+
+        return static_cast<const JU::uint8*>(data);
+#endif
+    }
+
+    void unmapFile(const JU::uint8* data, std::size_t size)
+    {
+#if defined(_WIN32)
+        (void)size;
+        UnmapViewOfFile(data);
+#else
+        munmap(const_cast<JU::uint8*>(data), size);
+#endif
+    }
+}
+
+
+
+/**
+* @brief Default constructor
+*/
+MeshCache::MeshCache() : data_(nullptr), size_(0)
+{
+}
+
+
+
+/**
+* @brief Destructor
+*/
+MeshCache::~MeshCache()
+{
+    close();
+}
+
+
+
+/**
+* @brief Map a cache file and check its header
+*
+* @param filename Name of the cache file
+*
+* @return Successful? (false if the file is missing, truncated, or from another version)
+*/
+bool MeshCache::open(const char* filename)
+{
+    close();
+
+    std::size_t size = 0;
+    const JU::uint8* data = mapFile(filename, size);
+    if (!data)
+        return false;
+
+    data_ = data;
+    size_ = size;
+
+    if (size_ < sizeof(Header))
+    {
+        std::printf("Mesh cache %s is truncated\n", filename);
+        close();
+        return false;
+    }
+
+    const Header& header = getHeader();
+
+    if (header.magic_ != MAGIC || header.version_ != VERSION)
+    {
+        std::printf("Mesh cache %s has an unknown format or version\n", filename);
+        close();
+        return false;
+    }
+
+    if (header.index_size_ != 1 && header.index_size_ != 2 && header.index_size_ != 4)
+    {
+        std::printf("Mesh cache %s has an invalid index size\n", filename);
+        close();
+        return false;
+    }
+
+    JU::uint64 vertex_size = static_cast<JU::uint64>(header.num_vertices_) * header.stride_;
+    JU::uint64 index_size  = static_cast<JU::uint64>(header.num_triangles_) * 3 * header.index_size_;
+
+    if (header.vertex_offset_ + vertex_size > size_ || header.index_offset_ + index_size > size_ ||
+        header.name_offset_ + header.name_size_ > size_ || header.stride_ != VertexLayout(header.attributes_).getStride() ||
+        !checkSubMeshes())
+    {
+        std::printf("Mesh cache %s is corrupt\n", filename);
+        close();
+        return false;
+    }
+
+    filename_ = filename;
+
+    return true;
+}
+
+
+
+/**
+* @brief Unmap the file
+*/
+void MeshCache::close()
+{
+    if (data_)
+        unmapFile(data_, size_);
+
+    data_ = nullptr;
+    size_ = 0;
+    filename_.clear();
+}
+
+
+
+bool MeshCache::isOpen() const
+{
+    return data_ != nullptr;
+}
+
+
+
+/**
+* @brief Was the cache built from the current version of the source file?
+*
+* @detail The modification time is checked first; only if it differs is the source hashed (e.g. the file was touched or
+*         copied but not changed). If the hash still matches, the new time is written to the cache file so the source is
+*         not hashed again next time.
+*
+* @param source_filename Name of the file the cache was built from
+*
+* @return Is the cache still valid?
+*/
+bool MeshCache::isUpToDate(const char* source_filename) const
+{
+    if (!isOpen())
+        return false;
+
+    JU::uint64 time;
+    if (!getSourceTime(source_filename, time))
+        return false;
+
+    if (time == getHeader().source_time_)
+        return true;
+
+    JU::uint64 hash;
+    if (!computeSourceHash(source_filename, hash) || hash != getHeader().source_hash_)
+        return false;
+
+    updateSourceTime(time);
+
+    return true;
+}
+
+
+
+const MeshCache::Header& MeshCache::getHeader() const
+{
+    return *reinterpret_cast<const Header*>(data_);
+}
+
+
+
+const void* MeshCache::getVertices() const
+{
+    return data_ + getHeader().vertex_offset_;
+}
+
+
+
+const void* MeshCache::getIndices() const
+{
+    return data_ + getHeader().index_offset_;
+}
+
+
+
+std::string MeshCache::getName() const
+{
+    const Header& header = getHeader();
+
+    return std::string(reinterpret_cast<const char*>(data_ + header.name_offset_), header.name_size_);
+}
+
+
+
+/**
+* @brief Ranges of triangles of each source mesh (empty if the mesh had none)
+*/
+VectorSubMeshes MeshCache::getSubMeshes() const
+{
+    const Header& header = getHeader();
+    const SubMeshRecord* records = reinterpret_cast<const SubMeshRecord*>(data_ + header.submesh_offset_);
+    const char* names = reinterpret_cast<const char*>(records + header.num_submeshes_);
+
+    VectorSubMeshes vSubMeshes;
+    vSubMeshes.reserve(header.num_submeshes_);
+
+    for (JU::uint32 index = 0; index < header.num_submeshes_; ++index)
+    {
+        vSubMeshes.push_back(SubMesh(std::string(names, records[index].name_size_), records[index].first_triangle_, records[index].num_triangles_));
+        names += records[index].name_size_;
+    }
+
+    return vSubMeshes;
+}
+
+
+
+BoundingBox MeshCache::getBoundingBox() const
+{
+    const Header& header = getHeader();
+
+    return BoundingBox(glm::vec3(header.box_min_[0], header.box_min_[1], header.box_min_[2]),
+                       glm::vec3(header.box_max_[0], header.box_max_[1], header.box_max_[2]));
+}
+
+
+
+BoundingSphere MeshCache::getBoundingSphere() const
+{
+    const Header& header = getHeader();
+
+    return BoundingSphere(glm::vec3(header.sphere_center_[0], header.sphere_center_[1], header.sphere_center_[2]),
+                          header.sphere_radius_);
+}
+
+
+
+/**
+* @brief Write a mesh to a cache file
+*
+* @param filename        Name of the cache file
+* @param mesh            Mesh2 object (all the attributes it has data for are written)
+* @param source_filename Name of the file the mesh was imported from (for isUpToDate)
+*
+* @return Successful?
+*/
+bool MeshCache::write(const char* filename, const Mesh2& mesh, const char* source_filename)
+{
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+
+    if (!getSourceTime(source_filename, header.source_time_) || !computeSourceHash(source_filename, header.source_hash_))
+    {
+        std::printf("Could not read source file %s\n", source_filename);
+        return false;
+    }
+
+    VertexLayout layout (VertexLayout::fromMesh(mesh));
+    std::vector<JU::f32> vertices;
+    layout.interleave(mesh, vertices);
+
+    const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
+    JU::uint32 num_vertices = mesh.getVertexIndices().size();
+
+    std::vector<JU::uint8> indices;
+    switch (getIndexSize(num_vertices))
+    {
+        case 1:  narrowIndices<JU::uint8>(vTriangleIndices, indices);  break;
+        case 2:  narrowIndices<JU::uint16>(vTriangleIndices, indices); break;
+        default: narrowIndices<JU::uint32>(vTriangleIndices, indices); break;
+    }
+
+    const std::string& name = mesh.getName();
+    const VectorSubMeshes& vSubMeshes = mesh.getSubMeshes();
+    const BoundingBox& box = mesh.getBoundingBox();
+    const BoundingSphere& sphere = mesh.getBoundingSphere();
+
+    header.magic_         = MAGIC;
+    header.version_       = VERSION;
+    header.attributes_    = layout.getAttributes();
+    header.stride_        = layout.getStride();
+    header.num_vertices_  = num_vertices;
+    header.num_triangles_ = vTriangleIndices.size();
+    header.index_size_    = getIndexSize(num_vertices);
+    header.name_size_     = name.size();
+    header.vertex_offset_ = align(sizeof(Header));
+    header.index_offset_  = align(header.vertex_offset_ + vertices.size() * sizeof(JU::f32));
+    header.name_offset_   = header.index_offset_ + indices.size();
+    header.num_submeshes_ = vSubMeshes.size();
+    header.submesh_offset_ = align(header.name_offset_ + name.size());
+
+    std::vector<SubMeshRecord> records (vSubMeshes.size());
+    std::string submesh_names;
+    for (JU::uint32 index = 0; index < vSubMeshes.size(); ++index)
+    {
+        records[index].first_triangle_ = vSubMeshes[index].first_triangle_;
+        records[index].num_triangles_  = vSubMeshes[index].num_triangles_;
+        records[index].name_size_      = vSubMeshes[index].name_.size();
+        records[index].reserved_       = 0;
+        submesh_names += vSubMeshes[index].name_;
+    }
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        header.box_min_[axis]       = box.pmin_[axis];
+        header.box_max_[axis]       = box.pmax_[axis];
+        header.sphere_center_[axis] = sphere.center_[axis];
+    }
+    header.sphere_radius_ = sphere.radius_;
+
+    std::FILE* file = std::fopen(filename, "wb");
+    if (!file)
+    {
+        std::printf("Could not create mesh cache %s\n", filename);
+        return false;
+    }
+
+    bool success = std::fwrite(&header, sizeof(header), 1, file) == 1                                                    &&
+                   writePadded(file, vertices.empty() ? nullptr : &vertices[0], vertices.size() * sizeof(JU::f32), header.vertex_offset_) &&
+                   writePadded(file, indices.empty() ? nullptr : &indices[0], indices.size(), header.index_offset_)           &&
+                   writePadded(file, name.data(), name.size(), header.name_offset_)                                       &&
+                   writePadded(file, records.empty() ? nullptr : &records[0], records.size() * sizeof(SubMeshRecord), header.submesh_offset_) &&
+                   (submesh_names.empty() || std::fwrite(submesh_names.data(), 1, submesh_names.size(), file) == submesh_names.size());
+
+    success = (std::fclose(file) == 0) && success;
+
+    if (!success)
+    {
+        std::printf("Could not write mesh cache %s\n", filename);
+        std::remove(filename);
+    }
+
+    return success;
+}
+
+
+
+/**
+* @brief Do the submesh records and their names fit in the file, and their triangles in the mesh?
+*/
+bool MeshCache::checkSubMeshes() const
+{
+    const Header& header = getHeader();
+    JU::uint64 names_offset = header.submesh_offset_ + static_cast<JU::uint64>(header.num_submeshes_) * sizeof(SubMeshRecord);
+
+    if (header.num_submeshes_ == 0)
+        return true;
+    if (names_offset > size_)
+        return false;
+
+    const SubMeshRecord* records = reinterpret_cast<const SubMeshRecord*>(data_ + header.submesh_offset_);
+    JU::uint64 names_size = 0;
+
+    for (JU::uint32 index = 0; index < header.num_submeshes_; ++index)
+    {
+        if (static_cast<JU::uint64>(records[index].first_triangle_) + records[index].num_triangles_ > header.num_triangles_)
+            return false;
+
+        names_size += records[index].name_size_;
+    }
+
+    return names_offset + names_size <= size_;
+}
+
+
+
+/**
+* @brief Write a new source time into the header of the cache file
+*
+* @detail Written through a separate handle. Whether the mapped header then shows the new time depends on the platform
+*         (on Linux, pages of a private mapping that were never written do see later writes to the file), so nothing
+*         reads it back: at worst a later isUpToDate on the same mapping hashes the source again.
+*
+* @return Successful?
+*/
+bool MeshCache::updateSourceTime(JU::uint64 time) const
+{
+    std::FILE* file = std::fopen(filename_.c_str(), "r+b");
+    if (!file)
+        return false;
+
+    bool success = std::fseek(file, offsetof(Header, source_time_), SEEK_SET) == 0 &&
+                   std::fwrite(&time, sizeof(time), 1, file) == 1;
+
+    success = (std::fclose(file) == 0) && success;
+
+    return success;
+}
+
+
+
+/**
+* @brief Name of the cache file of a source file (next to it)
+*/
+std::string MeshCache::getCacheFilename(const char* source_filename)
+{
+    return std::string(source_filename) + CACHE_EXTENSION;
+}
+
+
+
+/**
+* @brief Modification time of a file
+*
+* @return Successful?
+*/
+bool MeshCache::getSourceTime(const char* filename, JU::uint64& time)
+{
+    struct stat info;
+
+    if (stat(filename, &info) != 0)
+        return false;
+
+    time = static_cast<JU::uint64>(info.st_mtime);
+
+    return true;
+}
+
+
+
+/**
+* @brief FNV-1a hash of the contents of a file
+*
+* @return Successful?
+*/
+bool MeshCache::computeSourceHash(const char* filename, JU::uint64& hash)
+{
+    std::FILE* file = std::fopen(filename, "rb");
+    if (!file)
+        return false;
+
+    hash = 14695981039346656037ULL;
+
+    JU::uint8 buffer[64 * 1024];
+    std::size_t bytes;
+
+    while ((bytes = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        for (std::size_t index = 0; index < bytes; ++index)
+        {
+            hash ^= buffer[index];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    std::fclose(file);
+
+    return true;
+}
+
+} /* namespace JU */
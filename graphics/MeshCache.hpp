@@ -0,0 +1,115 @@
+/*
+ * MeshCache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef MESHCACHE_HPP_
+#define MESHCACHE_HPP_
+
+// Local includes
+#include "../core/Defs.hpp"                 // uint32, uint64, f32
+#include "../collision/BoundingVolumes.hpp" // BoundingBox, BoundingSphere
+#include "GraphicsDefs.hpp"                 // VectorSubMeshes
+// Global includes
+#include <string>                           // std::string
+#include <cstddef>                          // std::size_t
+
+namespace JU
+{
+
+// Forward Declarations
+class Mesh2;
+
+/**
+ * @brief Binary mesh file already in the GPU layout, memory mapped when loaded
+ *
+ * @details The file is written once from a Mesh2 and then read without parsing: GLMesh uploads the vertex and index
+ *          blobs straight from the mapped pages. Layout (little endian, native floats):
+ *           + Header (128 bytes): magic, version, source file time and hash, vertex layout, counts, section offsets
+ *             and the bounds of the mesh
+ *           + Vertex blob: interleaved vertices (see VertexLayout), aligned to ALIGNMENT
+ *           + Index blob: triangle indices narrowed to 1, 2 or 4 bytes as GLMesh does, aligned to ALIGNMENT
+ *           + Name of the mesh (not null terminated)
+ *           + Submeshes: a SubMeshRecord per submesh, aligned to ALIGNMENT, then their names one after another (not
+ *             null terminated)
+ *
+ *          The source time and hash tell whether the file the cache was built from has changed since.
+ */
+class MeshCache
+{
+    public:
+        static const JU::uint32 MAGIC     = 0x434D554A;   //!< "JUMC"
+        static const JU::uint32 VERSION   = 2;
+        static const JU::uint32 ALIGNMENT = 16;
+
+        struct Header
+        {
+            JU::uint32 magic_;
+            JU::uint32 version_;
+            JU::uint64 source_time_;        //!< Modification time of the source file
+            JU::uint64 source_hash_;        //!< FNV-1a hash of the source file
+            JU::uint32 attributes_;         //!< VertexLayout attributes of the vertices
+            JU::uint32 stride_;             //!< Bytes per vertex
+            JU::uint32 num_vertices_;
+            JU::uint32 num_triangles_;
+            JU::uint32 index_size_;         //!< Bytes per index (1, 2 or 4)
+            JU::uint32 name_size_;          //!< Bytes of the name
+            JU::uint64 vertex_offset_;      //!< Offset of the vertex blob from the start of the file
+            JU::uint64 index_offset_;       //!< Offset of the index blob from the start of the file
+            JU::uint64 name_offset_;        //!< Offset of the name from the start of the file
+            JU::f32    box_min_[3];         //!< Bounding box
+            JU::f32    box_max_[3];
+            JU::f32    sphere_center_[3];   //!< Bounding sphere
+            JU::f32    sphere_radius_;
+            JU::uint32 num_submeshes_;      //!< Number of submesh records
+            JU::uint32 reserved_;
+            JU::uint64 submesh_offset_;     //!< Offset of the submesh records from the start of the file
+        };
+
+        struct SubMeshRecord
+        {
+            JU::uint32 first_triangle_;
+            JU::uint32 num_triangles_;
+            JU::uint32 name_size_;          //!< Bytes of the name
+            JU::uint32 reserved_;
+        };
+
+    public:
+        MeshCache();
+        ~MeshCache();
+
+        bool open(const char* filename);
+        void close();
+        bool isOpen() const;
+        bool isUpToDate(const char* source_filename) const;
+
+        const Header& getHeader() const;
+        const void* getVertices() const;
+        const void* getIndices() const;
+        std::string getName() const;
+        VectorSubMeshes getSubMeshes() const;
+        BoundingBox getBoundingBox() const;
+        BoundingSphere getBoundingSphere() const;
+
+        static bool write(const char* filename, const Mesh2& mesh, const char* source_filename);
+        static std::string getCacheFilename(const char* source_filename);
+        static bool getSourceTime(const char* filename, JU::uint64& time);
+        static bool computeSourceHash(const char* filename, JU::uint64& hash);
+
+    private:
+        MeshCache(const MeshCache&);                // Non-copyable: it owns the mapping
+        MeshCache& operator=(const MeshCache&);
+
+        bool checkSubMeshes() const;
+        bool updateSourceTime(JU::uint64 time) const;
+
+        const JU::uint8*    data_;      //!< Mapped file
+        std::size_t         size_;      //!< Size of the mapping in bytes
+        std::string         filename_;  //!< Name of the mapped file
+};
+
+} /* namespace JU */
+
+#endif /* MESHCACHE_HPP_ */
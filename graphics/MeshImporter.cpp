@@ -7,31 +7,159 @@
 
 #include "MeshImporter.hpp"
 #include "Mesh2.hpp"                // Mesh2
+#include "MeshCache.hpp"            // MeshCache
 #include <assimp/Importer.hpp>      //  C++ importer interface
 #include <assimp/scene.h>           // Output data structure
 #include <assimp/postprocess.h>     // Post processing flags
 #include <cstdio>                   // std::printf
+#include <thread>                   // std::thread
+#include <atomic>                   // std::atomic
+#include <algorithm>                // std::min, std::max
 
 namespace JU
 {
 
+namespace
+{
+    /**
+    * @brief Destination of the conversion of all the aiMeshes of a scene (preallocated to the exact total size)
+    */
+    struct ImportBuffers
+    {
+        VectorPositions        vPositions;
+        VectorNormals          vNormals;
+        VectorTexCoords        vTexCoords;
+        VectorTangents         vTangents;
+        VectorVertexIndices    vVertexIndices;
+        VectorTriangleIndices  vTriangleIndices;
+    };
+
+    /**
+    * @brief Convert an aiMesh into its range of the buffers
+    *
+    * @param pmesh           Assimp mesh (triangles only)
+    * @param vertex_offset   First vertex of the mesh in the buffers (its indices are offset by this)
+    * @param triangle_offset First triangle of the mesh in the buffers
+    * @param buffers         Destination
+    */
+    void convertMesh(const aiMesh* pmesh, JU::uint32 vertex_offset, JU::uint32 triangle_offset, ImportBuffers& buffers)
+    {
+        const uint32& num_vertices = pmesh->mNumVertices;
+        const uint32& num_faces    = pmesh->mNumFaces;
+
+        for (uint32 vertexid = 0; vertexid < num_vertices; vertexid++)
+        {
+            JU::uint32 index = vertex_offset + vertexid;
+
+            const aiVector3D& position = pmesh->mVertices[vertexid];
+            buffers.vPositions[index] = glm::vec3(position.x, position.y, position.z);
+
+            // Load vertex indices to position array, normal array and texture coordinates array
+            buffers.vVertexIndices[index] = VertexIndices(index, index, index);
+        }
+
+        if (!buffers.vNormals.empty())
+        {
+            for (uint32 vertexid = 0; vertexid < num_vertices; vertexid++)
+            {
+                const aiVector3D& normal = pmesh->mNormals[vertexid];
+                buffers.vNormals[vertex_offset + vertexid] = glm::vec3(normal.x, normal.y, normal.z);
+            }
+        }
+
+        // \todo It should support more than one UV channel (as Assimp does)
+        if (!buffers.vTexCoords.empty())
+        {
+            for (uint32 vertexid = 0; vertexid < num_vertices; vertexid++)
+            {
+                glm::vec2 tex_coord (0.0f);
+
+                if (pmesh->HasTextureCoords(0))
+                    tex_coord = glm::vec2(pmesh->mTextureCoords[0][vertexid].x, pmesh->mTextureCoords[0][vertexid].y);
+
+                buffers.vTexCoords[vertex_offset + vertexid] = tex_coord;
+            }
+        }
+
+        // The handedness of the tangent space goes in w (as Mesh2::computeTangents does)
+        if (!buffers.vTangents.empty())
+        {
+            for (uint32 vertexid = 0; vertexid < num_vertices; vertexid++)
+            {
+                const aiVector3D& n = pmesh->mNormals[vertexid];
+                const aiVector3D& t = pmesh->mTangents[vertexid];
+                const aiVector3D& b = pmesh->mBitangents[vertexid];
+
+                glm::vec3 normal (n.x, n.y, n.z), tangent (t.x, t.y, t.z), bitangent (b.x, b.y, b.z);
+                JU::f32 handedness = (glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f) ? -1.0f : 1.0f;
+
+                buffers.vTangents[vertex_offset + vertexid] = glm::vec4(tangent, handedness);
+            }
+        }
+
+        // Load face info into Mesh2 format
+        for (uint32 faceid = 0; faceid < num_faces; faceid++)
+        {
+            const unsigned int* indices = pmesh->mFaces[faceid].mIndices;
+
+            buffers.vTriangleIndices[triangle_offset + faceid] = TriangleIndices(vertex_offset + indices[0],
+                                                                                 vertex_offset + indices[1],
+                                                                                 vertex_offset + indices[2]);
+        }
+    }
+
+    /**
+    * @brief Worker: convert meshes until there are none left
+    */
+    void convertMeshes(const std::vector<const aiMesh*>& meshes,
+                       const std::vector<JU::uint32>&    vertex_offsets,
+                       const std::vector<JU::uint32>&    triangle_offsets,
+                       std::atomic<JU::uint32>&          next_mesh,
+                       ImportBuffers&                    buffers)
+    {
+        for (JU::uint32 index = next_mesh++; index < meshes.size(); index = next_mesh++)
+            convertMesh(meshes[index], vertex_offsets[index], triangle_offsets[index], buffers);
+    }
+
+    /**
+    * @brief Worker: import files until there are none left
+    *
+    * @param mesh_threads Threads each file import may use (the worker is one of them)
+    */
+    void importFiles(const std::vector<std::string>& filenames,
+                     std::vector<Mesh2>&             meshes,
+                     std::atomic<JU::uint32>&        next_file,
+                     std::vector<char>&              results,
+                     JU::uint32                      mesh_threads)
+    {
+        for (JU::uint32 index = next_file++; index < filenames.size(); index = next_file++)
+            results[index] = MeshImporter::import(filenames[index].c_str(), meshes[index], mesh_threads);
+    }
+}
+
+
+
 /**
 * @brief Assimp importer. Although Assimp will load a whole scene (meshes, animations, bones...)
-* we only read one mesh at this point (to be fixed later)
+* we only read the meshes at this point, merged into one Mesh2 with a submesh per aiMesh
 *
-* @param filename Name of the file with the scene to import
-* @param mesh     Mesh to store the object loaded
+* @detail The output offsets of every aiMesh are prefix-summed first, so the buffers are allocated once to their exact
+*         size and the meshes are converted in parallel, each into its own range.
+*
+* @param filename    Name of the file with the scene to import
+* @param mesh        Mesh to store the object loaded
+* @param num_threads Number of threads converting meshes and computing tangents (the calling thread is one of them)
 */
-bool MeshImporter::import(const char* filename, Mesh2& mesh)
+bool MeshImporter::import(const char* filename, Mesh2& mesh, JU::uint32 num_threads)
 {
     // Create an instance of the Importer class
     Assimp::Importer importer;
     // And have it read the given file with some example postprocessing
     // Usually - if speed is not the most important aspect for you - you'll
     // propably to request more postprocessing than we do in this example.
+    // Tangents are computed after welding by Mesh2::computeTangents (in parallel) unless the file has them
     const aiScene* scene = importer.ReadFile(filename,
                                              aiProcess_GenNormals             |
-                                             aiProcess_CalcTangentSpace       |
                                              aiProcess_Triangulate            |
                                              aiProcess_JoinIdenticalVertices  |
                                              aiProcess_SortByPType);
@@ -40,7 +168,7 @@ bool MeshImporter::import(const char* filename, Mesh2& mesh)
     if( !scene)
     {
         //DoTheErrorLogging( importer.GetErrorString());
-        std::printf("Could not import file");
+        std::printf("Could not import file %s: %s\n", filename, importer.GetErrorString());
         return false;
     }
 
@@ -56,96 +184,182 @@ bool MeshImporter::import(const char* filename, Mesh2& mesh)
     {
         std::printf("Scene in file %s contains %i meshes\n", filename, scene->mNumMeshes);
 
-        VectorPositions        vPositions;
-        VectorNormals          vNormals;
-        VectorTexCoords        vTexCoords;
-        VectorVertexIndices    vVertexIndices;
-        VectorTriangleIndices  vTriangleIndices;
+        // Triangle meshes and their offsets in the merged buffers
+        std::vector<const aiMesh*> meshes;
+        std::vector<JU::uint32>    vertex_offsets (1, 0);
+        std::vector<JU::uint32>    triangle_offsets (1, 0);
+
+        bool has_normals   = true;
+        bool has_tex       = false;
+        bool has_tangents  = true;
 
         for (uint32 i = 0; i < scene->mNumMeshes; i++)
         {
-
             const aiMesh* pmesh = scene->mMeshes[i];
 
-            std::printf("Number of color channels = %i\n", pmesh->GetNumColorChannels());
-            std::printf("Number of UV channels    = %i\n", pmesh->GetNumUVChannels());
-            std::printf("Has positions  = %s\n", pmesh->HasPositions() ? "true" : "false");
-            std::printf("Has faces      = %s\n", pmesh->HasFaces() ? "true" : "false");
-            std::printf("Has normals    = %s\n", pmesh->HasNormals() ? "true" : "false");
-            std::printf("Has tan/bit    = %s\n", pmesh->HasTangentsAndBitangents() ? "true" : "false");
-            std::printf("Has bones      = %s\n", pmesh->HasBones() ? "true" : "false");
-
-            std::printf("Number of vertices = %i\n", pmesh->mNumVertices);
-            std::printf("Number of faces    = %i\n", pmesh->mNumFaces);
-            std::printf("Number of indices per face = %i\n", pmesh->mFaces[0].mNumIndices);
-
-            if (!pmesh->mNumVertices || !pmesh->mNumFaces)
+            // SortByPType splits points and lines into their own meshes
+            if (pmesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE || !pmesh->mNumVertices || !pmesh->mNumFaces)
             {
-                std::printf("Zero vertices or faces (%i, %i)\n", pmesh->mNumVertices, pmesh->mNumFaces);
-                exit(EXIT_FAILURE);
+                std::printf("Skipping mesh %i (%i vertices, %i faces, primitive types 0x%x)\n", i, pmesh->mNumVertices, pmesh->mNumFaces, pmesh->mPrimitiveTypes);
+                continue;
             }
 
-            if (pmesh->mFaces[0].mNumIndices != 3)
-            {
-                std::printf("Number of vertices (%i) != 3\n", pmesh->mFaces[0].mNumIndices);
-                exit(EXIT_FAILURE);
-            }
+            meshes.push_back(pmesh);
+            vertex_offsets.push_back(vertex_offsets.back() + pmesh->mNumVertices);
+            triangle_offsets.push_back(triangle_offsets.back() + pmesh->mNumFaces);
 
-            const uint32& num_vertices = pmesh->mNumVertices;
-            const uint32& num_faces    = pmesh->mNumFaces;
+            has_normals  = has_normals && pmesh->HasNormals();
+            has_tex      = has_tex || pmesh->HasTextureCoords(0);
+            has_tangents = has_tangents && pmesh->HasTangentsAndBitangents();
+        }
 
-            uint32 last_vtx_index = vPositions.size();
+        if (meshes.empty())
+        {
+            std::printf("Scene in file %s has no triangle meshes\n", filename);
+            return false;
+        }
 
-            vPositions.resize(vPositions.size() + num_vertices);
-            // Load vertices into Mesh2 format
-            memcpy(&vPositions[last_vtx_index], pmesh->mVertices, sizeof(pmesh->mVertices[0]) *  num_vertices);
+        JU::uint32 total_vertices  = vertex_offsets.back();
+        JU::uint32 total_triangles = triangle_offsets.back();
 
-            if (pmesh->HasNormals())
-            {
-                vNormals.resize(vNormals.size() + num_vertices);
-                // Load normals into Mesh2 format
-                memcpy(&vNormals[last_vtx_index], pmesh->mNormals, sizeof(pmesh->mNormals[0]) * num_vertices);
-            }
+        std::printf("Number of vertices = %i\n", total_vertices);
+        std::printf("Number of faces    = %i\n", total_triangles);
 
-            // \todo It should support more than one UV channel (as Assimp does)
-            if (pmesh->HasTextureCoords(0))
-            {
-                vTexCoords.resize(vTexCoords.size() + num_vertices);
-                // Load texture coordinates into Mesh2 format
-                memcpy(&vTexCoords[last_vtx_index], pmesh->mTextureCoords, sizeof(pmesh->mTextureCoords[0]) * num_vertices);
-            }
+        ImportBuffers buffers;
+        buffers.vPositions.resize(total_vertices);
+        buffers.vVertexIndices.resize(total_vertices);
+        buffers.vTriangleIndices.resize(total_triangles);
+        if (has_normals)
+            buffers.vNormals.resize(total_vertices);
+        if (has_tex)
+            buffers.vTexCoords.resize(total_vertices);
+        if (has_normals && has_tangents)
+            buffers.vTangents.resize(total_vertices);
 
-            vVertexIndices.resize(vVertexIndices.size() + num_vertices);
-            vTriangleIndices.resize(vTriangleIndices.size() + num_faces);
+        JU::uint32 convert_threads = std::max(1u, std::min(num_threads, static_cast<JU::uint32>(meshes.size())));
 
-            // Load vertex indices to position array, normal array and texture coordinates array
-            for (uint32 vertexid = 0; vertexid < num_vertices; vertexid++)
-            {
-                vVertexIndices[vertexid].position_ = vertexid;
-                vVertexIndices[vertexid].normal_   = vertexid;
-                vVertexIndices[vertexid].tex_      = vertexid;
-            }
+        std::atomic<JU::uint32> next_mesh (0);
+        std::vector<std::thread> threads;
+        for (JU::uint32 thread = 1; thread < convert_threads; ++thread)
+            threads.push_back(std::thread(convertMeshes, std::cref(meshes), std::cref(vertex_offsets), std::cref(triangle_offsets), std::ref(next_mesh), std::ref(buffers)));
 
-            // Load face info into Mesh2 format
-            for (uint32 faceid = 0; faceid < num_faces; faceid++)
-            {
-                vTriangleIndices[faceid].v0_ = pmesh->mFaces[faceid].mIndices[0];
-                vTriangleIndices[faceid].v1_ = pmesh->mFaces[faceid].mIndices[1];
-                vTriangleIndices[faceid].v2_ = pmesh->mFaces[faceid].mIndices[2];
-            }
-        }
+        convertMeshes(meshes, vertex_offsets, triangle_offsets, next_mesh, buffers);
+
+        for (JU::uint32 thread = 0; thread < threads.size(); ++thread)
+            threads[thread].join();
+
+        VectorSubMeshes vSubMeshes;
+        for (JU::uint32 index = 0; index < meshes.size(); ++index)
+            vSubMeshes.push_back(SubMesh(meshes[index]->mName.C_Str(), triangle_offsets[index], meshes[index]->mNumFaces));
 
         //mesh = Mesh2(name, vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
         mesh.setName(filename);
-        mesh.setPositions(vPositions);
-        mesh.setNormals(vNormals);
-        mesh.setTexCoords(vTexCoords);
-        mesh.setVertexIndices(vVertexIndices);
-        mesh.setTriangleIndices(vTriangleIndices);
+        mesh.setPositions(buffers.vPositions, num_threads);
+        mesh.setNormals(buffers.vNormals);
+        mesh.setTexCoords(buffers.vTexCoords);
+        mesh.setTangents(buffers.vTangents);
+        mesh.setVertexIndices(buffers.vVertexIndices);
+        mesh.setTriangleIndices(buffers.vTriangleIndices);
+        mesh.setSubMeshes(vSubMeshes);
+        // Assimp only joins the vertices of each mesh, so the copies along the seams between them are merged here
+        mesh.weldVertices(VertexWelder::DEFAULT_EPSILON, num_threads);
+        if (has_normals && has_tex && !has_tangents)
+            mesh.computeTangents(num_threads);
     }
 
     // We're done. Everything will be cleaned up by the importer destructor
     return true;
 }
 
+
+
+/**
+* @brief Import a batch of files concurrently (one Assimp importer per file)
+*
+* @param filenames   Names of the files to import
+* @param meshes      One Mesh2 per file
+* @param num_threads Number of threads importing files (the calling thread is one of them). They are split between the
+*                    files and the conversion of each file, so the batch never runs more than this many.
+*
+* @return Were all the files imported?
+*/
+bool MeshImporter::import(const std::vector<std::string>& filenames, std::vector<Mesh2>& meshes, JU::uint32 num_threads)
+{
+    meshes.clear();
+    meshes.resize(filenames.size());
+
+    std::vector<char> results (filenames.size(), false);
+
+    JU::uint32 file_threads = std::max(1u, std::min(num_threads, static_cast<JU::uint32>(filenames.size())));
+    JU::uint32 mesh_threads = std::max(1u, num_threads / file_threads);
+
+    std::atomic<JU::uint32> next_file (0);
+    std::vector<std::thread> threads;
+    for (JU::uint32 thread = 1; thread < file_threads; ++thread)
+        threads.push_back(std::thread(importFiles, std::cref(filenames), std::ref(meshes), std::ref(next_file), std::ref(results), mesh_threads));
+
+    importFiles(filenames, meshes, next_file, results, mesh_threads);
+
+    for (JU::uint32 thread = 0; thread < threads.size(); ++thread)
+        threads[thread].join();
+
+    bool success = true;
+    for (JU::uint32 index = 0; index < results.size(); ++index)
+    {
+        if (!results[index])
+        {
+            std::printf("Could not import file %s\n", filenames[index].c_str());
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+
+
+/**
+* @brief Load a mesh from its binary cache (see MeshCache), importing it with Assimp only if the cache is missing or
+*        older than the source file
+*
+* @detail The cache file lives next to the source file. When it has to be (re)built, the mesh is imported, written
+*         to the cache and the new cache is mapped, so the result is always a mapped cache ready for GLMesh::init.
+*
+* @param filename    Name of the file with the scene to import
+* @param cache       Cache mapped for the mesh
+* @param num_threads Number of threads importing the mesh if the cache has to be rebuilt
+*
+* @return Successful?
+*/
+bool MeshImporter::importCached(const char* filename, MeshCache& cache, JU::uint32 num_threads)
+{
+    std::string cache_filename (MeshCache::getCacheFilename(filename));
+
+    if (cache.open(cache_filename.c_str()) && cache.isUpToDate(filename))
+        return true;
+
+    cache.close();
+
+    Mesh2 mesh;
+    if (!import(filename, mesh, num_threads))
+        return false;
+
+    if (!MeshCache::write(cache_filename.c_str(), mesh, filename))
+        return false;
+
+    return cache.open(cache_filename.c_str());
+}
+
+
+
+/**
+* @brief Default number of threads of the importer: one per hardware thread
+*
+* @return Number of hardware threads (1 if it cannot be queried)
+*/
+JU::uint32 MeshImporter::getDefaultNumThreads()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
 } /* namespace JU */
@@ -8,17 +8,26 @@
 #ifndef MESHIMPORTER_HPP_
 #define MESHIMPORTER_HPP_
 
+// Local includes
+#include "../core/Defs.hpp"     // uint32
+// Global includes
+#include <vector>               // std::vector
+#include <string>               // std::string
 
 namespace JU
 {
 
 // Forward Declarations
 class Mesh2;
+class MeshCache;
 
 class MeshImporter
 {
     public:
-        static bool import(const char* filename, Mesh2& mesh);
+        static bool import(const char* filename, Mesh2& mesh, JU::uint32 num_threads = getDefaultNumThreads());
+        static bool import(const std::vector<std::string>& filenames, std::vector<Mesh2>& meshes, JU::uint32 num_threads = getDefaultNumThreads());
+        static bool importCached(const char* filename, MeshCache& cache, JU::uint32 num_threads = getDefaultNumThreads());
+        static JU::uint32 getDefaultNumThreads();
 };
 
 } /* namespace JU */
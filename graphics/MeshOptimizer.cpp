@@ -0,0 +1,382 @@
+/*
+ * MeshOptimizer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "MeshOptimizer.hpp"
+#include "Mesh2.hpp"        // Mesh2
+// Global includes
+#include <vector>           // std::vector
+#include <cmath>            // std::pow
+#include <utility>          // std::pair
+#include <algorithm>        // std::sort, std::min, std::max
+
+namespace JU
+{
+
+namespace
+{
+    const JU::uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    // Forsyth's scoring parameters
+    const JU::uint32 LRU_CACHE_SIZE       = 32;
+    const JU::f32    CACHE_DECAY_POWER    = 1.5f;
+    const JU::f32    LAST_TRIANGLE_SCORE  = 0.75f;
+    const JU::f32    VALENCE_BOOST_SCALE  = 2.0f;
+    const JU::f32    VALENCE_BOOST_POWER  = 0.5f;
+
+    /**
+    * @brief Score of a vertex: high if it is near the front of the cache or has few triangles left (so finishing it off
+    *        frees a cache slot)
+    */
+    JU::f32 computeVertexScore(JU::int32 cache_position, JU::uint32 live_triangles)
+    {
+        if (live_triangles == 0)
+            return -1.0f;
+
+        JU::f32 score = 0.0f;
+
+        if (cache_position >= 0)
+        {
+            // The vertices of the last triangle get a fixed score so the next triangle does not depend on their order
+            if (cache_position < 3)
+                score = LAST_TRIANGLE_SCORE;
+            else
+                score = std::pow(1.0f - (cache_position - 3) * (1.0f / (LRU_CACHE_SIZE - 3)), CACHE_DECAY_POWER);
+        }
+
+        return score + VALENCE_BOOST_SCALE * std::pow(static_cast<JU::f32>(live_triangles), -VALENCE_BOOST_POWER);
+    }
+
+    inline const VertexIndex* getVertices(const TriangleIndices& triangle)
+    {
+        return &triangle.v0_;
+    }
+}
+
+
+
+/**
+* @brief Reorder the triangles and then the vertices
+*
+* @param mesh   Mesh2 object
+* @param before Cache statistics before the optimization (optional)
+* @param after  Cache statistics after the optimization (optional)
+*/
+void MeshOptimizer::optimize(Mesh2& mesh, CacheStats* before, CacheStats* after)
+{
+    if (before)
+        *before = computeCacheStats(mesh);
+
+    optimizeTriangleOrder(mesh);
+    optimizeVertexOrder(mesh);
+
+    if (after)
+        *after = computeCacheStats(mesh);
+}
+
+
+
+/**
+* @brief Reorder the triangles for the post-transform vertex cache (Forsyth)
+*
+* @detail The triangles of each submesh stay in the range of the submesh. Triangles outside every submesh are kept
+*         in place.
+*
+* @param mesh Mesh2 object
+*/
+void MeshOptimizer::optimizeTriangleOrder(Mesh2& mesh)
+{
+    const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
+
+    JU::uint32 num_triangles = vTriangleIndices.size();
+    JU::uint32 num_vertices  = mesh.getVertexIndices().size();
+
+    if (num_triangles == 0)
+        return;
+
+    // Triangles of each vertex (only the first 'live_triangles' of each list are not emitted yet)
+    std::vector<JU::uint32> live_triangles (num_vertices, 0);
+    for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
+        for (int corner = 0; corner < 3; ++corner)
+            ++live_triangles[getVertices(vTriangleIndices[triangle])[corner]];
+
+    std::vector<JU::uint32> first_triangle (num_vertices + 1, 0);
+    for (JU::uint32 vertex = 0; vertex < num_vertices; ++vertex)
+        first_triangle[vertex + 1] = first_triangle[vertex] + live_triangles[vertex];
+
+    std::vector<JU::uint32> vertex_triangles (first_triangle[num_vertices]);
+    std::vector<JU::uint32> fill (first_triangle.begin(), first_triangle.end() - 1);
+    for (JU::uint32 triangle = 0; triangle < num_triangles; ++triangle)
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            JU::uint32 vertex = getVertices(vTriangleIndices[triangle])[corner];
+            vertex_triangles[fill[vertex]++] = triangle;
+        }
+
+    std::vector<JU::int32> cache_position (num_vertices, -1);
+    std::vector<JU::f32>   vertex_score (num_vertices);
+    for (JU::uint32 vertex = 0; vertex < num_vertices; ++vertex)
+        vertex_score[vertex] = computeVertexScore(-1, live_triangles[vertex]);
+
+    std::vector<bool>       emitted (num_triangles, false);
+    VectorTriangleIndices   vOptimized;
+    vOptimized.reserve(num_triangles);
+
+    std::vector<JU::uint32> cache, new_cache;
+    cache.reserve(LRU_CACHE_SIZE + 3);
+    new_cache.reserve(LRU_CACHE_SIZE + 3);
+
+    // Submesh ranges of triangles, in order
+    std::vector<std::pair<JU::uint32, JU::uint32> > submesh_ranges;
+    const VectorSubMeshes& vSubMeshes = mesh.getSubMeshes();
+
+    for (VectorSubMeshesConstIter iter = vSubMeshes.begin(); iter != vSubMeshes.end(); ++iter)
+        submesh_ranges.push_back(std::make_pair(iter->first_triangle_, iter->first_triangle_ + iter->num_triangles_));
+    if (submesh_ranges.empty())
+        submesh_ranges.push_back(std::make_pair(0u, num_triangles));
+    std::sort(submesh_ranges.begin(), submesh_ranges.end());
+
+    // Ranges covering all the triangles: the submeshes are reordered independently, the triangles outside every
+    // submesh are kept in place
+    std::vector<std::pair<JU::uint32, JU::uint32> > ranges;
+    std::vector<bool> reorder;
+    JU::uint32 covered = 0;
+
+    for (JU::uint32 range = 0; range < submesh_ranges.size(); ++range)
+    {
+        JU::uint32 range_begin = std::min(std::max(submesh_ranges[range].first, covered), num_triangles);
+        JU::uint32 range_end   = std::min(std::max(submesh_ranges[range].second, range_begin), num_triangles);
+
+        if (covered < range_begin)
+        {
+            ranges.push_back(std::make_pair(covered, range_begin));
+            reorder.push_back(false);
+        }
+        if (range_begin < range_end)
+        {
+            ranges.push_back(std::make_pair(range_begin, range_end));
+            reorder.push_back(true);
+        }
+
+        covered = std::max(covered, range_end);
+    }
+
+    if (covered < num_triangles)
+    {
+        ranges.push_back(std::make_pair(covered, num_triangles));
+        reorder.push_back(false);
+    }
+
+    for (JU::uint32 range = 0; range < ranges.size(); ++range)
+    {
+        JU::uint32 range_begin    = ranges[range].first;
+        JU::uint32 range_end      = ranges[range].second;
+        JU::uint32 next_unemitted = range_begin;
+        JU::uint32 best_triangle  = INVALID_INDEX;
+
+        if (!reorder[range])
+        {
+            for (JU::uint32 triangle = range_begin; triangle < range_end; ++triangle)
+            {
+                vOptimized.push_back(vTriangleIndices[triangle]);
+                emitted[triangle] = true;
+            }
+            continue;
+        }
+
+        for (JU::uint32 count = range_begin; count < range_end; ++count)
+        {
+            // Nothing in the cache has triangles left: start again from the first triangle not emitted yet
+            if (best_triangle == INVALID_INDEX)
+            {
+                while (emitted[next_unemitted])
+                    ++next_unemitted;
+                best_triangle = next_unemitted;
+            }
+
+            const VertexIndex* vertices = getVertices(vTriangleIndices[best_triangle]);
+            vOptimized.push_back(vTriangleIndices[best_triangle]);
+            emitted[best_triangle] = true;
+
+            // Remove the triangle from the lists of its vertices
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                JU::uint32 vertex = vertices[corner];
+                JU::uint32 begin  = first_triangle[vertex];
+                JU::uint32 end    = begin + live_triangles[vertex];
+
+                for (JU::uint32 index = begin; index < end; ++index)
+                {
+                    if (vertex_triangles[index] == best_triangle)
+                    {
+                        vertex_triangles[index] = vertex_triangles[end - 1];
+                        --live_triangles[vertex];
+                        break;
+                    }
+                }
+            }
+
+            // Move the vertices of the triangle to the front of the LRU cache
+            new_cache.clear();
+            for (int corner = 0; corner < 3; ++corner)
+                new_cache.push_back(vertices[corner]);
+            for (JU::uint32 index = 0; index < cache.size(); ++index)
+                if (cache[index] != vertices[0] && cache[index] != vertices[1] && cache[index] != vertices[2])
+                    new_cache.push_back(cache[index]);
+
+            // Evicted vertices
+            for (JU::uint32 index = LRU_CACHE_SIZE; index < new_cache.size(); ++index)
+            {
+                cache_position[new_cache[index]] = -1;
+                vertex_score[new_cache[index]]   = computeVertexScore(-1, live_triangles[new_cache[index]]);
+            }
+            if (new_cache.size() > LRU_CACHE_SIZE)
+                new_cache.resize(LRU_CACHE_SIZE);
+
+            cache.swap(new_cache);
+
+            for (JU::uint32 index = 0; index < cache.size(); ++index)
+            {
+                cache_position[cache[index]] = index;
+                vertex_score[cache[index]]   = computeVertexScore(index, live_triangles[cache[index]]);
+            }
+
+            // Best triangle among the ones using a vertex in the cache
+            best_triangle = INVALID_INDEX;
+            JU::f32 best_score = -1.0f;
+
+            for (JU::uint32 index = 0; index < cache.size(); ++index)
+            {
+                JU::uint32 vertex = cache[index];
+
+                for (JU::uint32 entry = first_triangle[vertex]; entry < first_triangle[vertex] + live_triangles[vertex]; ++entry)
+                {
+                    JU::uint32 triangle = vertex_triangles[entry];
+                    if (triangle < range_begin || triangle >= range_end)
+                        continue;
+
+                    const VertexIndex* v = getVertices(vTriangleIndices[triangle]);
+                    JU::f32 score = vertex_score[v[0]] + vertex_score[v[1]] + vertex_score[v[2]];
+
+                    if (score > best_score)
+                    {
+                        best_score    = score;
+                        best_triangle = triangle;
+                    }
+                }
+            }
+        }
+    }
+
+    mesh.setTriangleIndices(vOptimized);
+}
+
+
+
+/**
+* @brief Renumber the vertices in the order the triangles first use them (for the pre-transform vertex fetch)
+*
+* @detail Vertices that no triangle uses are dropped. Tangents, which are stored per vertex, follow their vertex.
+*
+* @param mesh Mesh2 object
+*/
+void MeshOptimizer::optimizeVertexOrder(Mesh2& mesh)
+{
+    const VectorVertexIndices&   vVertexIndices   = mesh.getVertexIndices();
+    const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
+    const VectorTangents&        vTangents        = mesh.getTangents();
+
+    JU::uint32 num_vertices = vVertexIndices.size();
+    bool has_tangents = (vTangents.size() == num_vertices);
+
+    std::vector<JU::uint32> remap (num_vertices, INVALID_INDEX);
+    VectorVertexIndices     vNewVertexIndices;
+    VectorTangents          vNewTangents;
+    VectorTriangleIndices   vNewTriangleIndices (vTriangleIndices);
+
+    vNewVertexIndices.reserve(num_vertices);
+    if (has_tangents)
+        vNewTangents.reserve(num_vertices);
+
+    for (JU::uint32 triangle = 0; triangle < vNewTriangleIndices.size(); ++triangle)
+    {
+        VertexIndex* vertices = &vNewTriangleIndices[triangle].v0_;
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            JU::uint32 vertex = vertices[corner];
+
+            if (remap[vertex] == INVALID_INDEX)
+            {
+                remap[vertex] = vNewVertexIndices.size();
+                vNewVertexIndices.push_back(vVertexIndices[vertex]);
+                if (has_tangents)
+                    vNewTangents.push_back(vTangents[vertex]);
+            }
+
+            vertices[corner] = remap[vertex];
+        }
+    }
+
+    mesh.setVertexIndices(vNewVertexIndices);
+    mesh.setTriangleIndices(vNewTriangleIndices);
+    if (has_tangents)
+        mesh.setTangents(vNewTangents);
+}
+
+
+
+/**
+* @brief Simulate a FIFO post-transform cache over the triangles of the mesh
+*
+* @param mesh       Mesh2 object
+* @param cache_size Number of entries of the simulated cache
+*
+* @return ACMR and ATVR
+*/
+MeshOptimizer::CacheStats MeshOptimizer::computeCacheStats(const Mesh2& mesh, JU::uint32 cache_size)
+{
+    const VectorTriangleIndices& vTriangleIndices = mesh.getTriangleIndices();
+
+    JU::uint32 num_vertices = mesh.getVertexIndices().size();
+
+    // A vertex is in the cache if fewer than 'cache_size' misses happened since it was loaded
+    std::vector<JU::uint32> loaded_at (num_vertices, 0);
+    std::vector<bool>       used (num_vertices, false);
+    JU::uint32 misses = 0;
+    JU::uint32 num_used = 0;
+
+    for (VectorTriangleIndicesConstIter iter = vTriangleIndices.begin(); iter != vTriangleIndices.end(); ++iter)
+    {
+        const VertexIndex* vertices = getVertices(*iter);
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            JU::uint32 vertex = vertices[corner];
+
+            if (!used[vertex])
+            {
+                used[vertex] = true;
+                ++num_used;
+            }
+            else if (misses - loaded_at[vertex] < cache_size)
+            {
+                continue;
+            }
+
+            loaded_at[vertex] = misses++;
+        }
+    }
+
+    CacheStats stats;
+    stats.acmr_ = vTriangleIndices.empty() ? 0.0f : static_cast<JU::f32>(misses) / vTriangleIndices.size();
+    stats.atvr_ = num_used == 0 ? 0.0f : static_cast<JU::f32>(misses) / num_used;
+
+    return stats;
+}
+
+} /* namespace JU */
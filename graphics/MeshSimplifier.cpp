@@ -0,0 +1,679 @@
+/*
+ * MeshSimplifier.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "MeshSimplifier.hpp"
+#include "Mesh2.hpp"            // Mesh2
+#include "MeshOptimizer.hpp"    // MeshOptimizer
+// Global includes
+#include <glm/glm.hpp>          // glm::vec3, glm::cross, glm::dot
+#include <algorithm>            // std::sort, std::unique, std::max
+#include <cmath>                // std::sqrt
+#include <sstream>              // std::ostringstream
+#include <utility>              // std::pair, std::swap
+
+namespace JU
+{
+
+const JU::f32 MeshSimplifier::DEFAULT_MAX_RELATIVE_ERROR = 0.05f;
+
+namespace
+{
+    const JU::f64 BORDER_WEIGHT = 10.0; //!< Weight of the planes that keep borders and seams in place
+
+    enum EdgeType
+    {
+        INTERIOR_EDGE,      //!< Two triangles with the same vertices
+        SEAM_EDGE,          //!< Two triangles with different attributes at the same positions
+        BORDER_EDGE,        //!< One triangle
+        NON_MANIFOLD_EDGE   //!< More than two triangles
+    };
+
+    enum PositionType
+    {
+        INTERIOR_POSITION,  //!< Can collapse into any neighbour
+        SEAM_POSITION,      //!< On a single seam or border: can only collapse along it
+        LOCKED_POSITION     //!< Corner of seams or borders, or non-manifold
+    };
+
+    /**
+    * @brief Symmetric 4x4 matrix accumulating the planes (n, d) as (n, d)(n, d)^T, and the total weight of the planes
+    */
+    struct Quadric
+    {
+        Quadric() : weight_(0.0) { for (int i = 0; i < 10; ++i) m_[i] = 0.0; }
+
+        void addPlane(const glm::vec3& normal, JU::f32 distance, JU::f64 weight)
+        {
+            JU::f64 a = normal.x, b = normal.y, c = normal.z, d = distance;
+
+            m_[0] += weight * a * a; m_[1] += weight * a * b; m_[2] += weight * a * c; m_[3] += weight * a * d;
+            m_[4] += weight * b * b; m_[5] += weight * b * c; m_[6] += weight * b * d;
+            m_[7] += weight * c * c; m_[8] += weight * c * d;
+            m_[9] += weight * d * d;
+
+            weight_ += weight;
+        }
+
+        Quadric& operator+=(const Quadric& rhs)
+        {
+            for (int i = 0; i < 10; ++i) m_[i] += rhs.m_[i];
+            weight_ += rhs.weight_;
+            return *this;
+        }
+
+        /**
+        * @brief Weighted mean of the squared distances from a point to the planes
+        */
+        JU::f64 evaluate(const glm::vec3& p) const
+        {
+            if (weight_ == 0.0)
+                return 0.0;
+
+            JU::f64 x = p.x, y = p.y, z = p.z;
+
+            JU::f64 error = m_[0] * x * x + 2.0 * m_[1] * x * y + 2.0 * m_[2] * x * z + 2.0 * m_[3] * x
+                          + m_[4] * y * y + 2.0 * m_[5] * y * z + 2.0 * m_[6] * y
+                          + m_[7] * z * z + 2.0 * m_[8] * z
+                          + m_[9];
+
+            return error > 0.0 ? error / weight_ : 0.0;
+        }
+
+        JU::f64 m_[10];
+        JU::f64 weight_;
+    };
+
+    struct Edge
+    {
+        JU::uint64  key_;       //!< Positions of the ends (lower one in the high bits)
+        VertexIndex v0_;        //!< Vertex at the lower position
+        VertexIndex v1_;        //!< Vertex at the higher position
+        JU::uint32  triangle_;  //!< Triangle the edge belongs to
+
+        bool operator<(const Edge& rhs) const { return key_ < rhs.key_; }
+    };
+
+    struct Collapse
+    {
+        JU::f64     cost_;
+        JU::uint32  from_;      //!< Position that disappears
+        JU::uint32  to_;        //!< Position that survives
+        EdgeType    type_;
+
+        bool operator<(const Collapse& rhs) const { return cost_ < rhs.cost_; }
+    };
+
+    /**
+    * @brief Triangles around each position and type of each edge, for the current triangles
+    */
+    struct Adjacency
+    {
+        std::vector<JU::uint32>     first_;     //!< CSR offsets into 'triangles_' (one per position, plus one)
+        std::vector<JU::uint32>     triangles_; //!< Triangles around each position
+        std::vector<Edge>           edges_;     //!< Edges of all the triangles, sorted by key
+        std::vector<PositionType>   types_;     //!< Type of each position
+    };
+
+    inline JU::uint32 getPosition(const VectorVertexIndices& vVertexIndices, VertexIndex vertex)
+    {
+        return vVertexIndices[vertex].position_;
+    }
+
+    inline glm::vec3 computeNormal(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+    {
+        return glm::cross(p1 - p0, p2 - p0);
+    }
+
+    /**
+    * @brief Apply a vertex remap to the triangles and drop the ones left with two corners at the same position (and
+    *        their entries in 'submeshes', the submesh of each triangle)
+    */
+    void remapTriangles(const std::vector<VertexIndex>& remap,
+                        const VectorVertexIndices&      vVertexIndices,
+                        VectorTriangleIndices&          vTriangles,
+                        std::vector<JU::uint32>&        submeshes)
+    {
+        JU::uint32 num_kept = 0;
+
+        for (JU::uint32 triangle = 0; triangle < vTriangles.size(); ++triangle)
+        {
+            TriangleIndices remapped (remap[vTriangles[triangle].v0_], remap[vTriangles[triangle].v1_], remap[vTriangles[triangle].v2_]);
+
+            JU::uint32 p0 = getPosition(vVertexIndices, remapped.v0_);
+            JU::uint32 p1 = getPosition(vVertexIndices, remapped.v1_);
+            JU::uint32 p2 = getPosition(vVertexIndices, remapped.v2_);
+
+            if (p0 != p1 && p1 != p2 && p2 != p0)
+            {
+                submeshes[num_kept]    = submeshes[triangle];
+                vTriangles[num_kept++] = remapped;
+            }
+        }
+
+        vTriangles.resize(num_kept);
+        submeshes.resize(num_kept);
+    }
+
+    /**
+    * @brief Type of the group of edges [begin, end) that join the same two positions
+    */
+    EdgeType getEdgeType(const std::vector<Edge>& edges, JU::uint32 begin, JU::uint32 end)
+    {
+        if (end - begin == 1)
+            return BORDER_EDGE;
+
+        if (end - begin > 2)
+            return NON_MANIFOLD_EDGE;
+
+        if (edges[begin].v0_ != edges[begin + 1].v0_ || edges[begin].v1_ != edges[begin + 1].v1_)
+            return SEAM_EDGE;
+
+        return INTERIOR_EDGE;
+    }
+
+    void buildAdjacency(const VectorTriangleIndices& vTriangles,
+                        const VectorVertexIndices&   vVertexIndices,
+                        JU::uint32                   num_positions,
+                        Adjacency&                   adjacency)
+    {
+        std::vector<JU::uint32>& first = adjacency.first_;
+
+        first.assign(num_positions + 1, 0);
+        for (JU::uint32 triangle = 0; triangle < vTriangles.size(); ++triangle)
+        {
+            const VertexIndex* vertices = &vTriangles[triangle].v0_;
+            for (int corner = 0; corner < 3; ++corner)
+                ++first[getPosition(vVertexIndices, vertices[corner]) + 1];
+        }
+        for (JU::uint32 position = 0; position < num_positions; ++position)
+            first[position + 1] += first[position];
+
+        std::vector<JU::uint32> fill (first.begin(), first.end() - 1);
+        adjacency.triangles_.resize(first[num_positions]);
+        adjacency.edges_.clear();
+        adjacency.edges_.reserve(vTriangles.size() * 3);
+
+        for (JU::uint32 triangle = 0; triangle < vTriangles.size(); ++triangle)
+        {
+            const VertexIndex* vertices = &vTriangles[triangle].v0_;
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                VertexIndex v0 = vertices[corner];
+                VertexIndex v1 = vertices[(corner + 1) % 3];
+                JU::uint32  p0 = getPosition(vVertexIndices, v0);
+                JU::uint32  p1 = getPosition(vVertexIndices, v1);
+
+                adjacency.triangles_[fill[p0]++] = triangle;
+
+                if (p1 < p0)
+                {
+                    std::swap(v0, v1);
+                    std::swap(p0, p1);
+                }
+
+                Edge edge;
+                edge.key_      = (static_cast<JU::uint64>(p0) << 32) | p1;
+                edge.v0_       = v0;
+                edge.v1_       = v1;
+                edge.triangle_ = triangle;
+                adjacency.edges_.push_back(edge);
+            }
+        }
+
+        std::sort(adjacency.edges_.begin(), adjacency.edges_.end());
+
+        // Positions touching more than two seam/border edges (or any non-manifold one) cannot move
+        std::vector<JU::uint32> num_special (num_positions, 0);
+        std::vector<bool>       non_manifold (num_positions, false);
+
+        const std::vector<Edge>& edges = adjacency.edges_;
+        for (JU::uint32 begin = 0, end = 0; begin < edges.size(); begin = end)
+        {
+            for (end = begin + 1; end < edges.size() && edges[end].key_ == edges[begin].key_; ++end);
+
+            JU::uint32 p0 = static_cast<JU::uint32>(edges[begin].key_ >> 32);
+            JU::uint32 p1 = static_cast<JU::uint32>(edges[begin].key_ & 0xFFFFFFFF);
+
+            switch (getEdgeType(edges, begin, end))
+            {
+                case INTERIOR_EDGE:
+                    break;
+                case SEAM_EDGE:
+                case BORDER_EDGE:
+                    ++num_special[p0];
+                    ++num_special[p1];
+                    break;
+                case NON_MANIFOLD_EDGE:
+                    non_manifold[p0] = non_manifold[p1] = true;
+                    break;
+            }
+        }
+
+        adjacency.types_.resize(num_positions);
+        for (JU::uint32 position = 0; position < num_positions; ++position)
+        {
+            if (non_manifold[position])
+                adjacency.types_[position] = LOCKED_POSITION;
+            else if (num_special[position] == 0)
+                adjacency.types_[position] = INTERIOR_POSITION;
+            else if (num_special[position] == 2)
+                adjacency.types_[position] = SEAM_POSITION;
+            else
+                adjacency.types_[position] = LOCKED_POSITION;
+        }
+    }
+
+    /**
+    * @brief Check a collapse and find the vertex each vertex at 'from' becomes
+    *
+    * @detail The collapse is rejected if:
+    *          + A vertex at 'from' has no vertex at 'to' in its triangles, or more than one (it would have to pick
+    *            attributes from the wrong side of a seam)
+    *          + The two ends share more neighbours than the triangles of the edge (the result would be non-manifold)
+    *          + A triangle around 'from' would flip
+    *
+    * @return Is the collapse valid?
+    */
+    bool checkCollapse(const VectorTriangleIndices&         vTriangles,
+                       const VectorVertexIndices&           vVertexIndices,
+                       const VectorPositions&               vPositions,
+                       const Adjacency&                     adjacency,
+                       const Collapse&                      collapse,
+                       std::vector<std::pair<VertexIndex, VertexIndex> >& mapping)
+    {
+        JU::uint32 from = collapse.from_;
+        JU::uint32 to   = collapse.to_;
+
+        mapping.clear();
+
+        std::vector<JU::uint32> neighbours_from, neighbours_to;
+        JU::uint32 num_shared_triangles = 0;
+
+        for (JU::uint32 entry = adjacency.first_[from]; entry < adjacency.first_[from + 1]; ++entry)
+        {
+            const VertexIndex* vertices = &vTriangles[adjacency.triangles_[entry]].v0_;
+
+            VertexIndex vertex_from = 0, vertex_to = 0;
+            bool has_to = false;
+            int corner_from = 0;
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                JU::uint32 position = getPosition(vVertexIndices, vertices[corner]);
+
+                if (position == from)
+                {
+                    vertex_from = vertices[corner];
+                    corner_from = corner;
+                }
+                else
+                {
+                    neighbours_from.push_back(position);
+
+                    if (position == to)
+                    {
+                        vertex_to = vertices[corner];
+                        has_to = true;
+                    }
+                }
+            }
+
+            if (has_to)
+            {
+                ++num_shared_triangles;
+
+                // Every vertex at 'from' must become a single vertex at 'to'
+                bool found = false;
+                for (JU::uint32 index = 0; index < mapping.size(); ++index)
+                {
+                    if (mapping[index].first == vertex_from)
+                    {
+                        if (mapping[index].second != vertex_to)
+                            return false;
+                        found = true;
+                    }
+                }
+                if (!found)
+                    mapping.push_back(std::make_pair(vertex_from, vertex_to));
+            }
+            else
+            {
+                // The triangle survives with 'from' moved to 'to': it must not flip
+                const glm::vec3& p1 = vPositions[getPosition(vVertexIndices, vertices[(corner_from + 1) % 3])];
+                const glm::vec3& p2 = vPositions[getPosition(vVertexIndices, vertices[(corner_from + 2) % 3])];
+
+                glm::vec3 before = computeNormal(vPositions[from], p1, p2);
+                glm::vec3 after  = computeNormal(vPositions[to], p1, p2);
+
+                if (glm::dot(before, after) <= 0.0f)
+                    return false;
+            }
+        }
+
+        // All the vertices at 'from' must be mapped
+        for (JU::uint32 entry = adjacency.first_[from]; entry < adjacency.first_[from + 1]; ++entry)
+        {
+            const VertexIndex* vertices = &vTriangles[adjacency.triangles_[entry]].v0_;
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                if (getPosition(vVertexIndices, vertices[corner]) != from)
+                    continue;
+
+                bool found = false;
+                for (JU::uint32 index = 0; index < mapping.size() && !found; ++index)
+                    found = (mapping[index].first == vertices[corner]);
+
+                if (!found)
+                    return false;
+            }
+        }
+
+        // An interior position has a single vertex (different attributes would be a seam)
+        if (adjacency.types_[from] == INTERIOR_POSITION && mapping.size() != 1)
+            return false;
+
+        // Link condition
+        for (JU::uint32 entry = adjacency.first_[to]; entry < adjacency.first_[to + 1]; ++entry)
+        {
+            const VertexIndex* vertices = &vTriangles[adjacency.triangles_[entry]].v0_;
+
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                JU::uint32 position = getPosition(vVertexIndices, vertices[corner]);
+                if (position != to)
+                    neighbours_to.push_back(position);
+            }
+        }
+
+        std::sort(neighbours_from.begin(), neighbours_from.end());
+        neighbours_from.erase(std::unique(neighbours_from.begin(), neighbours_from.end()), neighbours_from.end());
+        std::sort(neighbours_to.begin(), neighbours_to.end());
+        neighbours_to.erase(std::unique(neighbours_to.begin(), neighbours_to.end()), neighbours_to.end());
+
+        JU::uint32 num_shared_neighbours = 0;
+        for (JU::uint32 i = 0, j = 0; i < neighbours_from.size() && j < neighbours_to.size(); )
+        {
+            if (neighbours_from[i] < neighbours_to[j])
+                ++i;
+            else if (neighbours_to[j] < neighbours_from[i])
+                ++j;
+            else
+            {
+                ++num_shared_neighbours;
+                ++i;
+                ++j;
+            }
+        }
+
+        return num_shared_neighbours <= num_shared_triangles;
+    }
+}
+
+
+
+/**
+* @brief Simplify a mesh down to a number of triangles
+*
+* @detail It stops earlier if every remaining collapse would exceed the error limit, or no more edges can be collapsed
+*         (e.g. the seams and borders are all that is left).
+*
+* @param mesh             Mesh2 object
+* @param target_triangles Number of triangles to reach
+* @param max_error        Largest error allowed for a collapse (distance, see the return value)
+* @param simplified       The simplified mesh (same positions and attributes, fewer vertices and triangles)
+*
+* @return Error bound: largest RMS distance from a surviving position to the planes it has absorbed
+*/
+JU::f32 MeshSimplifier::simplify(const Mesh2& mesh, JU::uint32 target_triangles, JU::f32 max_error, Mesh2& simplified)
+{
+    const VectorPositions&     vPositions     = mesh.getPositions();
+    const VectorVertexIndices& vVertexIndices = mesh.getVertexIndices();
+    VectorTriangleIndices      vTriangles (mesh.getTriangleIndices());
+
+    JU::uint32 num_positions = vPositions.size();
+
+    // Submesh of each triangle (the triangles keep their relative order, so the ranges are rebuilt at the end)
+    VectorSubMeshes vSubMeshes (mesh.getSubMeshes());
+    std::vector<JU::uint32> submeshes (vTriangles.size(), 0);
+    for (JU::uint32 submesh = 0; submesh < vSubMeshes.size(); ++submesh)
+        for (JU::uint32 triangle = 0; triangle < vSubMeshes[submesh].num_triangles_; ++triangle)
+            submeshes[vSubMeshes[submesh].first_triangle_ + triangle] = submesh;
+
+    // Triangles that are already degenerate (e.g. at the poles of a sphere) have no edges to collapse
+    std::vector<VertexIndex> remap (vVertexIndices.size());
+    for (JU::uint32 vertex = 0; vertex < remap.size(); ++vertex)
+        remap[vertex] = vertex;
+    remapTriangles(remap, vVertexIndices, vTriangles, submeshes);
+
+    Adjacency adjacency;
+    buildAdjacency(vTriangles, vVertexIndices, num_positions, adjacency);
+
+    // Quadrics: planes of the triangles, plus perpendicular planes along the borders and seams
+    std::vector<Quadric> quadrics (num_positions);
+
+    for (JU::uint32 triangle = 0; triangle < vTriangles.size(); ++triangle)
+    {
+        const VertexIndex* vertices = &vTriangles[triangle].v0_;
+        JU::uint32 p[3];
+        for (int corner = 0; corner < 3; ++corner)
+            p[corner] = getPosition(vVertexIndices, vertices[corner]);
+
+        glm::vec3 normal = computeNormal(vPositions[p[0]], vPositions[p[1]], vPositions[p[2]]);
+        JU::f32 length = glm::length(normal);
+        if (length == 0.0f)
+            continue;
+        normal /= length;
+
+        for (int corner = 0; corner < 3; ++corner)
+            quadrics[p[corner]].addPlane(normal, -glm::dot(normal, vPositions[p[0]]), 1.0);
+    }
+
+    const std::vector<Edge>& edges = adjacency.edges_;
+    for (JU::uint32 begin = 0, end = 0; begin < edges.size(); begin = end)
+    {
+        for (end = begin + 1; end < edges.size() && edges[end].key_ == edges[begin].key_; ++end);
+
+        EdgeType type = getEdgeType(edges, begin, end);
+        if (type != SEAM_EDGE && type != BORDER_EDGE)
+            continue;
+
+        JU::uint32 p0 = static_cast<JU::uint32>(edges[begin].key_ >> 32);
+        JU::uint32 p1 = static_cast<JU::uint32>(edges[begin].key_ & 0xFFFFFFFF);
+
+        const TriangleIndices& triangle = vTriangles[edges[begin].triangle_];
+        glm::vec3 triangle_normal = computeNormal(vPositions[getPosition(vVertexIndices, triangle.v0_)],
+                                                  vPositions[getPosition(vVertexIndices, triangle.v1_)],
+                                                  vPositions[getPosition(vVertexIndices, triangle.v2_)]);
+
+        glm::vec3 normal = glm::cross(vPositions[p1] - vPositions[p0], triangle_normal);
+        JU::f32 length = glm::length(normal);
+        if (length == 0.0f)
+            continue;
+        normal /= length;
+
+        JU::f32 distance = -glm::dot(normal, vPositions[p0]);
+        quadrics[p0].addPlane(normal, distance, BORDER_WEIGHT);
+        quadrics[p1].addPlane(normal, distance, BORDER_WEIGHT);
+    }
+
+    JU::f64 error = 0.0;
+    JU::f64 max_cost = static_cast<JU::f64>(max_error) * max_error;
+    JU::uint32 num_triangles = vTriangles.size();
+
+    std::vector<Collapse>   collapses;
+    std::vector<bool>       locked;
+    std::vector<std::pair<VertexIndex, VertexIndex> > mapping;
+
+    while (num_triangles > target_triangles)
+    {
+        // Candidates
+        collapses.clear();
+        for (JU::uint32 begin = 0, end = 0; begin < edges.size(); begin = end)
+        {
+            for (end = begin + 1; end < edges.size() && edges[end].key_ == edges[begin].key_; ++end);
+
+            EdgeType type = getEdgeType(edges, begin, end);
+            if (type == NON_MANIFOLD_EDGE)
+                continue;
+
+            JU::uint32 ends[2] = { static_cast<JU::uint32>(edges[begin].key_ >> 32),
+                                   static_cast<JU::uint32>(edges[begin].key_ & 0xFFFFFFFF) };
+
+            for (int direction = 0; direction < 2; ++direction)
+            {
+                JU::uint32 from = ends[direction];
+                JU::uint32 to   = ends[1 - direction];
+
+                PositionType from_type = adjacency.types_[from];
+                if (from_type == LOCKED_POSITION || (from_type == SEAM_POSITION && type == INTERIOR_EDGE))
+                    continue;
+
+                Quadric quadric (quadrics[from]);
+                quadric += quadrics[to];
+
+                Collapse collapse;
+                collapse.cost_ = quadric.evaluate(vPositions[to]);
+                if (collapse.cost_ > max_cost)
+                    continue;
+
+                collapse.from_ = from;
+                collapse.to_   = to;
+                collapse.type_ = type;
+                collapses.push_back(collapse);
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end());
+
+        // Apply the cheapest ones that do not touch each other
+        locked.assign(num_positions, false);
+        for (JU::uint32 vertex = 0; vertex < remap.size(); ++vertex)
+            remap[vertex] = vertex;
+
+        // Only the cheapest candidates, about as many as collapses are still needed (the rest are rebuilt next pass
+        // with the updated quadrics), unless none of them is valid
+        JU::uint32 num_candidates = (num_triangles - target_triangles) / 2 + 1;
+        JU::uint32 num_applied = 0;
+
+        for (JU::uint32 index = 0; index < collapses.size() && num_triangles > target_triangles; ++index)
+        {
+            if (index >= num_candidates && num_applied > 0)
+                break;
+
+            const Collapse& collapse = collapses[index];
+
+            if (locked[collapse.from_] || locked[collapse.to_])
+                continue;
+
+            if (!checkCollapse(vTriangles, vVertexIndices, vPositions, adjacency, collapse, mapping))
+                continue;
+
+            for (JU::uint32 entry = 0; entry < mapping.size(); ++entry)
+                remap[mapping[entry].first] = mapping[entry].second;
+
+            quadrics[collapse.to_] += quadrics[collapse.from_];
+            error = std::max(error, collapse.cost_);
+
+            // The one ring of 'from' changes shape: nothing around it can collapse in this pass
+            for (JU::uint32 entry = adjacency.first_[collapse.from_]; entry < adjacency.first_[collapse.from_ + 1]; ++entry)
+            {
+                const VertexIndex* vertices = &vTriangles[adjacency.triangles_[entry]].v0_;
+                bool removed = false;
+
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    JU::uint32 position = getPosition(vVertexIndices, vertices[corner]);
+                    locked[position] = true;
+                    removed = removed || (position == collapse.to_);
+                }
+
+                if (removed)
+                    --num_triangles;
+            }
+
+            ++num_applied;
+        }
+
+        if (num_applied == 0)
+            break;
+
+        remapTriangles(remap, vVertexIndices, vTriangles, submeshes);
+        num_triangles = vTriangles.size();
+
+        buildAdjacency(vTriangles, vVertexIndices, num_positions, adjacency);
+    }
+
+    if (!vSubMeshes.empty())
+    {
+        for (JU::uint32 submesh = 0; submesh < vSubMeshes.size(); ++submesh)
+            vSubMeshes[submesh].num_triangles_ = 0;
+        for (JU::uint32 triangle = 0; triangle < submeshes.size(); ++triangle)
+            ++vSubMeshes[submeshes[triangle]].num_triangles_;
+        for (JU::uint32 submesh = 1; submesh < vSubMeshes.size(); ++submesh)
+            vSubMeshes[submesh].first_triangle_ = vSubMeshes[submesh - 1].first_triangle_ + vSubMeshes[submesh - 1].num_triangles_;
+    }
+
+    simplified = mesh;
+    simplified.setTriangleIndices(vTriangles);
+    simplified.setSubMeshes(vSubMeshes);
+    MeshOptimizer::optimizeVertexOrder(simplified);
+
+    return static_cast<JU::f32>(std::sqrt(error));
+}
+
+
+
+/**
+* @brief Build a chain of levels of detail
+*
+* @detail Every level is simplified from the original mesh. The chain stops early when a level cannot get any smaller
+*         than the previous one within the error limit.
+*
+* @param mesh               Mesh2 object (level 0)
+* @param ratios             Fraction of the triangles of the original mesh for each level (decreasing, e.g. 0.5, 0.25)
+* @param lods               Levels 1, 2... (named after the mesh with an "_lod<n>" suffix)
+* @param errors             Error bound of each level (see simplify)
+* @param max_relative_error Largest error allowed, as a fraction of the radius of the bounding sphere of the mesh
+*/
+void MeshSimplifier::buildLODs(const Mesh2& mesh,
+                               const std::vector<JU::f32>& ratios,
+                               std::vector<Mesh2>& lods,
+                               std::vector<JU::f32>& errors,
+                               JU::f32 max_relative_error)
+{
+    JU::uint32 num_triangles = mesh.getTriangleIndices().size();
+    JU::f32    max_error     = max_relative_error * mesh.getBoundingSphere().radius_;
+    JU::uint32 last_triangles = num_triangles;
+
+    lods.clear();
+    errors.clear();
+
+    for (JU::uint32 level = 0; level < ratios.size(); ++level)
+    {
+        JU::uint32 target = static_cast<JU::uint32>(ratios[level] * num_triangles);
+
+        Mesh2 lod;
+        JU::f32 error = simplify(mesh, target, max_error, lod);
+
+        if (lod.getTriangleIndices().size() >= last_triangles)
+            break;
+
+        last_triangles = lod.getTriangleIndices().size();
+
+        std::ostringstream oss;
+        oss << mesh.getName() << "_lod" << level + 1;
+        lod.setName(oss.str());
+
+        lods.push_back(lod);
+        errors.push_back(error);
+    }
+}
+
+} /* namespace JU */
@@ -0,0 +1,53 @@
+/*
+ * MeshSimplifier.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef MESHSIMPLIFIER_HPP_
+#define MESHSIMPLIFIER_HPP_
+
+// Local includes
+#include "../core/Defs.hpp"     // uint32, f32
+// Global includes
+#include <vector>               // std::vector
+
+namespace JU
+{
+
+// Forward Declarations
+class Mesh2;
+
+/**
+ * @brief Builds lower resolution versions of a Mesh2 (levels of detail) by collapsing edges
+ *
+ * @details Quadric error metric simplification (Garland & Heckbert) with half-edge collapses: a vertex is merged into
+ *          one of its neighbours, so no new positions or attributes are created. Each position accumulates the planes
+ *          of its original triangles, and the cost of a collapse is the squared distance from the surviving position
+ *          to all the planes of both ends.
+ *
+ *          Seams (edges where the normals or texture coordinates of the two triangles differ) and borders (edges with
+ *          a single triangle) are kept: a vertex on one can only slide along it, every vertex of a seam is mapped to
+ *          the vertex on its own side, and vertices where seams or borders meet are never removed.
+ *
+ *          The collapses are applied in passes: all the candidates are sorted by cost and the cheapest ones that do not
+ *          touch each other are applied, then the candidates are rebuilt.
+ */
+class MeshSimplifier
+{
+    public:
+        static const JU::f32 DEFAULT_MAX_RELATIVE_ERROR;
+
+    public:
+        static JU::f32 simplify(const Mesh2& mesh, JU::uint32 target_triangles, JU::f32 max_error, Mesh2& simplified);
+        static void buildLODs(const Mesh2& mesh,
+                              const std::vector<JU::f32>& ratios,
+                              std::vector<Mesh2>& lods,
+                              std::vector<JU::f32>& errors,
+                              JU::f32 max_relative_error = DEFAULT_MAX_RELATIVE_ERROR);
+};
+
+} /* namespace JU */
+
+#endif /* MESHSIMPLIFIER_HPP_ */
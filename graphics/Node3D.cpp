@@ -7,6 +7,7 @@
 
 #include "Node3D.hpp"
 #include "GLSLProgram.hpp"  // GLSLProgram
+#include "../collision/Intersection.hpp"    // testFrustumBox
 
 namespace JU
 {
@@ -24,7 +25,8 @@ namespace JU
 Node3D::Node3D(const Transform3D &object,
                const DrawInterface *node_drawable,
                bool visible) :
-               Transform3D(object), node_drawable_(node_drawable), visible_(visible)
+               Transform3D(object), node_drawable_(node_drawable), visible_(visible),
+               has_bounds_(false), subtree_bounded_(false), subtree_empty_(false)
 {
 }
 
@@ -80,4 +82,169 @@ void Node3D::draw(const GLSLProgram &program, const glm::mat4 & model, const glm
     }
 }
 
+
+
+
+/**
+* @brief Set the bounding box of the drawable of this node
+*
+* @detail 'updateBounds' must be called on the root afterwards
+*
+* @param box Bounding box in this node's coordinate system (before applying the node transform)
+*/
+void Node3D::setBoundingBox(const BoundingBox& box)
+{
+    bounds_     = box;
+    has_bounds_ = true;
+}
+
+
+
+/**
+* @brief Recompute the subtree bounding boxes
+*
+* @detail It must be called on the root whenever a bounding box is set, a child is added or a node below the root
+*         is moved. The transform of the root itself is applied at draw time, so moving the root is free.
+*/
+void Node3D::updateBounds()
+{
+    subtree_empty_   = true;
+    subtree_bounded_ = true;
+
+    if (visible_ && node_drawable_)
+    {
+        if (has_bounds_)
+        {
+            subtree_bounds_ = bounds_;
+            subtree_empty_  = false;
+        }
+        else
+            subtree_bounded_ = false;
+    }
+
+    for(NodePointerListIterator iter = children_.begin(); iter != children_.end(); ++iter)
+    {
+        Node3D* child = *iter;
+        child->updateBounds();
+
+        if (child->subtree_empty_)
+            continue;
+
+        if (!child->subtree_bounded_)
+        {
+            subtree_bounded_ = false;
+            continue;
+        }
+
+        // The child's box is in the child's coordinate system
+        BoundingBox child_box (child->subtree_bounds_.transform(child->getTransformToParent()));
+
+        if (subtree_empty_)
+            subtree_bounds_ = child_box;
+        else
+            subtree_bounds_.merge(child_box);
+
+        subtree_empty_ = false;
+    }
+}
+
+
+
+/**
+* @brief Draw the parts of this node and its children that are inside the view frustum
+*
+* @detail The frustum is extracted from (projection * view), and the subtree bounds (see 'updateBounds') are
+*         tested against it in world coordinates, so whole subtrees outside the view are skipped
+*
+* @param shader_program     Handle to the shader program
+* @param model              Model matrix
+* @param view               View matrix
+* @param projection         Projection matrix
+*/
+void Node3D::drawVisible(const GLSLProgram &program, const glm::mat4 & model, const glm::mat4 &view, const glm::mat4 &projection) const
+{
+    drawVisible(program, model, view, projection, Frustum(projection * view));
+}
+
+
+
+void Node3D::drawVisible(const GLSLProgram &program, const glm::mat4 & model, const glm::mat4 &view, const glm::mat4 &projection, const Frustum &frustum) const
+{
+    if (subtree_empty_)
+        return;
+
+    glm::mat4 new_model = model * getTransformToParent();
+
+    if (subtree_bounded_ && !testFrustumBox(frustum, subtree_bounds_.transform(new_model)))
+        return;
+
+    if (visible_ && node_drawable_ && (!has_bounds_ || children_.empty() || testFrustumBox(frustum, bounds_.transform(new_model))))
+    {
+        node_drawable_->draw(program, new_model, view, projection);
+    }
+
+    // Draw the children
+    for(NodePointerListIterator iter = children_.begin(); iter != children_.end(); ++iter)
+    {
+        (*iter)->drawVisible(program, new_model, view, projection, frustum);
+    }
+}
+
+
+
+/**
+* @brief Queue this node and all its children (see RenderQueue)
+*
+* @param queue              Queue of the frame
+* @param program            Shader program
+* @param model              Model matrix
+*/
+void Node3D::submit(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model) const
+{
+    glm::mat4 new_model = model * getTransformToParent();
+
+    if (visible_ && node_drawable_)
+    {
+        node_drawable_->submit(queue, program, new_model);
+    }
+
+    for(NodePointerListIterator iter = children_.begin(); iter != children_.end(); ++iter)
+    {
+        (*iter)->submit(queue, program, new_model);
+    }
+}
+
+
+
+/**
+* @brief Queue the nodes inside the view frustum of the queue (see drawVisible)
+*/
+void Node3D::submitVisible(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model) const
+{
+    submitVisible(queue, program, model, Frustum(queue.getProjection() * queue.getView()));
+}
+
+
+
+void Node3D::submitVisible(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model, const Frustum &frustum) const
+{
+    if (subtree_empty_)
+        return;
+
+    glm::mat4 new_model = model * getTransformToParent();
+
+    if (subtree_bounded_ && !testFrustumBox(frustum, subtree_bounds_.transform(new_model)))
+        return;
+
+    if (visible_ && node_drawable_ && (!has_bounds_ || children_.empty() || testFrustumBox(frustum, bounds_.transform(new_model))))
+    {
+        node_drawable_->submit(queue, program, new_model);
+    }
+
+    for(NodePointerListIterator iter = children_.begin(); iter != children_.end(); ++iter)
+    {
+        (*iter)->submitVisible(queue, program, new_model, frustum);
+    }
+}
+
 } // namespace JU
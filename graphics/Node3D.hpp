@@ -11,6 +11,8 @@
 #include <vector>                   // std::vector
 #include "../core/Transform3D.hpp"     // Transform3D
 #include "DrawInterface.hpp"    // DrawInterface
+#include "../collision/BoundingVolumes.hpp" // BoundingBox
+#include "../collision/Frustum.hpp"         // Frustum
 
 namespace JU
 {
@@ -27,6 +29,10 @@ typedef NodePointerList::const_iterator NodePointerListIterator;
  * @details    It needs to:
  * + Draw itself
  * + Draw all its children
+ *
+ * Each node can be given the bounding box of its drawable (in the node's coordinate system). After 'updateBounds'
+ * every node also knows the box enclosing its whole subtree, and 'drawVisible' skips the subtrees outside the view
+ * frustum. Nodes whose drawable has no box are never culled (and neither are their ancestors).
  */
 class Node3D : public Transform3D, public DrawInterface
 {
@@ -38,12 +44,28 @@ class Node3D : public Transform3D, public DrawInterface
 
         void addChild(Node3D* node);
 
+        // Culling
+        void setBoundingBox(const BoundingBox& box);
+        void updateBounds();
+
         virtual void draw(const GLSLProgram &program, const glm::mat4 & model, const glm::mat4 &view, const glm::mat4 &projection) const;
+        void drawVisible(const GLSLProgram &program, const glm::mat4 & model, const glm::mat4 &view, const glm::mat4 &projection) const;
+        virtual void submit(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model) const;
+        void submitVisible(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model) const;
+
+    private:
+        void drawVisible(const GLSLProgram &program, const glm::mat4 & model, const glm::mat4 &view, const glm::mat4 &projection, const Frustum &frustum) const;
+        void submitVisible(RenderQueue &queue, const GLSLProgram &program, const glm::mat4 & model, const Frustum &frustum) const;
 
     private:
         const DrawInterface *node_drawable_;    //!< Pointer to the 'drawable' data of this node
         NodePointerList children_;              //!< All the children below this level
         bool visible_;                          //!< To draw or not draw, that is the question
+        BoundingBox bounds_;                    //!< Box of the drawable (in this node's coordinate system)
+        BoundingBox subtree_bounds_;            //!< Box of this node and all its descendants (in this node's coordinate system)
+        bool has_bounds_;                       //!< Has the drawable been given a box?
+        bool subtree_bounded_;                  //!< Can the subtree be culled (all its drawables have a box)?
+        bool subtree_empty_;                    //!< Nothing to draw in the subtree
 };
 
 } // namespace JU
@@ -0,0 +1,238 @@
+/*
+ * ProgramBinaryCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "ProgramBinaryCache.hpp"
+// Global includes
+#include <vector>               // std::vector
+#include <cstdio>               // std::printf, std::snprintf, std::fopen, std::fread, std::fwrite, std::rename
+#include <cstring>              // std::memset
+
+namespace JU
+{
+
+static_assert(sizeof(ProgramBinaryCache::Header) == 32, "ProgramBinaryCache::Header must be 32 bytes");
+
+std::string ProgramBinaryCache::directory_;
+
+namespace
+{
+    const char* CACHE_EXTENSION = ".jupb";
+
+    JU::uint64 hashBytes(JU::uint64 hash, const char* data, std::size_t size)
+    {
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            hash ^= static_cast<unsigned char>(data[index]);
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    std::string getString(GLenum name)
+    {
+        const GLubyte* value = gl::GetString(name);
+
+        return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+    }
+}
+
+
+
+/**
+* @brief Enable the cache, storing the binaries in a directory (which must exist)
+*
+* @param directory Directory of the binaries (empty to disable the cache)
+*/
+void ProgramBinaryCache::setDirectory(const std::string& directory)
+{
+    directory_ = directory;
+}
+
+
+
+const std::string& ProgramBinaryCache::getDirectory()
+{
+    return directory_;
+}
+
+
+
+bool ProgramBinaryCache::isEnabled()
+{
+    return !directory_.empty();
+}
+
+
+
+/**
+* @brief Key of a program for the current driver
+*
+* @param program_text Everything the link of the program depends on (sources, defines, bindings)
+*
+* @return FNV-1a hash of the driver strings and the text
+*/
+JU::uint64 ProgramBinaryCache::computeKey(const std::string& program_text)
+{
+    const std::string& driver = getDriverString();
+
+    JU::uint64 hash = 14695981039346656037ULL;
+    hash = hashBytes(hash, driver.data(), driver.size() + 1);   // The null separates the driver from the text
+    hash = hashBytes(hash, program_text.data(), program_text.size());
+
+    return hash;
+}
+
+
+
+/**
+* @brief Link a program from its cached binary
+*
+* @detail A binary the driver rejects (e.g. the driver was updated in place) is deleted so it is rebuilt.
+*
+* @param program Handle of the program (no shaders need be attached)
+* @param key     Key of the program (see computeKey)
+*
+* @return Is the program linked? (false if there is no valid binary: compile it from source)
+*/
+bool ProgramBinaryCache::load(GLuint program, JU::uint64 key)
+{
+    if (!isEnabled())
+        return false;
+
+    GLint num_formats = 0;
+    gl::GetIntegerv(gl::NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    if (num_formats <= 0)
+        return false;
+
+    std::string filename = getFilename(key);
+
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file)
+        return false;
+
+    Header header;
+    std::vector<JU::uint8> binary;
+
+    bool success = std::fread(&header, sizeof(header), 1, file) == 1 &&
+                   header.magic_ == MAGIC && header.version_ == VERSION && header.key_ == key && header.length_ > 0;
+
+    if (success)
+    {
+        binary.resize(header.length_);
+        success = std::fread(&binary[0], 1, binary.size(), file) == binary.size();
+    }
+
+    std::fclose(file);
+
+    if (success)
+    {
+        gl::ProgramBinary(program, header.format_, &binary[0], binary.size());
+
+        GLint status = gl::FALSE_;
+        gl::GetProgramiv(program, gl::LINK_STATUS, &status);
+        success = (status == gl::TRUE_);
+    }
+
+    if (!success)
+    {
+        std::printf("Program binary %s is stale or corrupt, rebuilding it\n", filename.c_str());
+        std::remove(filename.c_str());
+    }
+
+    return success;
+}
+
+
+
+/**
+* @brief Store the binary of a linked program
+*
+* @detail The binary is written to a temporary file and renamed, so a reader never sees a partial file.
+*
+* @param program Handle of the linked program (linked with PROGRAM_BINARY_RETRIEVABLE_HINT set)
+* @param key     Key of the program (see computeKey)
+*
+* @return Successful?
+*/
+bool ProgramBinaryCache::save(GLuint program, JU::uint64 key)
+{
+    if (!isEnabled())
+        return false;
+
+    GLint length = 0;
+    gl::GetProgramiv(program, gl::PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+
+    std::vector<JU::uint8> binary (length);
+    GLsizei written = 0;
+    GLenum  format  = 0;
+    gl::GetProgramBinary(program, length, &written, &format, &binary[0]);
+    if (written <= 0)
+        return false;
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic_   = MAGIC;
+    header.version_ = VERSION;
+    header.key_     = key;
+    header.format_  = format;
+    header.length_  = written;
+
+    std::string filename = getFilename(key);
+    std::string temp_filename = filename + ".tmp";
+
+    std::FILE* file = std::fopen(temp_filename.c_str(), "wb");
+    if (!file)
+    {
+        std::printf("Could not create program binary %s\n", temp_filename.c_str());
+        return false;
+    }
+
+    bool success = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(&binary[0], 1, written, file) == static_cast<std::size_t>(written);
+
+    success = (std::fclose(file) == 0) && success;
+    success = success && std::rename(temp_filename.c_str(), filename.c_str()) == 0;
+
+    if (!success)
+    {
+        std::printf("Could not write program binary %s\n", filename.c_str());
+        std::remove(temp_filename.c_str());
+    }
+
+    return success;
+}
+
+
+
+/**
+* @brief Name of the file of a program in the cache directory
+*/
+std::string ProgramBinaryCache::getFilename(JU::uint64 key)
+{
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+
+    return directory_ + "/" + name + CACHE_EXTENSION;
+}
+
+
+
+/**
+* @brief Vendor, renderer and version of the driver of the current context
+*/
+const std::string& ProgramBinaryCache::getDriverString()
+{
+    static const std::string driver = getString(gl::VENDOR) + "\n" + getString(gl::RENDERER) + "\n" + getString(gl::VERSION);
+
+    return driver;
+}
+
+} /* namespace JU */
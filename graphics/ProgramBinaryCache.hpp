@@ -0,0 +1,66 @@
+/*
+ * ProgramBinaryCache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef PROGRAMBINARYCACHE_HPP_
+#define PROGRAMBINARYCACHE_HPP_
+
+// Local includes
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+#include "../core/Defs.hpp"     // uint32, uint64
+// Global includes
+#include <string>               // std::string
+
+namespace JU
+{
+
+/**
+ * @brief On-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary, GL 4.1)
+ *
+ * @details A program is stored under a 64 bit key: the FNV-1a hash of everything its link depends on (the sources of
+ *          its shaders, their defines and attribute bindings, see GLSLProgram) and of the vendor, renderer and version
+ *          strings of the driver, so a driver update invalidates the cache. One file per program in the directory:
+ *           + Header (32 bytes): magic, version, key, binary format and length
+ *           + Binary blob as returned by the driver
+ *
+ *          The cache is disabled until a directory is set. A missing, stale or rejected binary is not an error: the
+ *          caller compiles the program from source and stores the new binary.
+ */
+class ProgramBinaryCache
+{
+    public:
+        static const JU::uint32 MAGIC   = 0x4250554A;   //!< "JUPB"
+        static const JU::uint32 VERSION = 1;
+
+        struct Header
+        {
+            JU::uint32 magic_;
+            JU::uint32 version_;
+            JU::uint64 key_;            //!< Key of the program (guards against hash collisions in the file name)
+            JU::uint32 format_;         //!< Binary format reported by the driver
+            JU::uint32 length_;         //!< Bytes of the binary
+            JU::uint32 reserved_[2];
+        };
+
+    public:
+        static void setDirectory(const std::string& directory);
+        static const std::string& getDirectory();
+        static bool isEnabled();
+
+        static JU::uint64 computeKey(const std::string& program_text);
+        static bool load(GLuint program, JU::uint64 key);
+        static bool save(GLuint program, JU::uint64 key);
+        static std::string getFilename(JU::uint64 key);
+
+    private:
+        static const std::string& getDriverString();
+
+        static std::string directory_;  //!< Directory of the binaries (empty: the cache is disabled)
+};
+
+} /* namespace JU */
+
+#endif /* PROGRAMBINARYCACHE_HPP_ */
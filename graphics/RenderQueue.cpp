@@ -0,0 +1,340 @@
+/*
+ * RenderQueue.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "RenderQueue.hpp"
+#include "DrawInterface.hpp"        // DrawInterface
+#include "GLMesh.hpp"               // GLMesh
+#include "GLMeshInstance.hpp"       // GLMeshInstance
+#include "GLSLProgram.hpp"          // GLSLProgram
+#include "TextureManager.hpp"       // unbindAllTextures
+#include "UniformBlockManager.hpp"  // UniformBlockManager
+// Global includes
+#include <algorithm>                // std::min
+#include <cstring>                  // std::memcpy, std::memset
+
+namespace JU
+{
+
+namespace
+{
+    const JU::uint32 PROGRAM_BITS   = 8;
+    const JU::uint32 MATERIAL_BITS  = 16;
+    const JU::uint32 MESH_BITS      = 24;
+    const JU::uint32 DEPTH_BITS     = 16;
+}
+
+
+
+RenderQueue::RenderQueue() : last_material_(0)
+{
+    std::memset(&stats_, 0, sizeof(stats_));
+}
+
+
+
+/**
+* @brief Start collecting the draws of a new frame
+*
+* @detail The camera of the frame is uploaded here for the programs that declare the camera block.
+*
+* @param view       View matrix
+* @param projection Projection matrix
+*/
+void RenderQueue::begin(const glm::mat4& view, const glm::mat4& projection)
+{
+    view_       = view;
+    projection_ = projection;
+
+    if (UniformBlockManager::isInitialized())
+        UniformBlockManager::setCamera(view_, projection_);
+
+    vItems_.clear();
+    vEntries_.clear();
+    vPrograms_.clear();
+    vMaterials_.clear();
+    hmMeshes_.clear();
+    last_material_ = 0;
+}
+
+
+
+/**
+* @brief Queue a drawable that will draw itself (with its 'draw')
+*/
+void RenderQueue::add(const GLSLProgram& program, const DrawInterface& drawable, const glm::mat4& model)
+{
+    Item item;
+    item.program_   = &program;
+    item.drawable_  = &drawable;
+    item.instance_  = 0;
+    item.mesh_      = 0;
+    item.material_  = NO_MATERIAL;
+    item.model_     = model;
+
+    SortEntry entry;
+    entry.key_   = makeKey(getProgramId(&program), NO_MATERIAL, 0, getDepth(model));
+    entry.index_ = vItems_.size();
+
+    vItems_.push_back(item);
+    vEntries_.push_back(entry);
+}
+
+
+
+/**
+* @brief Queue a level of detail of a GLMeshInstance
+*
+* @param program    Program to draw it with
+* @param instance   Instance (for its material and textures)
+* @param mesh       Level of detail to draw
+* @param model      Model matrix (including the scale factors of the instance)
+*/
+void RenderQueue::add(const GLSLProgram& program, const GLMeshInstance& instance, const GLMesh& mesh, const glm::mat4& model)
+{
+    Item item;
+    item.program_   = &program;
+    item.drawable_  = 0;
+    item.instance_  = &instance;
+    item.mesh_      = &mesh;
+    item.material_  = getMaterialId(instance);
+    item.model_     = model;
+
+    SortEntry entry;
+    entry.key_   = makeKey(getProgramId(&program), item.material_, getMeshId(&mesh), getDepth(model));
+    entry.index_ = vItems_.size();
+
+    vItems_.push_back(item);
+    vEntries_.push_back(entry);
+}
+
+
+
+/**
+* @brief Sort the draws and execute them, binding each program, material and VAO only when it changes
+*/
+void RenderQueue::execute()
+{
+    std::memset(&stats_, 0, sizeof(stats_));
+
+    sort();
+
+    const GLSLProgram*  current_program  = 0;
+    JU::uint32          current_material = NO_MATERIAL;
+    const void*         current_vao      = 0;   // Mesh or pool whose VAO is bound
+
+    for (JU::uint32 entry = 0; entry < vEntries_.size(); ++entry)
+    {
+        const Item& item = vItems_[vEntries_[entry].index_];
+
+        if (item.program_ != current_program)
+        {
+            item.program_->use();
+            current_program  = item.program_;
+            current_material = NO_MATERIAL;     // The material uniforms belong to the program
+            ++stats_.num_program_binds_;
+        }
+
+        if (item.drawable_)
+        {
+            item.drawable_->draw(*item.program_, item.model_, view_, projection_);
+            current_material = NO_MATERIAL;
+            current_vao      = 0;
+        }
+        else
+        {
+            bool bind_material = (item.material_ != current_material);
+            const void* vao    = item.mesh_->getPool() ? static_cast<const void*>(item.mesh_->getPool()) : item.mesh_;
+            bool bind_mesh     = (vao != current_vao);
+
+            item.instance_->drawQueued(*item.program_, *item.mesh_, item.model_, view_, projection_, bind_material, bind_mesh);
+
+            current_material = item.material_;
+            current_vao      = vao;
+            stats_.num_material_binds_ += bind_material;
+            stats_.num_mesh_binds_     += bind_mesh;
+        }
+
+        ++stats_.num_draws_;
+    }
+
+    TextureManager::unbindAllTextures();
+}
+
+
+
+const glm::mat4& RenderQueue::getView() const
+{
+    return view_;
+}
+
+
+
+const glm::mat4& RenderQueue::getProjection() const
+{
+    return projection_;
+}
+
+
+
+JU::uint32 RenderQueue::getNumItems() const
+{
+    return vItems_.size();
+}
+
+
+
+const RenderQueue::Stats& RenderQueue::getStats() const
+{
+    return stats_;
+}
+
+
+
+/**
+* @brief Pack the sort key of a draw
+*
+* @detail The ids are clamped to their fields. Positive floats sort like their bits, so the depth keeps the top 16 bits
+*         of its float (sign, exponent and 7 bits of mantissa: better than 1% precision at any distance).
+*
+* @param program    Id of the program
+* @param material   Id of the material (NO_MATERIAL goes after all the others)
+* @param mesh       Id of the mesh
+* @param depth      Distance to the camera (negative distances count as 0)
+*/
+JU::uint64 RenderQueue::makeKey(JU::uint32 program, JU::uint32 material, JU::uint32 mesh, JU::f32 depth)
+{
+    JU::uint32 depth_bits = 0;
+
+    if (depth > 0.0f)
+        std::memcpy(&depth_bits, &depth, sizeof(depth_bits));
+
+    JU::uint64 key = std::min<JU::uint32>(program, (1u << PROGRAM_BITS) - 1);
+    key = (key << MATERIAL_BITS) | std::min<JU::uint32>(material, (1u << MATERIAL_BITS) - 1);
+    key = (key << MESH_BITS)     | std::min<JU::uint32>(mesh, (1u << MESH_BITS) - 1);
+    key = (key << DEPTH_BITS)    | (depth_bits >> (32 - DEPTH_BITS));
+
+    return key;
+}
+
+
+
+JU::uint32 RenderQueue::getProgramId(const GLSLProgram* program)
+{
+    for (JU::uint32 id = 0; id < vPrograms_.size(); ++id)
+        if (vPrograms_[id] == program)
+            return id;
+
+    vPrograms_.push_back(program);
+
+    return vPrograms_.size() - 1;
+}
+
+
+
+/**
+* @brief Id of the material of an instance
+*
+* @detail Scenes have few materials, and consecutive submissions (e.g. the nodes of a forest) often share the same one,
+*         so the last id found is tried first and then the list of materials of the frame.
+*/
+JU::uint32 RenderQueue::getMaterialId(const GLMeshInstance& instance)
+{
+    if (last_material_ < vMaterials_.size() &&
+        (vMaterials_[last_material_] == &instance || vMaterials_[last_material_]->hasSameMaterial(instance)))
+        return last_material_;
+
+    for (JU::uint32 id = 0; id < vMaterials_.size(); ++id)
+    {
+        if (vMaterials_[id] == &instance || vMaterials_[id]->hasSameMaterial(instance))
+        {
+            last_material_ = id;
+            return id;
+        }
+    }
+
+    vMaterials_.push_back(&instance);
+    last_material_ = vMaterials_.size() - 1;
+
+    return last_material_;
+}
+
+
+
+JU::uint32 RenderQueue::getMeshId(const GLMesh* mesh)
+{
+    std::unordered_map<const GLMesh*, JU::uint32>::const_iterator iter = hmMeshes_.find(mesh);
+
+    if (iter != hmMeshes_.end())
+        return iter->second;
+
+    JU::uint32 id = hmMeshes_.size();
+    hmMeshes_[mesh] = id;
+
+    return id;
+}
+
+
+
+JU::f32 RenderQueue::getDepth(const glm::mat4& model) const
+{
+    return -(view_ * model[3]).z;
+}
+
+
+
+/**
+* @brief LSD radix sort of the entries by key (stable, so equal keys keep their submission order)
+*/
+void RenderQueue::sort()
+{
+    JU::uint32 num_entries = vEntries_.size();
+
+    if (num_entries < 2)
+        return;
+
+    // Histograms of the 8 bytes in a single pass
+    JU::uint32 counts[8][256];
+    std::memset(counts, 0, sizeof(counts));
+
+    for (JU::uint32 entry = 0; entry < num_entries; ++entry)
+    {
+        JU::uint64 key = vEntries_[entry].key_;
+
+        for (JU::uint32 byte = 0; byte < 8; ++byte)
+            ++counts[byte][(key >> (8 * byte)) & 0xFF];
+    }
+
+    vScratch_.resize(num_entries);
+
+    for (JU::uint32 byte = 0; byte < 8; ++byte)
+    {
+        JU::uint32* count = counts[byte];
+
+        // All the keys have the same byte: the pass would not move anything
+        if (count[(vEntries_[0].key_ >> (8 * byte)) & 0xFF] == num_entries)
+            continue;
+
+        JU::uint32 offset = 0;
+        for (JU::uint32 digit = 0; digit < 256; ++digit)
+        {
+            JU::uint32 digit_count = count[digit];
+            count[digit] = offset;
+            offset += digit_count;
+        }
+
+        for (JU::uint32 entry = 0; entry < num_entries; ++entry)
+        {
+            const SortEntry& sort_entry = vEntries_[entry];
+            vScratch_[count[(sort_entry.key_ >> (8 * byte)) & 0xFF]++] = sort_entry;
+        }
+
+        vEntries_.swap(vScratch_);
+    }
+}
+
+} /* namespace JU */
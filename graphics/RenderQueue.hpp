@@ -0,0 +1,116 @@
+/*
+ * RenderQueue.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef RENDERQUEUE_HPP_
+#define RENDERQUEUE_HPP_
+
+// Local includes
+#include "../core/Defs.hpp"     // uint32, uint64
+// Global includes
+#include <glm/glm.hpp>          // glm::mat4
+#include <vector>               // std::vector
+#include <unordered_map>        // std::unordered_map
+
+namespace JU
+{
+
+// Forward declarations
+class GLSLProgram;
+class GLMesh;
+class GLMeshInstance;
+class DrawInterface;
+
+/**
+ * @brief Collects the draws of a frame, sorts them to minimize the GL state changes and executes them
+ *
+ * @details Each draw is tagged with a 64 bit key; from the most to the least significant bits:
+ *
+ *          | program (8) | material and textures (16) | mesh (24) | depth (16) |
+ *
+ *          The fields are small ids the queue gives to each program, material (GLMeshInstance objects that pass
+ *          GLMeshInstance::hasSameMaterial share one) and mesh the first time they are submitted in the frame. The
+ *          depth is the distance from the camera to the origin of the model, so the draws that share everything else
+ *          go front to back. The keys are sorted with a LSD radix sort (8 passes of 8 bits, skipping the bytes that
+ *          are the same in all the keys).
+ *
+ *          When executing, the program, material (and textures) and VAO are only bound when they change. The keys only
+ *          decide the order: the state is compared on the objects themselves, so ids that overflow their field only
+ *          cost some redundant binds. Drawables the queue does not know about (see DrawInterface::submit) are drawn
+ *          with their own 'draw', after which the material and VAO are bound again.
+ */
+class RenderQueue
+{
+    public:
+        /**
+         * @brief What the last execution did
+         */
+        struct Stats
+        {
+            JU::uint32 num_draws_;
+            JU::uint32 num_program_binds_;
+            JU::uint32 num_material_binds_;
+            JU::uint32 num_mesh_binds_;
+        };
+
+    public:
+        RenderQueue();
+
+        void begin(const glm::mat4& view, const glm::mat4& projection);
+        void add(const GLSLProgram& program, const DrawInterface& drawable, const glm::mat4& model);
+        void add(const GLSLProgram& program, const GLMeshInstance& instance, const GLMesh& mesh, const glm::mat4& model);
+        void execute();
+
+        const glm::mat4& getView() const;
+        const glm::mat4& getProjection() const;
+        JU::uint32 getNumItems() const;
+        const Stats& getStats() const;
+
+        static JU::uint64 makeKey(JU::uint32 program, JU::uint32 material, JU::uint32 mesh, JU::f32 depth);
+
+    private:
+        static const JU::uint32 NO_MATERIAL = 0xFFFFFFFF;     //!< Material of the draws that are not a GLMeshInstance
+
+        /**
+         * @brief A draw of the frame
+         */
+        struct Item
+        {
+            const GLSLProgram*      program_;
+            const DrawInterface*    drawable_;      //!< Drawable of generic items (NULL for mesh instances)
+            const GLMeshInstance*   instance_;
+            const GLMesh*           mesh_;          //!< Level of detail of the instance
+            JU::uint32              material_;      //!< Id of the material (NO_MATERIAL for generic items)
+            glm::mat4               model_;
+        };
+
+        struct SortEntry
+        {
+            JU::uint64 key_;
+            JU::uint32 index_;      //!< Item
+        };
+
+        JU::uint32 getProgramId(const GLSLProgram* program);
+        JU::uint32 getMaterialId(const GLMeshInstance& instance);
+        JU::uint32 getMeshId(const GLMesh* mesh);
+        JU::f32 getDepth(const glm::mat4& model) const;
+        void sort();
+
+        glm::mat4                                       view_;
+        glm::mat4                                       projection_;
+        std::vector<Item>                               vItems_;
+        std::vector<SortEntry>                          vEntries_;
+        std::vector<SortEntry>                          vScratch_;      //!< Second buffer of the radix sort
+        std::vector<const GLSLProgram*>                 vPrograms_;     //!< Programs of the frame (their id is the index)
+        std::vector<const GLMeshInstance*>              vMaterials_;    //!< First instance with each material
+        JU::uint32                                      last_material_; //!< Id found by the last lookup
+        std::unordered_map<const GLMesh*, JU::uint32>   hmMeshes_;
+        Stats                                           stats_;
+};
+
+} /* namespace JU */
+
+#endif /* RENDERQUEUE_HPP_ */
@@ -8,139 +8,33 @@
 // Local includes
 #include "ShapeHelper2.hpp"
 #include "Mesh2.hpp"		// Mesh2
-
-// Global includes
-#include <unordered_map>    // std::unordered_map
-#include <map>              // std::map
-#include <functional>       // std::function, std::hash
+#include "VertexWelder.hpp" // VertexWelder
 
 namespace JU
 {
 
-bool vec3Compare(const glm::vec3& a, const glm::vec3& b)
-{
-	const JU::f32 EPSILON = 0.00001f;
-
-	if (fabsf(a[0] - b[0]) > EPSILON)
-		return a[0] < b[0];
-
-    if (fabsf(a[1] - b[1]) > EPSILON)
-        return a[1] < b[1];
-
-    if (fabsf(a[2] - b[2]) > EPSILON)
-        return a[2] < b[2];
-
-	return false;
-}
-
-bool vec2Compare(const glm::vec2& a, const glm::vec2& b)
-{
-    const JU::f32 EPSILON = 0.00001f;
-
-    if (fabsf(a[0] - b[0]) > EPSILON)
-        return a[0] < b[0];
-
-    if (fabsf(a[1] - b[1]) > EPSILON)
-        return a[1] < b[1];
-
-    return false;
-}
-
-// Custom hash function
-size_t vertexIndicesHash(const VertexIndices& vertex)
-{
-    return (  std::hash<JU::uint32>()(vertex.position_)
-            ^ std::hash<JU::uint32>()(vertex.normal_)
-            ^ std::hash<JU::uint32>()(vertex.tex_));
-}
-// TYPEDEFS
-typedef std::map<glm::vec3, int, std::function<decltype(vec3Compare)> > MapVec3;
-typedef MapVec3::const_iterator MapVec3ConstIter;
-typedef std::map<glm::vec2, int, std::function<decltype(vec2Compare)> > MapVec2;
-typedef MapVec2::const_iterator MapVec2ConstIter;
-typedef std::unordered_map<VertexIndices, int, std::function<decltype(vertexIndicesHash)> > HashMapVertexIndices;
-typedef HashMapVertexIndices::const_iterator HashMapVertexIndicesConstIter;
-
-
-
 /**
 * @brief Helper function
 *
 * Helper function to aid the buildShape functions in handling vertex duplication
 *
 * @oaram vertex             The new vertex data
-* @oaram mPositions    	A hash map with all the positions and their indices
-* @param mNormals          A hash map with all the normals and their indices
-* @param mTexCoords        A hash map with all the texture coordinates and their indices
-* @param hmVertexIndices    A hash map with all the vertex indices (position, normal, tex) and their indices into the corresponding vector
-* @param vPositions			Vector with all the vertex positions, indexed with the value stored in its corresponding hash map
-* @param vNormals			Vector with all the vertex normals, indexed with the value stored in its corresponding hash map
-* @param vTexCoords			Vector with all the vertex texture coordinates, indexed with the value stored in its corresponding hash map
-* @param vVertexIndices		Vector with all the vertex indices(position, normal, tex), indexed with the value stored in its corresponding hash map
+* @param welder             Hash tables with all the positions, normals, texture coordinates and vertices so far
+* @param vPositions			Vector with all the vertex positions
+* @param vNormals			Vector with all the vertex normals
+* @param vTexCoords			Vector with all the vertex texture coordinates
+* @param vVertexIndices		Vector with all the vertex indices(position, normal, tex)
 *
 * @return The index to retrieve this vector from the vector of vertex indices (vVertexIndices)
 */
 inline VertexIndex processVertex(const ShapeHelper2::Vertex& vertex,
-                                 MapVec3& mPositions,
-                                 MapVec3& mNormals,
-                                 MapVec2& mTexCoords,
-                                 HashMapVertexIndices& hmVertexIndices,
+                                 VertexWelder& welder,
                                  VectorPositions& vPositions,
                                  VectorNormals& vNormals,
                                  VectorTexCoords& vTexCoords,
                                  VectorVertexIndices& vVertexIndices)
 {
-    VertexIndex vertex_index;
-
-    // POSITION
-    //---------
-    JU::uint32 pos_index;
-    MapVec3ConstIter pos_iter = mPositions.find(vertex.position_);
-    if (pos_iter == mPositions.end())
-    {
-    	mPositions[vertex.position_] = pos_index = vPositions.size();
-    	vPositions.push_back(vertex.position_);
-    }
-    else
-    	pos_index = pos_iter->second;
-
-    // NORMAL
-    //---------
-    JU::uint32 normal_index;
-    MapVec3ConstIter normal_iter = mNormals.find(vertex.normal_);
-    if (normal_iter == mNormals.end())
-    {
-    	mNormals[vertex.normal_] = normal_index = vNormals.size();
-    	vNormals.push_back(vertex.normal_);
-    }
-    else
-    	normal_index = normal_iter->second;
-
-    // TEXTURE COORDINATE
-    //---------
-    JU::uint32 tex_index;
-    MapVec2ConstIter tex_iter = mTexCoords.find(vertex.tex_coords_);
-    if (tex_iter == mTexCoords.end())
-    {
-    	mTexCoords[vertex.tex_coords_] = tex_index = vTexCoords.size();
-    	vTexCoords.push_back(vertex.tex_coords_);
-    }
-    else
-    	tex_index = tex_iter->second;
-
-
-    // VERTEX: Does this vertex already exist?
-    VertexIndices vertex_indices (pos_index, normal_index, tex_index);
-    HashMapVertexIndicesConstIter vtx_iter = hmVertexIndices.find(vertex_indices);
-    if (vtx_iter == hmVertexIndices.end())
-    {
-        hmVertexIndices[vertex_indices] = vertex_index = vVertexIndices.size();
-        vVertexIndices.push_back(vertex_indices);
-    }
-    else
-        vertex_index = vtx_iter->second;
-
-    return vertex_index;
+    return welder.addVertex(vertex.position_, vertex.normal_, vertex.tex_coords_, vPositions, vNormals, vTexCoords, vVertexIndices);
 }
 
 
@@ -154,7 +48,7 @@ inline VertexIndex processVertex(const ShapeHelper2::Vertex& vertex,
 * @oaram v1                 Vertex of quad
 * @oaram v2                 Vertex of quad
 * @oaram v3                 Vertex of quad
-* @oaram hmVertexIndices    A hash map with all the vertex indices per vertex-key
+* @param welder             Hash tables with all the vertex attributes and vertices so far
 * @param vVertices          A vector with all the vertices
 * @param vIndices           A vector with all the indices to the vertices
 *
@@ -163,19 +57,16 @@ inline VertexIndex processVertex(const ShapeHelper2::Vertex& vertex,
 inline void addTriangle(const ShapeHelper2::Vertex& 	v0,
                         const ShapeHelper2::Vertex& 	v1,
                         const ShapeHelper2::Vertex& 	v2,
-                        MapVec3& 					    mPositions,
-						MapVec3& 					    mNormals,
-						MapVec2& 					    mTexCoords,
-						HashMapVertexIndices& 			hmVertexIndices,
+                        VertexWelder& 					welder,
 						VectorPositions& 		vPositions,
 						VectorNormals& 			vNormals,
 						VectorTexCoords& 		vTexCoords,
 						VectorVertexIndices& 	vVertexIndices,
 						VectorTriangleIndices& 	vTriangleIndices)
 {
-	VertexIndex v0_index (processVertex(v0, mPositions, mNormals, mTexCoords, hmVertexIndices, vPositions, vNormals, vTexCoords, vVertexIndices));
-	VertexIndex v1_index (processVertex(v1, mPositions, mNormals, mTexCoords, hmVertexIndices, vPositions, vNormals, vTexCoords, vVertexIndices));
-	VertexIndex v2_index (processVertex(v2, mPositions, mNormals, mTexCoords, hmVertexIndices, vPositions, vNormals, vTexCoords, vVertexIndices));
+	VertexIndex v0_index (processVertex(v0, welder, vPositions, vNormals, vTexCoords, vVertexIndices));
+	VertexIndex v1_index (processVertex(v1, welder, vPositions, vNormals, vTexCoords, vVertexIndices));
+	VertexIndex v2_index (processVertex(v2, welder, vPositions, vNormals, vTexCoords, vVertexIndices));
 
 	vTriangleIndices.push_back(TriangleIndices(v0_index, v1_index, v2_index));
 }
@@ -191,7 +82,7 @@ inline void addTriangle(const ShapeHelper2::Vertex& 	v0,
 * @oaram v1                 Vertex of quad
 * @oaram v2                 Vertex of quad
 * @oaram v3                 Vertex of quad
-* @oaram hmVertexIndices    A hash map with all the vertex indices per vertex-key
+* @param welder             Hash tables with all the vertex attributes and vertices so far
 * @param vVertices          A vector with all the vertices
 * @param vIndices           A vector with all the indices to the vertices
 *
@@ -201,18 +92,15 @@ inline void addTriangulatedQuad(const ShapeHelper2::Vertex& v0,
                                 const ShapeHelper2::Vertex& v1,
                                 const ShapeHelper2::Vertex& v2,
                                 const ShapeHelper2::Vertex& v3,
-                                MapVec3& 				    mPositions,
-                                MapVec3& 				    mNormals,
-                                MapVec2& 				    mTexCoords,
-                                HashMapVertexIndices& 		hmVertexIndices,
+                                VertexWelder& 					welder,
                                 VectorPositions& 	vPositions,
                                 VectorNormals& 		vNormals,
                                 VectorTexCoords& 	vTexCoords,
                                 VectorVertexIndices& vVertexIndices,
   							    VectorTriangleIndices& vTriangleIndices)
 {
-    addTriangle(v0, v1, v2, mPositions, mNormals, mTexCoords, hmVertexIndices, vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
-    addTriangle(v0, v2, v3, mPositions, mNormals, mTexCoords, hmVertexIndices, vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
+    addTriangle(v0, v1, v2, welder, vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
+    addTriangle(v0, v2, v3, welder, vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 }
 
 
@@ -340,10 +228,7 @@ void ShapeHelper2::buildPlane(VectorPositions&  	 vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;						// Vertex data
-    MapVec3 mPositions	(vec3Compare);
-    MapVec3 mNormals  	(vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(8, vertexIndicesHash);		// Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, 8);		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0(-0.5f,  0.5f, 0.0f, // position
                0.0f,  0.0f, 1.0f, // normal
@@ -359,7 +244,7 @@ void ShapeHelper2::buildPlane(VectorPositions&  	 vPositions,
                1.0f,  1.0f);      // texture coordinates
 
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 }
 
@@ -377,10 +262,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;						// Vertex data
-    MapVec3 mPositions	(vec3Compare);
-    MapVec3 mNormals  	(vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(30, vertexIndicesHash);		// Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, 30);		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0, v1, v2, v3;
 
@@ -398,7 +280,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                  0.0f, 0.0f, 1.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
     // Face 1: normal (0, 0, -1)
@@ -415,7 +297,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                  0.0f, 0.0f,-1.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
     // Face 2: normal (1, 0, 0)
@@ -432,7 +314,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                  1.0f, 0.0f, 0.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
     // Face 3: normal (-1, 0, 0)
@@ -449,7 +331,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                 -1.0f, 0.0f, 0.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
     // Face 4: normal (0, 1, 0)
@@ -466,7 +348,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                  0.0f, 1.0f, 0.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
     // Face 5: normal (0, -1, 0)
@@ -483,7 +365,7 @@ void ShapeHelper2::buildCube(VectorPositions&  		vPositions,
                  0.0f,-1.0f, 0.0f, // normal
                  1.0f, 1.0f);      // texture coordinates
     addTriangulatedQuad(v0, v1, v2, v3,
-    					mPositions, mNormals, mTexCoords, hmVertexIndices,
+    					welder,
     					vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 }
 
@@ -515,10 +397,7 @@ void ShapeHelper2::buildCylinder(VectorPositions&  		vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;						// Vertex data
-    MapVec3 mPositions	(vec3Compare);
-    MapVec3 mNormals  	(vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(10 * num_slices, vertexIndicesHash);		// Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, 4 * (num_slices + 1));		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0, v1, v2, v3;
 
@@ -543,7 +422,7 @@ void ShapeHelper2::buildCylinder(VectorPositions&  		vPositions,
                     top_normal, // normal
                     glm::vec2(x2 + 0.5f, y2 + 0.5f));      // texture coordinates
         addTriangle(v0, v1, v2,
-        			mPositions, mNormals, mTexCoords, hmVertexIndices,
+        			welder,
         			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -570,7 +449,7 @@ void ShapeHelper2::buildCylinder(VectorPositions&  		vPositions,
         			bottom_normal, // normal
                     glm::vec2(-x1 + 0.5f, y1 + 0.5f));      // texture coordinates
         addTriangle(v0, v1, v2,
-        			mPositions, mNormals, mTexCoords, hmVertexIndices,
+        			welder,
         			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -603,7 +482,7 @@ void ShapeHelper2::buildCylinder(VectorPositions&  		vPositions,
         			norm2, // normal
                     glm::vec2(s2, 1.0f));      // texture coordinates
         addTriangulatedQuad(v0, v1, v2, v3,
-        			mPositions, mNormals, mTexCoords, hmVertexIndices,
+        			welder,
         			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -639,10 +518,7 @@ void ShapeHelper2::buildCone(VectorPositions&  		vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;                      // Vertex data
-    MapVec3 mPositions (vec3Compare);
-    MapVec3 mNormals   (vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(10 * num_slices, vertexIndicesHash);       // Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, 3 * (num_slices + 1));		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0, v1, v2, v3;
 
@@ -667,7 +543,7 @@ void ShapeHelper2::buildCone(VectorPositions&  		vPositions,
                     bottom_normal, // normal
                     glm::vec2(-x1 + 0.5f, y1 + 0.5f));      // texture coordinates
         addTriangle(v0, v1, v2,
-                    mPositions, mNormals, mTexCoords, hmVertexIndices,
+                    welder,
                     vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -703,7 +579,7 @@ void ShapeHelper2::buildCone(VectorPositions&  		vPositions,
                     norm2, // normal
                     glm::vec2(s2, 0.0f));      // texture coordinates
         addTriangle(v0, v1, v2,
-                    mPositions, mNormals, mTexCoords, hmVertexIndices,
+                    welder,
                     vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -742,10 +618,7 @@ void ShapeHelper2::buildSphere(VectorPositions&  	  vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;						// Vertex data
-    MapVec3 mPositions	(vec3Compare);
-    MapVec3 mNormals  	(vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(10 * num_slices, vertexIndicesHash);		// Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, (num_slices + 1) * (num_stacks + 1));		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0, v1, v2, v3;
 
@@ -779,7 +652,7 @@ void ShapeHelper2::buildSphere(VectorPositions&  	  vPositions,
                     norm2, // normal
                     glm::vec2(s2, t));      // texture coordinates
         addTriangle(v0, v1, v2,
-        			mPositions, mNormals, mTexCoords, hmVertexIndices,
+        			welder,
         			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -815,7 +688,7 @@ void ShapeHelper2::buildSphere(VectorPositions&  	  vPositions,
                     bottom_normal, // normal
                     glm::vec2(0.5f * (s1 + s2), 0.0f));      // texture coordinates
         addTriangle(v0, v1, v2,
-        			mPositions, mNormals, mTexCoords, hmVertexIndices,
+        			welder,
         			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
 
         theta += DELTA_THETA;
@@ -869,7 +742,7 @@ void ShapeHelper2::buildSphere(VectorPositions&  	  vPositions,
             			norm3, // normal
                         glm::vec2(s2, t1));      // texture coordinates
             addTriangulatedQuad(v0, v1, v2, v3,
-            			mPositions, mNormals, mTexCoords, hmVertexIndices,
+            			welder,
             			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
         }
     }
@@ -913,10 +786,7 @@ void ShapeHelper2::buildTorus(VectorPositions&  	  vPositions,
     vVertexIndices.clear();
 
     Vertex vertex;						// Vertex data
-    MapVec3 mPositions	(vec3Compare);
-    MapVec3 mNormals  	(vec3Compare);
-    MapVec2 mTexCoords (vec2Compare);
-    HashMapVertexIndices hmVertexIndices(10 * num_slices1 * num_slices2, vertexIndicesHash);		// Hash map to keep track of uniqueness of vertices and their indices
+    VertexWelder welder (VertexWelder::DEFAULT_EPSILON, (num_slices1 + 1) * (num_slices2 + 1));		// Hash tables to keep track of uniqueness of vertices and their indices
 
     Vertex v0, v1, v2, v3;
 
@@ -971,7 +841,7 @@ void ShapeHelper2::buildTorus(VectorPositions&  	  vPositions,
             			norm3, // normal
                         glm::vec2(s2, t1));      // texture coordinates
             addTriangulatedQuad(v0, v1, v2, v3,
-            			mPositions, mNormals, mTexCoords, hmVertexIndices,
+            			welder,
             			vPositions, vNormals, vTexCoords, vVertexIndices, vTriangleIndices);
     	}
     }
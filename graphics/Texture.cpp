@@ -7,6 +7,7 @@
 
 // Local includes
 #include "Texture.hpp"
+#include "GLStateCache.hpp"         // GLStateCache
 
 // Global includes
 #include <SOIL/SOIL.h>                   // SOIL_load_image
@@ -60,7 +61,7 @@ bool Texture::load()
     // Flip the image vertically
     JU::imageInvertVertically(width, height, channels, image);
 
-    gl::BindTexture(gl::TEXTURE_2D, handle_);
+    GLStateCache::bindTexture(gl::TEXTURE_2D, handle_);
     gl::TexImage2D(gl::TEXTURE_2D, 0, mode, width, height, 0, mode, gl::UNSIGNED_BYTE, image);
 
     GLfloat filtering_mode = gl::NEAREST;
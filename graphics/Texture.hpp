@@ -10,6 +10,7 @@
 
 // Local includes
 #include "gl_core_4_2.hpp"            // glLoadGen generated header file
+#include "GLStateCache.hpp"           // GLStateCache
 
 // Global includes
 #include "../core/Defs.hpp"  // Basic type typedefs
@@ -31,7 +32,7 @@ class Texture
         virtual bool load();
         virtual void bind() const
         {
-        	gl::BindTexture(gl::TEXTURE_2D, handle_);
+        	GLStateCache::bindTexture(gl::TEXTURE_2D, handle_);
         }
         JU::uint32 getHandle() const;
 
@@ -9,6 +9,7 @@
 #include "TextureManager.hpp"       // Class declaration
 #include "GLSLProgram.hpp"          // GLSLProgram
 #include "ImageHelper.hpp"			// imageInvertVertically
+#include "GLStateCache.hpp"         // GLStateCache
 // Global includes
 #include <SOIL/SOIL.h>                   // SOIL_load_image
 #include <iostream>                 // cout, endl
@@ -60,7 +61,7 @@ bool TextureManager::loadTexture(const std::string &texture_name, const std::str
     // Flip the image vertically
     JU::imageInvertVertically(width, height, channels, image);
 
-    gl::BindTexture(gl::TEXTURE_2D, texture_map_[texture_name]);
+    GLStateCache::bindTexture(gl::TEXTURE_2D, texture_map_[texture_name]);
     gl::TexImage2D(gl::TEXTURE_2D, 0, mode, width, height, 0, mode, gl::UNSIGNED_BYTE, image);
 
 
@@ -98,7 +99,7 @@ bool TextureManager::registerTexture(const std::string &texture_name, JU::uint32
 
 void TextureManager::bindTexture(const std::string &texture_name)
 {
-    gl::BindTexture(gl::TEXTURE_2D, texture_map_[texture_name]);
+    GLStateCache::bindTexture(gl::TEXTURE_2D, texture_map_[texture_name]);
 }
 
 
@@ -111,8 +112,7 @@ void TextureManager::bindTexture(const GLSLProgram &program, const std::string &
 
 void TextureManager::bindTexture(const GLSLProgram &program, JU::uint32 tex_id, const std::string &uniform_name)
 {
-    gl::ActiveTexture(gl::TEXTURE0 + num_tex_bound_);
-    gl::BindTexture(gl::TEXTURE_2D, tex_id);
+    GLStateCache::bindTexture(num_tex_bound_, gl::TEXTURE_2D, tex_id);
 
     program.setUniform(uniform_name.c_str(), num_tex_bound_);
 
@@ -133,7 +133,7 @@ void TextureManager::deleteTexture(const std::string& texture_name)
     TextureMapIterator iter = texture_map_.find(texture_name);
 
     if (iter != texture_map_.end())
-        gl::DeleteTextures(1, &iter->second);
+        GLStateCache::deleteTextures(1, &iter->second);
 }
 
 
@@ -143,7 +143,7 @@ void TextureManager::deleteAllTextures()
     TextureMapIterator iter = texture_map_.begin();
     for(; iter != texture_map_.end(); ++iter)
     {
-    	gl::DeleteTextures(1, &iter->second);
+    	GLStateCache::deleteTextures(1, &iter->second);
     }
 }
 
@@ -0,0 +1,299 @@
+/*
+ * UniformBlockManager.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "UniformBlockManager.hpp"
+#include "GLSLProgram.hpp"          // GLSLProgram
+#include "Material.hpp"             // Material
+#include "GLStateCache.hpp"         // GLStateCache
+// Global includes
+#include <cstdio>                   // std::printf
+#include <cstring>                  // std::memset, std::memcmp
+#include <algorithm>                // std::min
+
+namespace JU
+{
+
+// STATIC MEMBER VARIABLES
+// -----------------------
+const char* UniformBlockManager::CAMERA_BLOCK_STRING    = "CameraBlock";
+const char* UniformBlockManager::LIGHTS_BLOCK_STRING    = "LightsBlock";
+const char* UniformBlockManager::MATERIAL_BLOCK_STRING  = "MaterialBlock";
+
+GLuint UniformBlockManager::ubo_handles_[NUM_BINDINGS] = { 0, 0, 0 };
+UniformBlockManager::CameraBlock UniformBlockManager::camera_;
+bool UniformBlockManager::has_camera_ = false;
+UniformBlockManager::LightsBlock UniformBlockManager::lights_;
+UniformBlockManager::MaterialBlock UniformBlockManager::material_;
+bool UniformBlockManager::has_material_ = false;
+
+
+
+// STATIC MEMBER FUNCTIONS
+// -----------------------
+
+/**
+* @brief Create the buffers and bind them to their binding points
+*
+* @return True if the buffers were created (or already were)
+*/
+bool UniformBlockManager::init()
+{
+    if (isInitialized())
+        return true;
+
+    const JU::uint32 sizes[NUM_BINDINGS] = { sizeof(CameraBlock), sizeof(LightsBlock), sizeof(MaterialBlock) };
+
+    gl::GenBuffers(NUM_BINDINGS, ubo_handles_);
+
+    for (JU::uint32 binding = 0; binding < NUM_BINDINGS; ++binding)
+    {
+        if (!ubo_handles_[binding])
+        {
+            std::printf("%s: %s: could not create the uniform buffers\n", __FILE__, __FUNCTION__);
+            release();
+            return false;
+        }
+
+        GLStateCache::bindBuffer(gl::UNIFORM_BUFFER, ubo_handles_[binding]);
+        gl::BufferData(gl::UNIFORM_BUFFER, sizes[binding], NULL, gl::DYNAMIC_DRAW);
+        gl::BindBufferBase(gl::UNIFORM_BUFFER, binding, ubo_handles_[binding]);
+    }
+
+    // No lights until they are set
+    std::memset(&lights_, 0, sizeof(lights_));
+    update(LIGHTS_BINDING, &lights_, sizeof(lights_));
+
+    has_camera_   = false;
+    has_material_ = false;
+
+    return true;
+}
+
+
+
+/**
+* @brief Delete the buffers
+*/
+void UniformBlockManager::release()
+{
+    for (JU::uint32 binding = 0; binding < NUM_BINDINGS; ++binding)
+    {
+        if (ubo_handles_[binding])
+            GLStateCache::deleteBuffers(1, &ubo_handles_[binding]);
+
+        ubo_handles_[binding] = 0;
+    }
+
+    has_camera_   = false;
+    has_material_ = false;
+}
+
+
+
+/**
+* @brief Connect the blocks the program declares to the binding points of the buffers
+*
+* @param program Linked program (it can declare any subset of the blocks)
+*/
+void UniformBlockManager::attachProgram(const GLSLProgram& program)
+{
+    program.bindUniformBlock(CAMERA_BLOCK_STRING,   CAMERA_BINDING);
+    program.bindUniformBlock(LIGHTS_BLOCK_STRING,   LIGHTS_BINDING);
+    program.bindUniformBlock(MATERIAL_BLOCK_STRING, MATERIAL_BINDING);
+}
+
+
+
+/**
+* @brief Set the camera of the frame
+*
+* @detail Everything that draws with the camera sets it (RenderQueue, GLInstanceBatch, GLMeshInstance::draw), so the
+*         buffer is only updated when the camera changes: once per frame.
+*
+* @param view       View matrix
+* @param projection Projection matrix
+*/
+void UniformBlockManager::setCamera(const glm::mat4& view, const glm::mat4& projection)
+{
+    if (has_camera_ && std::memcmp(&camera_.view_, &view, sizeof(view)) == 0 &&
+                       std::memcmp(&camera_.projection_, &projection, sizeof(projection)) == 0)
+        return;
+
+    camera_.view_            = view;
+    camera_.projection_      = projection;
+    camera_.view_projection_ = projection * view;
+    camera_.position_        = glm::inverse(view)[3];
+    has_camera_              = true;
+
+    update(CAMERA_BINDING, &camera_, sizeof(camera_));
+}
+
+
+
+/**
+* @brief Set the lights (only the first MAX_LIGHTS of each type are kept)
+*/
+void UniformBlockManager::setLights(const LightPositionalVector&  positional,
+                                    const LightDirectionalVector& directional,
+                                    const LightSpotlightVector&   spotlight)
+{
+    LightsBlock lights (lights_);
+
+    fillLights(lights, positional);
+    fillLights(lights, directional);
+    fillLights(lights, spotlight);
+
+    updateLights(lights);
+}
+
+
+
+/**
+* @brief Set the positional lights, keeping the other types (only the first MAX_LIGHTS are kept)
+*/
+void UniformBlockManager::setPositionalLights(const LightPositionalVector& positional)
+{
+    LightsBlock lights (lights_);
+    fillLights(lights, positional);
+    updateLights(lights);
+}
+
+
+
+/**
+* @brief Set the directional lights, keeping the other types (only the first MAX_LIGHTS are kept)
+*/
+void UniformBlockManager::setDirectionalLights(const LightDirectionalVector& directional)
+{
+    LightsBlock lights (lights_);
+    fillLights(lights, directional);
+    updateLights(lights);
+}
+
+
+
+/**
+* @brief Set the spotlights, keeping the other types (only the first MAX_LIGHTS are kept)
+*/
+void UniformBlockManager::setSpotlights(const LightSpotlightVector& spotlight)
+{
+    LightsBlock lights (lights_);
+    fillLights(lights, spotlight);
+    updateLights(lights);
+}
+
+
+
+/**
+* @brief Set the material of the next draws
+*
+* @detail Consecutive draws often share the material, so the buffer is only updated when the material changes.
+*/
+void UniformBlockManager::setMaterial(const Material& material)
+{
+    MaterialBlock block;
+    std::memset(&block, 0, sizeof(block));
+
+    block.ka_        = material.ka_;
+    block.kd_        = material.kd_;
+    block.ks_        = material.ks_;
+    block.shininess_ = material.shininess_;
+
+    if (has_material_ && std::memcmp(&block, &material_, sizeof(block)) == 0)
+        return;
+
+    material_     = block;
+    has_material_ = true;
+
+    update(MATERIAL_BINDING, &block, sizeof(block));
+}
+
+
+
+bool UniformBlockManager::isInitialized()
+{
+    return ubo_handles_[0] != 0;
+}
+
+
+
+void UniformBlockManager::fillLights(LightsBlock& lights, const LightPositionalVector& positional)
+{
+    std::memset(lights.positional_, 0, sizeof(lights.positional_));
+    lights.num_positional_ = std::min<JU::uint32>(positional.size(), MAX_LIGHTS);
+
+    for (JU::int32 index = 0; index < lights.num_positional_; ++index)
+    {
+        lights.positional_[index].position_  = positional[index].position_;
+        lights.positional_[index].intensity_ = positional[index].intensity_;
+    }
+}
+
+
+
+void UniformBlockManager::fillLights(LightsBlock& lights, const LightDirectionalVector& directional)
+{
+    std::memset(lights.directional_, 0, sizeof(lights.directional_));
+    lights.num_directional_ = std::min<JU::uint32>(directional.size(), MAX_LIGHTS);
+
+    for (JU::int32 index = 0; index < lights.num_directional_; ++index)
+    {
+        lights.directional_[index].direction_ = directional[index].direction_;
+        lights.directional_[index].intensity_ = directional[index].intensity_;
+    }
+}
+
+
+
+void UniformBlockManager::fillLights(LightsBlock& lights, const LightSpotlightVector& spotlight)
+{
+    std::memset(lights.spotlight_, 0, sizeof(lights.spotlight_));
+    lights.num_spotlight_ = std::min<JU::uint32>(spotlight.size(), MAX_LIGHTS);
+
+    for (JU::int32 index = 0; index < lights.num_spotlight_; ++index)
+    {
+        lights.spotlight_[index].position_  = spotlight[index].position_;
+        lights.spotlight_[index].direction_ = spotlight[index].direction_;
+        lights.spotlight_[index].intensity_ = spotlight[index].intensity_;
+        lights.spotlight_[index].cutoff_    = spotlight[index].cutoff_;
+    }
+}
+
+
+
+/**
+* @brief Upload the lights if they changed (the lights are usually set every frame but rarely move)
+*/
+void UniformBlockManager::updateLights(const LightsBlock& lights)
+{
+    if (std::memcmp(&lights, &lights_, sizeof(lights)) == 0)
+        return;
+
+    lights_ = lights;
+
+    update(LIGHTS_BINDING, &lights_, sizeof(lights_));
+}
+
+
+
+/**
+* @brief Replace the contents of a buffer
+*
+* @detail The buffer is orphaned first, so GL does not wait for the draws that still read the old contents.
+*/
+void UniformBlockManager::update(Binding binding, const void* data, JU::uint32 size)
+{
+    if (!ubo_handles_[binding])
+        return;
+
+    GLStateCache::bindBuffer(gl::UNIFORM_BUFFER, ubo_handles_[binding]);
+    gl::BufferData(gl::UNIFORM_BUFFER, size, NULL, gl::DYNAMIC_DRAW);
+    gl::BufferSubData(gl::UNIFORM_BUFFER, 0, size, data);
+}
+
+} /* namespace JU */
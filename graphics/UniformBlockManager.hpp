@@ -0,0 +1,150 @@
+/*
+ * UniformBlockManager.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef UNIFORMBLOCKMANAGER_HPP_
+#define UNIFORMBLOCKMANAGER_HPP_
+
+// Local includes
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+#include "../core/Defs.hpp"     // uint32, int32, f32
+#include "Lights.hpp"           // LightPositionalVector, LightDirectionalVector, LightSpotlightVector
+// Global includes
+#include <glm/glm.hpp>          // glm::mat4, glm::vec3
+
+namespace JU
+{
+
+// Forward declarations
+class GLSLProgram;
+struct Material;
+
+/**
+ * @brief Static class that owns the std140 uniform buffers shared by all the GLSLPrograms
+ *
+ * @details There is one buffer per block, bound to a fixed binding point: the camera (set once per frame), the lights
+ *          (set when they change) and the material (set when it changes between draws). 'attachProgram' connects the
+ *          blocks a program declares to their binding points. The shaders declare them as:
+ *
+ *          layout(std140) uniform CameraBlock   { mat4 ViewMatrix; mat4 ProjectionMatrix; mat4 ViewProjectionMatrix; vec4 CameraPosition; };
+ *          struct PositionalLight  { vec3 position; vec3 intensity; };
+ *          struct DirectionalLight { vec3 direction; vec3 intensity; };
+ *          struct Spotlight        { vec3 position; vec3 direction; vec3 intensity; float cutoff; };
+ *          layout(std140) uniform LightsBlock   { int num_pos_lights; int num_dir_lights; int num_spot_lights;
+ *                                                 PositionalLight light_pos[8]; DirectionalLight light_dir[8]; Spotlight light_spot[8]; };
+ *          layout(std140) uniform MaterialBlock { vec3 Ka; vec3 Kd; vec3 Ks; float shininess; } material;
+ *
+ *          The structs below mirror the std140 layout of each block. A program that declares CameraBlock only gets the
+ *          "Model" matrix per draw (see GLMeshInstance) and derives the rest: ModelViewMatrix = ViewMatrix * Model,
+ *          MVP = ViewProjectionMatrix * Model and NormalMatrix = mat3(ModelViewMatrix).
+ */
+class UniformBlockManager
+{
+    public:
+        enum Binding
+        {
+            CAMERA_BINDING,
+            LIGHTS_BINDING,
+            MATERIAL_BINDING,
+            NUM_BINDINGS
+        };
+
+        static const JU::uint32 MAX_LIGHTS = 8;     //!< Lights of each type in the lights block
+
+        static const char* CAMERA_BLOCK_STRING;
+        static const char* LIGHTS_BLOCK_STRING;
+        static const char* MATERIAL_BLOCK_STRING;
+
+        struct CameraBlock
+        {
+            glm::mat4 view_;
+            glm::mat4 projection_;
+            glm::mat4 view_projection_;
+            glm::vec4 position_;            //!< Camera position in world space (w = 1)
+        };
+
+        struct LightsBlock
+        {
+            struct Positional
+            {
+                glm::vec3 position_;
+                JU::f32   padding0_;
+                glm::vec3 intensity_;
+                JU::f32   padding1_;
+            };
+
+            struct Directional
+            {
+                glm::vec3 direction_;
+                JU::f32   padding0_;
+                glm::vec3 intensity_;
+                JU::f32   padding1_;
+            };
+
+            struct Spotlight
+            {
+                glm::vec3 position_;
+                JU::f32   padding0_;
+                glm::vec3 direction_;
+                JU::f32   padding1_;
+                glm::vec3 intensity_;
+                JU::f32   cutoff_;
+            };
+
+            JU::int32   num_positional_;
+            JU::int32   num_directional_;
+            JU::int32   num_spotlight_;
+            JU::int32   padding_;
+            Positional  positional_[MAX_LIGHTS];
+            Directional directional_[MAX_LIGHTS];
+            Spotlight   spotlight_[MAX_LIGHTS];
+        };
+
+        struct MaterialBlock
+        {
+            glm::vec3 ka_;
+            JU::f32   padding0_;
+            glm::vec3 kd_;
+            JU::f32   padding1_;
+            glm::vec3 ks_;
+            JU::f32   shininess_;
+        };
+
+    public:
+        static bool init();
+        static void release();
+        static void attachProgram(const GLSLProgram& program);
+
+        static void setCamera(const glm::mat4& view, const glm::mat4& projection);
+        static void setLights(const LightPositionalVector&  positional,
+                              const LightDirectionalVector& directional,
+                              const LightSpotlightVector&   spotlight);
+        static void setPositionalLights(const LightPositionalVector& positional);
+        static void setDirectionalLights(const LightDirectionalVector& directional);
+        static void setSpotlights(const LightSpotlightVector& spotlight);
+        static void setMaterial(const Material& material);
+
+        static bool isInitialized();
+
+    private:
+        static void fillLights(LightsBlock& lights, const LightPositionalVector& positional);
+        static void fillLights(LightsBlock& lights, const LightDirectionalVector& directional);
+        static void fillLights(LightsBlock& lights, const LightSpotlightVector& spotlight);
+        static void updateLights(const LightsBlock& lights);
+        static void update(Binding binding, const void* data, JU::uint32 size);
+
+    private:
+        static GLuint           ubo_handles_[NUM_BINDINGS];
+        static CameraBlock      camera_;            //!< Camera in the buffer (to skip the updates that change nothing)
+        static bool             has_camera_;        //!< Is there any camera in the buffer yet?
+        static LightsBlock      lights_;            //!< Lights in the buffer (each type can be set on its own)
+        static MaterialBlock    material_;          //!< Material in the buffer (to skip the updates that change nothing)
+        static bool             has_material_;      //!< Is there any material in the buffer yet?
+};
+
+} /* namespace JU */
+
+#endif /* UNIFORMBLOCKMANAGER_HPP_ */
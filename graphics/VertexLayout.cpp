@@ -0,0 +1,202 @@
+/*
+ * VertexLayout.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "VertexLayout.hpp"
+#include "Mesh2.hpp"            // Mesh2
+#include "GLSLProgram.hpp"      // static constants for attribute locations
+#include "gl_core_4_2.hpp"      // glLoadGen generated header file
+
+namespace JU
+{
+
+/**
+* @brief Non-Default Constructor
+*
+* @param attributes Bit mask of the attributes in the vertex
+*/
+VertexLayout::VertexLayout(JU::uint32 attributes) : attributes_(attributes & ALL), stride_(0)
+{
+    const Attribute ATTRIBUTES[] = { POSITION, NORMAL, TEXCOORD, TANGENT };
+
+    for (JU::uint32 index = 0; index < 4; ++index)
+        if (has(ATTRIBUTES[index]))
+            stride_ += getNumComponents(ATTRIBUTES[index]) * sizeof(JU::f32);
+}
+
+
+
+/**
+* @brief Layout with all the attributes the mesh has data for
+*
+* @param mesh Mesh2 object
+*
+* @return The layout
+*/
+VertexLayout VertexLayout::fromMesh(const Mesh2& mesh)
+{
+    JU::uint32 attributes = 0;
+
+    if (!mesh.getPositions().empty()) attributes |= POSITION;
+    if (!mesh.getNormals().empty())   attributes |= NORMAL;
+    if (!mesh.getTexCoords().empty()) attributes |= TEXCOORD;
+    if (!mesh.getTangents().empty())  attributes |= TANGENT;
+
+    return VertexLayout(attributes);
+}
+
+
+
+bool VertexLayout::has(Attribute attribute) const
+{
+    return (attributes_ & attribute) != 0;
+}
+
+
+
+JU::uint32 VertexLayout::getAttributes() const
+{
+    return attributes_;
+}
+
+
+
+JU::uint32 VertexLayout::getStride() const
+{
+    return stride_;
+}
+
+
+
+/**
+* @brief Byte offset of an attribute from the start of the vertex
+*
+* @param attribute The attribute (it should be in the layout)
+*
+* @return Offset in bytes
+*/
+JU::uint32 VertexLayout::getOffset(Attribute attribute) const
+{
+    JU::uint32 offset = 0;
+
+    // The attributes are packed in the order of their bits
+    for (JU::uint32 bit = POSITION; bit < attribute; bit <<= 1)
+        if (attributes_ & bit)
+            offset += getNumComponents(static_cast<Attribute>(bit)) * sizeof(JU::f32);
+
+    return offset;
+}
+
+
+
+JU::uint32 VertexLayout::getNumComponents(Attribute attribute)
+{
+    switch (attribute)
+    {
+        case POSITION: return 3;
+        case NORMAL:   return 3;
+        case TEXCOORD: return 2;
+        case TANGENT:  return 4;
+        default:       return 0;
+    }
+}
+
+
+
+/**
+* @brief Expand the mesh vertices (through its vertex indices) into interleaved vertices, in one pass
+*
+* @param mesh     Mesh2 object (it must have data for all the attributes in the layout)
+* @param vertices Interleaved vertices (stride / sizeof(f32) floats per vertex)
+*/
+void VertexLayout::interleave(const Mesh2& mesh, std::vector<JU::f32>& vertices) const
+{
+    const VectorPositions&       vPositions       = mesh.getPositions();
+    const VectorNormals&         vNormals         = mesh.getNormals();
+    const VectorTangents&        vTangents        = mesh.getTangents();
+    const VectorTexCoords&       vTexCoords       = mesh.getTexCoords();
+    const VectorVertexIndices&   vVertexIndices   = mesh.getVertexIndices();
+
+    JU::uint32 num_vertices = vVertexIndices.size();
+    JU::uint32 num_floats   = stride_ / sizeof(JU::f32);
+
+    vertices.resize(num_vertices * num_floats);
+
+    JU::f32* vertex = vertices.empty() ? nullptr : &vertices[0];
+
+    for (JU::uint32 index = 0; index < num_vertices; ++index)
+    {
+        const VertexIndices& indices = vVertexIndices[index];
+
+        if (attributes_ & POSITION)
+        {
+            const glm::vec3& position = vPositions[indices.position_];
+            *vertex++ = position.x;
+            *vertex++ = position.y;
+            *vertex++ = position.z;
+        }
+
+        if (attributes_ & NORMAL)
+        {
+            const glm::vec3& normal = vNormals[indices.normal_];
+            *vertex++ = normal.x;
+            *vertex++ = normal.y;
+            *vertex++ = normal.z;
+        }
+
+        if (attributes_ & TEXCOORD)
+        {
+            const glm::vec2& tex_coord = vTexCoords[indices.tex_];
+            *vertex++ = tex_coord.s;
+            *vertex++ = tex_coord.t;
+        }
+
+        // Tangents are stored per vertex (not indexed)
+        if (attributes_ & TANGENT)
+        {
+            const glm::vec4& tangent = vTangents[index];
+            *vertex++ = tangent.x;
+            *vertex++ = tangent.y;
+            *vertex++ = tangent.z;
+            *vertex++ = tangent.w;
+        }
+    }
+}
+
+
+
+/**
+* @brief Set and enable the attribute pointers for the buffer bound to GL_ARRAY_BUFFER (a VAO must be bound)
+*/
+void VertexLayout::setAttribPointers() const
+{
+    if (attributes_ & POSITION)
+    {
+        gl::VertexAttribPointer(GLSLProgram::POSITION_ATTRIBUTE_LOCATION, getNumComponents(POSITION), gl::FLOAT, gl::FALSE_, stride_, (GLubyte *)NULL + getOffset(POSITION));
+        gl::EnableVertexAttribArray(GLSLProgram::POSITION_ATTRIBUTE_LOCATION);
+    }
+
+    if (attributes_ & NORMAL)
+    {
+        gl::VertexAttribPointer(GLSLProgram::NORMAL_ATTRIBUTE_LOCATION, getNumComponents(NORMAL), gl::FLOAT, gl::FALSE_, stride_, (GLubyte *)NULL + getOffset(NORMAL));
+        gl::EnableVertexAttribArray(GLSLProgram::NORMAL_ATTRIBUTE_LOCATION);
+    }
+
+    if (attributes_ & TEXCOORD)
+    {
+        gl::VertexAttribPointer(GLSLProgram::TEXCOORD_ATTRIBUTE_LOCATION, getNumComponents(TEXCOORD), gl::FLOAT, gl::FALSE_, stride_, (GLubyte *)NULL + getOffset(TEXCOORD));
+        gl::EnableVertexAttribArray(GLSLProgram::TEXCOORD_ATTRIBUTE_LOCATION);
+    }
+
+    if (attributes_ & TANGENT)
+    {
+        gl::VertexAttribPointer(GLSLProgram::TANGENT_ATTRIBUTE_LOCATION, getNumComponents(TANGENT), gl::FLOAT, gl::FALSE_, stride_, (GLubyte *)NULL + getOffset(TANGENT));
+        gl::EnableVertexAttribArray(GLSLProgram::TANGENT_ATTRIBUTE_LOCATION);
+    }
+}
+
+} // namespace JU
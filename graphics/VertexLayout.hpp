@@ -0,0 +1,62 @@
+/*
+ * VertexLayout.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef VERTEXLAYOUT_HPP_
+#define VERTEXLAYOUT_HPP_
+
+// Local includes
+#include "../core/Defs.hpp"     // uint32, f32
+// Global includes
+#include <vector>               // std::vector
+
+namespace JU
+{
+
+// Forward declarations
+class Mesh2;
+
+/**
+ * @brief Description of an interleaved vertex: which attributes it has and where each one is
+ *
+ * @details All the attributes of a vertex are packed together (position, normal, texture coordinates, tangent, in
+ *          that order, skipping the ones not in the layout), so a vertex is fetched with one contiguous read and the
+ *          whole mesh lives in one buffer.
+ */
+class VertexLayout
+{
+    public:
+        enum Attribute
+        {
+            POSITION = 1 << 0,
+            NORMAL   = 1 << 1,
+            TEXCOORD = 1 << 2,
+            TANGENT  = 1 << 3,
+            ALL      = POSITION | NORMAL | TEXCOORD | TANGENT
+        };
+
+    public:
+        VertexLayout(JU::uint32 attributes = ALL);
+
+        static VertexLayout fromMesh(const Mesh2& mesh);
+
+        bool has(Attribute attribute) const;
+        JU::uint32 getAttributes() const;
+        JU::uint32 getStride() const;
+        JU::uint32 getOffset(Attribute attribute) const;
+        static JU::uint32 getNumComponents(Attribute attribute);
+
+        void interleave(const Mesh2& mesh, std::vector<JU::f32>& vertices) const;
+        void setAttribPointers() const;
+
+    private:
+        JU::uint32 attributes_;     //!< Bit mask of Attribute
+        JU::uint32 stride_;         //!< Bytes per vertex
+};
+
+} // namespace JU
+
+#endif /* VERTEXLAYOUT_HPP_ */
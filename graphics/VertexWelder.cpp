@@ -0,0 +1,341 @@
+/*
+ * VertexWelder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+// Local includes
+#include "VertexWelder.hpp"
+// Global includes
+#include <cmath>            // std::floor, std::fabs
+#include <cstring>          // std::memcpy, std::memcmp, std::memset
+
+namespace JU
+{
+
+const JU::f32 VertexWelder::DEFAULT_EPSILON = 0.00001f;
+
+namespace
+{
+    const JU::uint32 INVALID_INDEX    = 0xFFFFFFFF;
+    const JU::uint32 MIN_CAPACITY     = 16;
+    const JU::f32    CELL_SIZE        = 16.0f;  //!< In tolerances: most values are far enough from the cell boundaries
+
+    /**
+    * @brief Smallest power of two that keeps 'expected' entries at most half full
+    */
+    JU::uint32 getCapacity(JU::uint32 expected)
+    {
+        JU::uint32 capacity = MIN_CAPACITY;
+
+        while (capacity < 2 * expected)
+            capacity <<= 1;
+
+        return capacity;
+    }
+
+    /**
+    * @brief Spread the bits of a 64 bit key over the top bits (Fibonacci hashing)
+    */
+    inline JU::uint32 mix(JU::uint64 key)
+    {
+        return static_cast<JU::uint32>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+}
+
+
+
+/**
+* @brief Non-Default Constructor
+*
+* @param epsilon           Largest difference per component between two values considered equal
+* @param expected_vertices Number of vertices expected (to size the tables; they grow if needed)
+*/
+VertexWelder::VertexWelder(JU::f32 epsilon, JU::uint32 expected_vertices)
+    : positions_(3, epsilon, expected_vertices),
+      normals_(3, epsilon, expected_vertices),
+      tex_coords_(2, epsilon, expected_vertices),
+      vertices_(expected_vertices)
+{
+    RecentVertex empty;
+    std::memset(&empty, 0, sizeof(empty));
+    empty.index_ = INVALID_INDEX;
+    recent_.assign(RECENT_SIZE, empty);
+}
+
+
+
+/**
+* @brief Weld a vertex
+*
+* @detail The position, normal and texture coordinates are appended to their vectors only if no equal one is there
+*         yet, and the vertex is appended to the vertex indices only if no vertex with the same three indices is.
+*         The vectors must be the same in every call.
+*
+* @return Index of the vertex in vVertexIndices
+*/
+VertexIndex VertexWelder::addVertex(const glm::vec3&     position,
+                                    const glm::vec3&     normal,
+                                    const glm::vec2&     tex_coords,
+                                    VectorPositions&     vPositions,
+                                    VectorNormals&       vNormals,
+                                    VectorTexCoords&     vTexCoords,
+                                    VectorVertexIndices& vVertexIndices)
+{
+    const JU::f32 p[3] = { position.x, position.y, position.z };
+    const JU::f32 n[3] = { normal.x, normal.y, normal.z };
+    const JU::f32 t[2] = { tex_coords.s, tex_coords.t };
+
+    JU::uint32 bits[8];
+    std::memcpy(&bits[0], p, sizeof(p));
+    std::memcpy(&bits[3], n, sizeof(n));
+    std::memcpy(&bits[6], t, sizeof(t));
+
+    JU::uint64 key = 0;
+    for (JU::uint32 word = 0; word < 8; ++word)
+        key = (key ^ bits[word]) * 0x100000001B3ULL;
+
+    RecentVertex& recent = recent_[mix(key) & (RECENT_SIZE - 1)];
+    if (recent.index_ != INVALID_INDEX && std::memcmp(recent.bits_, bits, sizeof(bits)) == 0)
+        return recent.index_;
+
+    JU::uint32 pos_index = positions_.findOrInsert(p, vPositions.size());
+    if (pos_index == vPositions.size())
+        vPositions.push_back(position);
+
+    JU::uint32 normal_index = normals_.findOrInsert(n, vNormals.size());
+    if (normal_index == vNormals.size())
+        vNormals.push_back(normal);
+
+    JU::uint32 tex_index = tex_coords_.findOrInsert(t, vTexCoords.size());
+    if (tex_index == vTexCoords.size())
+        vTexCoords.push_back(tex_coords);
+
+    VertexIndices vertex_indices (pos_index, normal_index, tex_index);
+
+    JU::uint32 vertex_index = vertices_.findOrInsert(vertex_indices, vVertexIndices.size());
+    if (vertex_index == vVertexIndices.size())
+        vVertexIndices.push_back(vertex_indices);
+
+    std::memcpy(recent.bits_, bits, sizeof(bits));
+    recent.index_ = vertex_index;
+
+    return vertex_index;
+}
+
+
+
+VertexWelder::AttributeTable::AttributeTable(JU::uint32 num_components, JU::f32 epsilon, JU::uint32 expected)
+    : num_components_(num_components), size_(0), epsilon_(epsilon), inv_cell_size_(epsilon > 0.0f ? 1.0f / (CELL_SIZE * epsilon) : 1.0f)
+{
+    Entry empty;
+    empty.index_ = INVALID_INDEX;
+    entries_.assign(getCapacity(expected), empty);
+}
+
+
+
+/**
+* @brief Index of a value equal to 'value' within the tolerance, inserting it with 'new_index' if there is none
+*
+* @param value     Components of the value
+* @param new_index Index to give the value if it is new
+*
+* @return Index of the value (new_index if it was inserted)
+*/
+JU::uint32 VertexWelder::AttributeTable::findOrInsert(const JU::f32* value, JU::uint32 new_index)
+{
+    Entry entry;
+    entry.index_ = new_index;
+
+    JU::int64 cell[3];
+    JU::int64 neighbour[3] = { 0, 0, 0 };   // Neighbouring cell a value within the tolerance could fall in (or 0)
+    JU::f32   margin = epsilon_ * inv_cell_size_;
+
+    for (JU::uint32 component = 0; component < 3; ++component)
+    {
+        entry.value_[component] = (component < num_components_) ? value[component] : 0.0f;
+
+        JU::f32 scaled = entry.value_[component] * inv_cell_size_;
+        JU::f32 floor  = std::floor(scaled);
+
+        cell[component] = static_cast<JU::int64>(floor);
+
+        if (scaled - floor <= margin)
+            neighbour[component] = -1;
+        else if (floor + 1.0f - scaled <= margin)
+            neighbour[component] = 1;
+    }
+
+    JU::uint32 index = find(cell, entry.value_);
+
+    // Most duplicates are bit-identical, so the neighbours are only probed after a miss in the home cell
+    for (JU::uint32 mask = 1; index == INVALID_INDEX && mask < 8; ++mask)
+    {
+        JU::int64 neighbour_cell[3];
+        bool valid = true;
+
+        for (JU::uint32 component = 0; component < 3; ++component)
+        {
+            bool moved = (mask >> component) & 1;
+
+            valid = valid && !(moved && neighbour[component] == 0);
+            neighbour_cell[component] = cell[component] + (moved ? neighbour[component] : 0);
+        }
+
+        if (valid)
+            index = find(neighbour_cell, entry.value_);
+    }
+
+    if (index != INVALID_INDEX)
+        return index;
+
+    if (2 * (size_ + 1) > entries_.size())
+    {
+        std::vector<Entry> old_entries;
+        old_entries.swap(entries_);
+
+        Entry empty;
+        empty.index_ = INVALID_INDEX;
+        entries_.assign(old_entries.size() * 2, empty);
+
+        for (JU::uint32 slot = 0; slot < old_entries.size(); ++slot)
+        {
+            if (old_entries[slot].index_ != INVALID_INDEX)
+            {
+                JU::int64 old_cell[3];
+                getCell(old_entries[slot].value_, old_cell);
+                insert(old_cell, old_entries[slot]);
+            }
+        }
+    }
+
+    insert(cell, entry);
+    ++size_;
+
+    return new_index;
+}
+
+
+
+void VertexWelder::AttributeTable::getCell(const JU::f32* value, JU::int64* cell) const
+{
+    for (JU::uint32 component = 0; component < 3; ++component)
+        cell[component] = static_cast<JU::int64>(std::floor(value[component] * inv_cell_size_));
+}
+
+
+
+/**
+* @brief Index of a value of the cell equal to 'value' within the tolerance (INVALID_INDEX if there is none)
+*
+* @detail Entries of other cells that share the probe sequence are compared too: any match within the tolerance will do.
+*/
+JU::uint32 VertexWelder::AttributeTable::find(const JU::int64* cell, const JU::f32* value) const
+{
+    JU::uint32 mask = entries_.size() - 1;
+
+    for (JU::uint32 slot = hash(cell) & mask; entries_[slot].index_ != INVALID_INDEX; slot = (slot + 1) & mask)
+    {
+        const Entry& entry = entries_[slot];
+
+        if (std::fabs(entry.value_[0] - value[0]) <= epsilon_ &&
+            std::fabs(entry.value_[1] - value[1]) <= epsilon_ &&
+            std::fabs(entry.value_[2] - value[2]) <= epsilon_)
+            return entry.index_;
+    }
+
+    return INVALID_INDEX;
+}
+
+
+
+void VertexWelder::AttributeTable::insert(const JU::int64* cell, const Entry& entry)
+{
+    JU::uint32 mask = entries_.size() - 1;
+    JU::uint32 slot = hash(cell) & mask;
+
+    while (entries_[slot].index_ != INVALID_INDEX)
+        slot = (slot + 1) & mask;
+
+    entries_[slot] = entry;
+}
+
+
+
+JU::uint32 VertexWelder::AttributeTable::hash(const JU::int64* cell)
+{
+    return mix(static_cast<JU::uint64>(cell[0]) * 73856093ULL ^
+               static_cast<JU::uint64>(cell[1]) * 19349663ULL ^
+               static_cast<JU::uint64>(cell[2]) * 83492791ULL);
+}
+
+
+
+VertexWelder::IndexTable::IndexTable(JU::uint32 expected) : size_(0)
+{
+    Entry empty;
+    empty.index_ = INVALID_INDEX;
+    entries_.assign(getCapacity(expected), empty);
+}
+
+
+
+/**
+* @brief Index of the triple 'key', inserting it with 'new_index' if it is not in the table
+*
+* @return Index of the triple (new_index if it was inserted)
+*/
+JU::uint32 VertexWelder::IndexTable::findOrInsert(const VertexIndices& key, JU::uint32 new_index)
+{
+    JU::uint32 mask = entries_.size() - 1;
+
+    for (JU::uint32 slot = hash(key) & mask; entries_[slot].index_ != INVALID_INDEX; slot = (slot + 1) & mask)
+        if (entries_[slot].key_ == key)
+            return entries_[slot].index_;
+
+    if (2 * (size_ + 1) > entries_.size())
+    {
+        std::vector<Entry> old_entries;
+        old_entries.swap(entries_);
+
+        Entry empty;
+        empty.index_ = INVALID_INDEX;
+        entries_.assign(old_entries.size() * 2, empty);
+
+        for (JU::uint32 slot = 0; slot < old_entries.size(); ++slot)
+            if (old_entries[slot].index_ != INVALID_INDEX)
+                insert(old_entries[slot]);
+    }
+
+    Entry entry;
+    entry.key_   = key;
+    entry.index_ = new_index;
+    insert(entry);
+    ++size_;
+
+    return new_index;
+}
+
+
+
+void VertexWelder::IndexTable::insert(const Entry& entry)
+{
+    JU::uint32 mask = entries_.size() - 1;
+    JU::uint32 slot = hash(entry.key_) & mask;
+
+    while (entries_[slot].index_ != INVALID_INDEX)
+        slot = (slot + 1) & mask;
+
+    entries_[slot] = entry;
+}
+
+
+
+JU::uint32 VertexWelder::IndexTable::hash(const VertexIndices& key)
+{
+    return mix((static_cast<JU::uint64>(key.position_) << 42) ^ (static_cast<JU::uint64>(key.normal_) << 21) ^ key.tex_);
+}
+
+} /* namespace JU */
@@ -0,0 +1,126 @@
+/*
+ * VertexWelder.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: jusabiaga
+ */
+
+#ifndef VERTEXWELDER_HPP_
+#define VERTEXWELDER_HPP_
+
+// Local includes
+#include "../core/Defs.hpp"     // uint32, int64, f32
+#include "GraphicsDefs.hpp"     // VectorPositions, VectorNormals, VectorTexCoords, VectorVertexIndices
+// Global includes
+#include <glm/glm.hpp>          // glm::vec3, glm::vec2
+#include <vector>               // std::vector
+
+namespace JU
+{
+
+/**
+ * @brief Merges vertices (and their positions, normals and texture coordinates) that are equal within a tolerance
+ *
+ * @details Each attribute is looked up in an open-addressing hash table (linear probing, power-of-two size) keyed on
+ *          its components quantized to cells much larger than the tolerance. A value within the tolerance of another
+ *          is in the same cell unless one of them is that close to a cell boundary, so a lookup probes the home cell
+ *          first and, only if nothing matches there, the neighbouring cells across the boundaries the value is close
+ *          to. The (position, normal, texture coordinates) triples of the vertices are then welded exactly in a fourth
+ *          table.
+ *
+ *          Generators emit each vertex again for every triangle around it, bit for bit, usually a few triangles apart.
+ *          A small direct-mapped cache of the last vertices (it fits in L2) answers those repeats without touching the
+ *          tables, which do not fit in cache for large meshes.
+ */
+class VertexWelder
+{
+    public:
+        static const JU::f32 DEFAULT_EPSILON;
+
+    public:
+        VertexWelder(JU::f32 epsilon = DEFAULT_EPSILON, JU::uint32 expected_vertices = 0);
+
+        VertexIndex addVertex(const glm::vec3&     position,
+                              const glm::vec3&     normal,
+                              const glm::vec2&     tex_coords,
+                              VectorPositions&     vPositions,
+                              VectorNormals&       vNormals,
+                              VectorTexCoords&     vTexCoords,
+                              VectorVertexIndices& vVertexIndices);
+
+    private:
+        static const JU::uint32 RECENT_SIZE = 4096;   //!< Entries of the cache of recent vertices (power of two)
+
+        /**
+         * @brief Vertex recently added (bit-exact copy of its attributes) and the index it was given
+         */
+        struct RecentVertex
+        {
+            JU::uint32  bits_[8];
+            VertexIndex index_;     //!< INVALID_INDEX if the slot is empty
+        };
+
+        /**
+         * @brief Hash table of vectors of up to 3 components, equal within the tolerance
+         */
+        class AttributeTable
+        {
+            public:
+                AttributeTable(JU::uint32 num_components, JU::f32 epsilon, JU::uint32 expected);
+
+                JU::uint32 findOrInsert(const JU::f32* value, JU::uint32 new_index);
+
+            private:
+                // 16 bytes: the cell of an entry is recomputed from its value when the table grows
+                struct Entry
+                {
+                    JU::f32    value_[3];
+                    JU::uint32 index_;      //!< INVALID_INDEX if the slot is empty
+                };
+
+                void getCell(const JU::f32* value, JU::int64* cell) const;
+                JU::uint32 find(const JU::int64* cell, const JU::f32* value) const;
+                void insert(const JU::int64* cell, const Entry& entry);
+                static JU::uint32 hash(const JU::int64* cell);
+
+                std::vector<Entry> entries_;
+                JU::uint32 num_components_;
+                JU::uint32 size_;
+                JU::f32    epsilon_;
+                JU::f32    inv_cell_size_;
+        };
+
+        /**
+         * @brief Hash table of (position, normal, texture coordinates) triples, exactly equal
+         */
+        class IndexTable
+        {
+            public:
+                IndexTable(JU::uint32 expected);
+
+                JU::uint32 findOrInsert(const VertexIndices& key, JU::uint32 new_index);
+
+            private:
+                struct Entry
+                {
+                    VertexIndices key_;
+                    JU::uint32    index_;   //!< INVALID_INDEX if the slot is empty
+                };
+
+                void insert(const Entry& entry);
+                static JU::uint32 hash(const VertexIndices& key);
+
+                std::vector<Entry> entries_;
+                JU::uint32 size_;
+        };
+
+        AttributeTable              positions_;
+        AttributeTable              normals_;
+        AttributeTable              tex_coords_;
+        IndexTable                  vertices_;
+        std::vector<RecentVertex>   recent_;
+};
+
+} /* namespace JU */
+
+#endif /* VERTEXWELDER_HPP_ */
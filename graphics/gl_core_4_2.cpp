@@ -100,7 +100,25 @@ namespace gl
 {
 	namespace exts
 	{
+		LoadTest var_ARB_multi_draw_indirect;
+		
 	} //namespace exts
+	// Extension: ARB_multi_draw_indirect
+	typedef void (CODEGEN_FUNCPTR *PFNMULTIDRAWARRAYSINDIRECT)(GLenum, const void *, GLsizei, GLsizei);
+	PFNMULTIDRAWARRAYSINDIRECT MultiDrawArraysIndirect = 0;
+	typedef void (CODEGEN_FUNCPTR *PFNMULTIDRAWELEMENTSINDIRECT)(GLenum, GLenum, const void *, GLsizei, GLsizei);
+	PFNMULTIDRAWELEMENTSINDIRECT MultiDrawElementsIndirect = 0;
+	
+	static int Load_ARB_multi_draw_indirect()
+	{
+		int numFailed = 0;
+		MultiDrawArraysIndirect = reinterpret_cast<PFNMULTIDRAWARRAYSINDIRECT>(IntGetProcAddress("glMultiDrawArraysIndirect"));
+		if(!MultiDrawArraysIndirect) ++numFailed;
+		MultiDrawElementsIndirect = reinterpret_cast<PFNMULTIDRAWELEMENTSINDIRECT>(IntGetProcAddress("glMultiDrawElementsIndirect"));
+		if(!MultiDrawElementsIndirect) ++numFailed;
+		return numFailed;
+	}
+	
 	typedef void (CODEGEN_FUNCPTR *PFNBLENDFUNC)(GLenum, GLenum);
 	PFNBLENDFUNC BlendFunc = 0;
 	typedef void (CODEGEN_FUNCPTR *PFNCLEAR)(GLbitfield);
@@ -2115,11 +2133,13 @@ namespace gl
 			
 			void InitializeMappingTable(std::vector<MapEntry> &table)
 			{
-				table.reserve(0);
+				table.reserve(1);
+				table.push_back(MapEntry("GL_ARB_multi_draw_indirect", &exts::var_ARB_multi_draw_indirect, Load_ARB_multi_draw_indirect));
 			}
 			
 			void ClearExtensionVars()
 			{
+				exts::var_ARB_multi_draw_indirect = exts::LoadTest();
 			}
 			
 			void LoadExtByName(std::vector<MapEntry> &table, const char *extensionName)
@@ -174,6 +174,8 @@ namespace gl
 			int m_numMissing;
 		};
 		
+		extern LoadTest var_ARB_multi_draw_indirect;
+		
 	} //namespace exts
 	enum
 	{
@@ -1208,6 +1210,11 @@ namespace gl
 		VERTEX_ATTRIB_ARRAY_BARRIER_BIT  = 0x00000001,
 		
 	};
+	
+	// Extension: ARB_multi_draw_indirect
+	extern void (CODEGEN_FUNCPTR *MultiDrawArraysIndirect)(GLenum mode, const void * indirect, GLsizei drawcount, GLsizei stride);
+	extern void (CODEGEN_FUNCPTR *MultiDrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride);
+	
 	extern void (CODEGEN_FUNCPTR *BlendFunc)(GLenum sfactor, GLenum dfactor);
 	extern void (CODEGEN_FUNCPTR *Clear)(GLbitfield mask);
 	extern void (CODEGEN_FUNCPTR *ClearColor)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);